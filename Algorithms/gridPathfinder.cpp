@@ -0,0 +1,219 @@
+/* DESCRIPTION OF PROGRAM
+
+    Test driver and benchmarks for GridPathfinder and PathfinderPool (see gridPathfinder.h).
+
+    The benchmarks build maps at the sizes of the Moving AI grid benchmark sets (256, 512 and 1024 cells square) of
+    two kinds: scattered obstacles covering a fifth of the map, and rooms joined by doors. Each map is searched with
+    every algorithm on the same random pairs of open cells, and the queries per second are printed for one thread
+    and for a batch across a PathfinderPool. A map in the Moving AI format can be benchmarked instead with --map.
+
+    Usage: gridPathfinder --benchmark [--queries n] [--threads n] [--map path]
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#include "gridPathfinder.h"
+
+//BENCHMARKS
+
+//Builds a map with about the given fraction of its cells blocked at random
+GridMap makeScatteredMap(int size, float blockedFraction, unsigned int seed) {
+    GridMap map(size, size);
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> chance(0, 1);
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            map.setOpen(x, y, chance(random) >= blockedFraction);
+        }
+    }
+
+    return map;
+}
+
+/* Function: makeRoomMap
+ * Description: Builds a map of square rooms of the given width split by walls one cell thick, with a door two cells
+ *              wide at a random place in each wall between neighbouring rooms.
+ *
+ * Param: int size, int roomSize, unsigned int seed
+*/
+GridMap makeRoomMap(int size, int roomSize, unsigned int seed) {
+    GridMap map(size, size);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> doorPlace(0, roomSize - 3);
+
+    for (int wall = roomSize; wall < size; wall += roomSize + 1) {
+        for (int i = 0; i < size; i++) {
+            map.setOpen(wall, i, false);
+            map.setOpen(i, wall, false);
+        }
+    }
+
+    for (int wall = roomSize; wall < size; wall += roomSize + 1) {
+        for (int roomStart = 0; roomStart < size; roomStart += roomSize + 1) {
+            int door = roomStart + doorPlace(random);
+
+            for (int i = door; i < std::min(door + 2, size); i++) {
+                map.setOpen(wall, i, true);
+                map.setOpen(i, wall, true);
+            }
+        }
+    }
+
+    return map;
+}
+
+//Returns numQueries queries between random open cells of the map
+std::vector<PathQuery> makeQueries(const GridMap& map, int numQueries, unsigned int seed) {
+    std::vector<PathQuery> queries;
+    std::vector<int> openCells;
+    std::mt19937 random(seed);
+
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.isOpen(x, y)) {
+                openCells.push_back(map.cellAt(x, y));
+            }
+        }
+    }
+
+    std::uniform_int_distribution<int> pick(0, openCells.size() - 1);
+
+    for (int i = 0; i < numQueries; i++) {
+        int start = openCells[pick(random)];
+        int goal = openCells[pick(random)];
+        queries.push_back(PathQuery{map.xOf(start), map.yOf(start), map.xOf(goal), map.yOf(goal)});
+    }
+
+    return queries;
+}
+
+/* Function: benchmarkMap
+ * Description: Runs the queries on the map with every algorithm, first on one GridPathfinder and then as a batch
+ *              across numThreads, and prints the queries per second of each, the cells expanded per query, and
+ *              the number of queries with no path.
+ *
+ * Param: const string& name, const GridMap& map, const std::vector<PathQuery>& queries, int numThreads
+*/
+void benchmarkMap(const string& name, const GridMap& map, const std::vector<PathQuery>& queries, int numThreads) {
+    GridPathfinder pathfinder(map);
+    PathfinderPool pool(map, numThreads);
+    std::vector<float> pathCosts;
+
+    cout << name << " (" << map.getWidth() << "x" << map.getHeight() << ", " << queries.size() << " queries)" << endl;
+
+    for (int i = 0; i < NUM_PATH_ALGORITHMS; i++) {
+        PathAlgorithm algorithm = (PathAlgorithm) i;
+        long long numExpanded = 0;
+        int numUnreachable = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (const PathQuery& query : queries) {
+            numUnreachable += pathfinder.findPath(algorithm, query.startX, query.startY, query.goalX, query.goalY) < 0;
+            numExpanded += pathfinder.expanded();
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        pool.findPaths(algorithm, queries, pathCosts);
+        double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        cout << "    " << left << setw(10) << PATH_ALGORITHM_NAMES[i] << right
+             << setw(10) << (long long) (queries.size() / seconds) << " queries/s"
+             << setw(12) << (long long) (queries.size() / batchSeconds) << " queries/s on " << pool.size() << " threads"
+             << setw(10) << numExpanded / (long long) queries.size() << " expanded/query"
+             << setw(6) << numUnreachable << " unreachable" << endl;
+    }
+}
+
+//Benchmarks every algorithm on scattered and room maps of each standard size
+void benchmarkPathfinding(int numQueries, int numThreads) {
+    const int sizes[3] = {256, 512, 1024};
+
+    for (int size : sizes) {
+        GridMap scattered = makeScatteredMap(size, 0.2f, size);
+        GridMap rooms = makeRoomMap(size, 16, size);
+
+        benchmarkMap("Scattered", scattered, makeQueries(scattered, numQueries, size), numThreads);
+        benchmarkMap("Rooms", rooms, makeQueries(rooms, numQueries, size), numThreads);
+    }
+}
+
+//Driver for testing
+int main(int argc, char** argv) {
+    int numQueries = 1000;
+    int numThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    const char* mapPath = NULL;
+    bool benchmark = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--benchmark") == 0) {
+            benchmark = true;
+        }
+
+        else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            numQueries = std::max(1, atoi(argv[++i]));
+        }
+
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numThreads = std::max(1, atoi(argv[++i]));
+        }
+
+        else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            mapPath = argv[++i];
+        }
+
+        else {
+            benchmark = false;
+            break;
+        }
+    }
+
+    //Benchmarks, on the standard map sizes or on a Moving AI benchmark map (https://movingai.com/benchmarks/grids.html)
+
+    if (benchmark && mapPath != NULL) {
+        GridMap map;
+
+        if (!map.load(mapPath)) {
+            cout << "Error: Could not read a map from " << mapPath << endl;
+            return 1;
+        }
+
+        benchmarkMap(mapPath, map, makeQueries(map, numQueries, 1), numThreads);
+        return 0;
+    }
+
+    else if (benchmark) {
+        benchmarkPathfinding(numQueries, numThreads);
+        return 0;
+    }
+
+    else if (argc > 1) {
+        cout << "Usage: " << argv[0] << " --benchmark [--queries n] [--threads n] [--map path]" << endl;
+        return 1;
+    }
+
+    // GridMap* testMap = new GridMap(8, 5);
+    // for (int y = 0; y < 4; y++) {
+    //     testMap->setOpen(4, y, false);
+    // }
+    // GridPathfinder* testPathfinder = new GridPathfinder(*testMap);
+    // std::vector<Vector2> testPath;
+    // cout << testPathfinder->findPath(A_STAR, 0, 0, 7, 0, &testPath) << endl;
+    // for (Vector2 step : testPath) {
+    //     cout << "(" << step.xCoord << ", " << step.yCoord << ") ";
+    // }
+    // cout << endl;
+    // cout << testPathfinder->findPath(JUMP_POINT, 0, 0, 7, 0, &testPath) << " " << testPathfinder->expanded() << endl;
+    // cout << testPathfinder->findPath(DIJKSTRA, 0, 0, 7, 0) << " " << testPathfinder->expanded() << endl;
+    // delete testPathfinder;
+    // delete testMap;
+    return 0;
+}
@@ -0,0 +1,606 @@
+/* DESCRIPTION OF FILE
+
+    This file implements shortest path search on 2D grid maps with Dijkstra's algorithm, A* and jump point search
+    (JPS), for answering many queries on the same map.
+
+    Maps are 8-connected: a move to an orthogonal neighbour costs 1 and a diagonal move costs sqrt(2), and a diagonal
+    move is only allowed when both orthogonal cells beside it are open, so paths never cut corners. A* is guided by
+    the straight-line distance to the goal (Vector2::getDistance). JPS is A* that skips over runs of cells where the
+    path has no choice of direction and only expands the jump points where one appears, following the design
+    described here: https://harablog.wordpress.com/2011/09/07/jump-point-search/
+    All three find paths of the same cost.
+
+    A GridPathfinder keeps its open set (a PriorityQ on a NodeArena) and the cost, parent and state of every cell in
+    flat arrays sized to the map, and reuses them for every query. Cells are stamped with the query's number instead
+    of being cleared, so once the open set has grown to its largest size a query allocates nothing. A PathfinderPool
+    holds one GridPathfinder per thread and answers a batch of queries across them.
+
+    PriorityQ orders by int priority, so path estimates are ordered in steps of 1/1024 of a cell. Paths found can be
+    longer than the shortest by at most that much per step, and map paths must be shorter than 2 million cells.
+*/
+
+#ifndef GRID_PATHFINDER_H
+#define GRID_PATHFINDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../DataStructures/Lists/priorityQueue.h"
+#include "../LinearAlg/vector.h"
+
+using namespace std;
+
+//Search algorithms a GridPathfinder can run
+enum PathAlgorithm { DIJKSTRA, A_STAR, JUMP_POINT, NUM_PATH_ALGORITHMS };
+
+const char* const PATH_ALGORITHM_NAMES[NUM_PATH_ALGORITHMS] = {"Dijkstra", "A*", "JPS"};
+
+const float DIAGONAL_COST = 1.41421356f;
+
+//GRID MAP
+
+//Grid of open and blocked cells. Cells are stored row by row inside a border of blocked cells, so that a search
+//can step to any neighbour of an open cell without checking the map's bounds.
+class GridMap {
+
+    private:
+        int width;
+        int height;
+        std::vector<uint8_t> cells;
+
+    public:
+        //Returns the index of the cell at the coordinates, which may lie on the border
+        int cellAt(int x, int y) const {
+            return (y + 1) * (width + 2) + x + 1;
+        }
+
+        int getHeight() const {
+            return height;
+        }
+
+        //Returns the distance between the indexes of vertically adjacent cells
+        int getStride() const {
+            return width + 2;
+        }
+
+        int getWidth() const {
+            return width;
+        }
+
+        //Returns whether the coordinates are on the map and open
+        bool isOpen(int x, int y) const {
+            return x >= 0 && x < width && y >= 0 && y < height && cells[cellAt(x, y)];
+        }
+
+        //Returns whether the cell at the index is open, the index must be on the map or its border
+        bool isOpenCell(int cell) const {
+            return cells[cell];
+        }
+
+        bool load(const char* path);
+        void setOpen(int x, int y, bool open);
+
+        int xOf(int cell) const {
+            return cell % (width + 2) - 1;
+        }
+
+        int yOf(int cell) const {
+            return cell / (width + 2) - 1;
+        }
+
+        //Builds a map of the given size with every cell open
+        GridMap(int width=0, int height=0) {
+            this->width = width;
+            this->height = height;
+            cells.assign((width + 2) * (height + 2), 0);
+
+            for (int y = 0; y < height; y++) {
+                std::fill(cells.begin() + cellAt(0, y), cells.begin() + cellAt(width, y), 1);
+            }
+        }
+};
+
+/* Function: load
+ * Description: Replaces the map with one read from a file in the Moving AI benchmark format (a "type octile" line,
+ *              "height" and "width" lines, a "map" line, then one line of cells per row). Cells marked '.', 'G' or
+ *              'S' are open and all others are blocked. Returns false if the file cannot be read.
+ *
+ * Param: const char* path
+*/
+inline bool GridMap::load(const char* path) {
+    std::ifstream in(path);
+    string word;
+    int newWidth = -1;
+    int newHeight = -1;
+
+    while (in >> word && word != "map") {
+        if (word == "height") {
+            in >> newHeight;
+        }
+
+        else if (word == "width") {
+            in >> newWidth;
+        }
+    }
+
+    if (!in || newWidth < 0 || newHeight < 0) {
+        return false;
+    }
+
+    *this = GridMap(newWidth, newHeight);
+
+    for (int y = 0; y < height; y++) {
+        string row;
+
+        if (!(in >> row) || (int) row.size() < width) {
+            return false;
+        }
+
+        for (int x = 0; x < width; x++) {
+            setOpen(x, y, row[x] == '.' || row[x] == 'G' || row[x] == 'S');
+        }
+    }
+
+    return true;
+}
+
+//Opens or blocks the cell at the coordinates, which must be on the map
+inline void GridMap::setOpen(int x, int y, bool open) {
+    cells[cellAt(x, y)] = open;
+}
+
+//PATHFINDER
+
+//Entry in the open set: a cell and the cost it was reached with. Entries left behind when a cheaper path to their
+//cell is found are skipped when they are removed.
+struct OpenCell {
+    int cell;
+    float cost;
+};
+
+//Start and goal coordinates of one query
+struct PathQuery {
+    int startX;
+    int startY;
+    int goalX;
+    int goalY;
+};
+
+//Searches one GridMap, reusing its arrays and open set for every query. Not safe to share between threads.
+class GridPathfinder {
+
+    private:
+        //Path estimates are multiplied by this and rounded to give PriorityQ's int priorities
+        static const int COST_SCALE = 1024;
+
+        const GridMap& map;
+        int stride;
+        std::vector<float> costs;
+        std::vector<int> parents;
+
+        //Twice the number of the last query to reach each cell, plus 1 once the cell has been expanded
+        std::vector<uint32_t> states;
+        uint32_t queryNumber;
+        PriorityQ<OpenCell, NodeArena> openSet;
+        PathAlgorithm algorithm;
+        int goalCell;
+        Vector2 goal;
+        int numExpanded;
+
+        void addJumpPoints(int cell);
+        void addNeighbours(int cell);
+        float heuristic(int cell);
+        int jump(int cell, int dx, int dy);
+        void jumpFrom(int cell, int dx, int dy);
+        int jumpStraight(int cell, int step, int side);
+        float octileDistance(int fromCell, int toCell);
+        void relax(int cell, int parent, float cost);
+
+    public:
+        int expanded();
+        float findPath(PathAlgorithm algorithm, int startX, int startY, int goalX, int goalY, std::vector<Vector2>* path=NULL);
+
+        GridPathfinder(const GridMap& map);
+        GridPathfinder(const GridPathfinder&) = delete;
+        GridPathfinder& operator=(const GridPathfinder&) = delete;
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: addJumpPoints
+ * Description: Adds the jump points reachable from the cell to the open set. The directions searched are pruned
+ *              by the direction the cell was reached from: moving straight, only the cells ahead and to either side
+ *              can start a shorter path than one through the parent, and moving diagonally, only the cell ahead and
+ *              the two straight moves it is made of. The start cell searches all eight directions.
+ *
+ * Param: int cell
+*/
+inline void GridPathfinder::addJumpPoints(int cell) {
+    int parent = parents[cell];
+
+    if (parent < 0) {
+        addNeighbours(cell);
+        return;
+    }
+
+    int dx = (map.xOf(cell) > map.xOf(parent)) - (map.xOf(cell) < map.xOf(parent));
+    int dy = (map.yOf(cell) > map.yOf(parent)) - (map.yOf(cell) < map.yOf(parent));
+
+    if (dx != 0 && dy != 0) {
+        bool verticalOpen = map.isOpenCell(cell + dy * stride);
+        bool horizontalOpen = map.isOpenCell(cell + dx);
+
+        if (verticalOpen) {
+            jumpFrom(cell, 0, dy);
+        }
+
+        if (horizontalOpen) {
+            jumpFrom(cell, dx, 0);
+        }
+
+        if (verticalOpen && horizontalOpen) {
+            jumpFrom(cell, dx, dy);
+        }
+    }
+
+    else if (dx != 0) {
+        bool nextOpen = map.isOpenCell(cell + dx);
+        bool upOpen = map.isOpenCell(cell - stride);
+        bool downOpen = map.isOpenCell(cell + stride);
+
+        if (nextOpen) {
+            jumpFrom(cell, dx, 0);
+
+            if (upOpen) {
+                jumpFrom(cell, dx, -1);
+            }
+
+            if (downOpen) {
+                jumpFrom(cell, dx, 1);
+            }
+        }
+
+        if (upOpen) {
+            jumpFrom(cell, 0, -1);
+        }
+
+        if (downOpen) {
+            jumpFrom(cell, 0, 1);
+        }
+    }
+
+    else {
+        bool nextOpen = map.isOpenCell(cell + dy * stride);
+        bool leftOpen = map.isOpenCell(cell - 1);
+        bool rightOpen = map.isOpenCell(cell + 1);
+
+        if (nextOpen) {
+            jumpFrom(cell, 0, dy);
+
+            if (leftOpen) {
+                jumpFrom(cell, -1, dy);
+            }
+
+            if (rightOpen) {
+                jumpFrom(cell, 1, dy);
+            }
+        }
+
+        if (leftOpen) {
+            jumpFrom(cell, -1, 0);
+        }
+
+        if (rightOpen) {
+            jumpFrom(cell, 1, 0);
+        }
+    }
+}
+
+/* Function: addNeighbours
+ * Description: Adds every open neighbour of the cell to the open set, diagonal neighbours only when both cells
+ *              beside the diagonal move are open. Searches from the start of a JPS query the same way, jumping
+ *              from each neighbour instead of adding it.
+ *
+ * Param: int cell
+*/
+inline void GridPathfinder::addNeighbours(int cell) {
+    const int directions[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    float cost = costs[cell];
+
+    for (int i = 0; i < 8; i++) {
+        int dx = directions[i][0];
+        int dy = directions[i][1];
+        int neighbour = cell + dx + dy * stride;
+
+        if (!map.isOpenCell(neighbour)) {
+            continue;
+        }
+
+        if (dx != 0 && dy != 0 && (!map.isOpenCell(cell + dx) || !map.isOpenCell(cell + dy * stride))) {
+            continue;
+        }
+
+        if (algorithm == JUMP_POINT) {
+            jumpFrom(cell, dx, dy);
+        }
+
+        else {
+            relax(neighbour, cell, cost + (dx != 0 && dy != 0 ? DIAGONAL_COST : 1));
+        }
+    }
+}
+
+//Returns the straight-line distance from the cell to the goal, or 0 for Dijkstra's algorithm
+inline float GridPathfinder::heuristic(int cell) {
+
+    if (algorithm == DIJKSTRA) {
+        return 0;
+    }
+
+    return Vector2(map.xOf(cell), map.yOf(cell)).getDistance(goal);
+}
+
+/* Function: jump
+ * Description: Walks from the cell in the direction (dx, dy) and returns the first jump point: the goal, a cell
+ *              with a forced neighbour, or (moving diagonally) a cell from which a straight walk finds a jump point.
+ *              Returns -1 if the walk is blocked first.
+ *
+ * Param: int cell, int dx, int dy
+*/
+inline int GridPathfinder::jump(int cell, int dx, int dy) {
+
+    if (dx == 0 || dy == 0) {
+        return jumpStraight(cell, dx + dy * stride, dx != 0 ? stride : 1);
+    }
+
+    while (map.isOpenCell(cell)) {
+        if (cell == goalCell) {
+            return cell;
+        }
+
+        if (jumpStraight(cell + dx, dx, stride) >= 0 || jumpStraight(cell + dy * stride, dy * stride, 1) >= 0) {
+            return cell;
+        }
+
+        //The next diagonal step would cut a corner
+        if (!map.isOpenCell(cell + dx) || !map.isOpenCell(cell + dy * stride)) {
+            return -1;
+        }
+
+        cell += dx + dy * stride;
+    }
+
+    return -1;
+}
+
+//Adds the jump point found walking from the cell in the direction (dx, dy), if any, to the open set
+inline void GridPathfinder::jumpFrom(int cell, int dx, int dy) {
+    int jumpPoint = jump(cell + dx + dy * stride, dx, dy);
+
+    if (jumpPoint >= 0) {
+        relax(jumpPoint, cell, costs[cell] + octileDistance(cell, jumpPoint));
+    }
+}
+
+/* Function: jumpStraight
+ * Description: Walks from the cell by step (1 or the stride, either sign) and returns the first cell that is the
+ *              goal or has a forced neighbour: an open cell to one side (side and -side) whose cell behind is
+ *              blocked, so the shortest path to it may turn here. Returns -1 if the walk is blocked first.
+ *
+ * Param: int cell, int step, int side
+*/
+inline int GridPathfinder::jumpStraight(int cell, int step, int side) {
+
+    while (map.isOpenCell(cell)) {
+        if (cell == goalCell) {
+            return cell;
+        }
+
+        if ((map.isOpenCell(cell + side) && !map.isOpenCell(cell - step + side)) ||
+            (map.isOpenCell(cell - side) && !map.isOpenCell(cell - step - side))) {
+            return cell;
+        }
+
+        cell += step;
+    }
+
+    return -1;
+}
+
+//Returns the cost of the shortest unobstructed path between two cells, as diagonal moves then straight moves
+inline float GridPathfinder::octileDistance(int fromCell, int toCell) {
+    int dx = abs(map.xOf(fromCell) - map.xOf(toCell));
+    int dy = abs(map.yOf(fromCell) - map.yOf(toCell));
+
+    return std::max(dx, dy) + (DIAGONAL_COST - 1) * std::min(dx, dy);
+}
+
+/* Function: relax
+ * Description: Records the cost and parent of the cell and adds it to the open set, unless it has already been
+ *              expanded or reached at no greater cost during this query.
+ *
+ * Param: int cell, int parent, float cost
+*/
+inline void GridPathfinder::relax(int cell, int parent, float cost) {
+    uint32_t reachedState = queryNumber * 2;
+
+    if (states[cell] == reachedState + 1 || (states[cell] == reachedState && costs[cell] <= cost)) {
+        return;
+    }
+
+    states[cell] = reachedState;
+    costs[cell] = cost;
+    parents[cell] = parent;
+
+    float estimate = cost + heuristic(cell);
+    openSet.insert(-(int) (estimate * COST_SCALE + 0.5f), OpenCell{cell, cost});
+}
+
+//PUBLIC FUNCTIONS
+
+//Returns the number of cells the last query expanded
+inline int GridPathfinder::expanded() {
+    return numExpanded;
+}
+
+/* Function: findPath
+ * Description: Returns the cost of the shortest path from the start to the goal, or -1 if either is blocked or no
+ *              path exists. If path is given, it is set to the cells the path turns at (every cell for Dijkstra and
+ *              A*, the jump points for JPS), from the start to the goal.
+ *
+ * Param: PathAlgorithm algorithm, int startX, int startY, int goalX, int goalY, std::vector<Vector2>* path
+*/
+inline float GridPathfinder::findPath(PathAlgorithm algorithm, int startX, int startY, int goalX, int goalY, std::vector<Vector2>* path) {
+
+    if (path != NULL) {
+        path->clear();
+    }
+
+    numExpanded = 0;
+
+    if (!map.isOpen(startX, startY) || !map.isOpen(goalX, goalY)) {
+        return -1;
+    }
+
+    //Query numbers are stamped as twice their value, so the stamps are cleared before they would overflow
+    if (++queryNumber >= 0x7FFFFFFF) {
+        std::fill(states.begin(), states.end(), 0);
+        queryNumber = 1;
+    }
+
+    this->algorithm = algorithm;
+    goalCell = map.cellAt(goalX, goalY);
+    goal = Vector2(goalX, goalY);
+    openSet.clear();
+
+    uint32_t reachedState = queryNumber * 2;
+    relax(map.cellAt(startX, startY), -1, 0);
+
+    while (openSet.size() > 0) {
+        OpenCell next = openSet.deleteMax();
+
+        //Already expanded, or reached more cheaply since this entry was added
+        if (states[next.cell] != reachedState || next.cost > costs[next.cell]) {
+            continue;
+        }
+
+        states[next.cell] = reachedState + 1;
+
+        if (next.cell == goalCell) {
+            if (path != NULL) {
+                for (int cell = goalCell; cell >= 0; cell = parents[cell]) {
+                    path->push_back(Vector2(map.xOf(cell), map.yOf(cell)));
+                }
+
+                std::reverse(path->begin(), path->end());
+            }
+
+            return next.cost;
+        }
+
+        numExpanded++;
+
+        if (algorithm == JUMP_POINT) {
+            addJumpPoints(next.cell);
+        }
+
+        else {
+            addNeighbours(next.cell);
+        }
+    }
+
+    return -1;
+}
+
+inline GridPathfinder::GridPathfinder(const GridMap& map) : map(map), goal(0, 0) {
+    int numCells = (map.getWidth() + 2) * (map.getHeight() + 2);
+
+    stride = map.getStride();
+    costs.assign(numCells, 0);
+    parents.assign(numCells, -1);
+    states.assign(numCells, 0);
+    queryNumber = 0;
+    algorithm = A_STAR;
+    goalCell = -1;
+    numExpanded = 0;
+}
+
+//PATHFINDER POOL
+
+//One GridPathfinder per thread, for answering batches of queries on one map in parallel
+class PathfinderPool {
+
+    private:
+        //Queries a thread takes from the batch at a time
+        static const int QUERY_CHUNK = 16;
+
+        std::vector<GridPathfinder*> pathfinders;
+
+    public:
+        void findPaths(PathAlgorithm algorithm, const std::vector<PathQuery>& queries, std::vector<float>& pathCosts);
+        int size();
+
+        PathfinderPool(const GridMap& map, int numThreads);
+        PathfinderPool(const PathfinderPool&) = delete;
+        PathfinderPool& operator=(const PathfinderPool&) = delete;
+
+        ~PathfinderPool() {
+            for (GridPathfinder* pathfinder : pathfinders) {
+                delete pathfinder;
+            }
+        }
+};
+
+/* Function: findPaths
+ * Description: Sets pathCosts[i] to the cost of the path for queries[i] (-1 if there is none). The calling thread
+ *              and one new thread per other pathfinder take chunks of queries until none are left, so threads that
+ *              draw short queries take more of them.
+ *
+ * Param: PathAlgorithm algorithm, const std::vector<PathQuery>& queries, std::vector<float>& pathCosts
+*/
+inline void PathfinderPool::findPaths(PathAlgorithm algorithm, const std::vector<PathQuery>& queries, std::vector<float>& pathCosts) {
+    std::atomic<int> nextQuery{0};
+    std::vector<std::thread> threads;
+    int numQueries = queries.size();
+
+    pathCosts.resize(numQueries);
+
+    auto work = [&](GridPathfinder* pathfinder) {
+        for (int first = nextQuery.fetch_add(QUERY_CHUNK); first < numQueries; first = nextQuery.fetch_add(QUERY_CHUNK)) {
+            for (int i = first; i < std::min(first + QUERY_CHUNK, numQueries); i++) {
+                const PathQuery& query = queries[i];
+                pathCosts[i] = pathfinder->findPath(algorithm, query.startX, query.startY, query.goalX, query.goalY);
+            }
+        }
+    };
+
+    for (size_t i = 1; i < pathfinders.size(); i++) {
+        threads.push_back(std::thread(work, pathfinders[i]));
+    }
+
+    work(pathfinders[0]);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+//Return number of pathfinders, which is the most threads a batch runs on
+inline int PathfinderPool::size() {
+    return pathfinders.size();
+}
+
+inline PathfinderPool::PathfinderPool(const GridMap& map, int numThreads) {
+    for (int i = 0; i < std::max(numThreads, 1); i++) {
+        pathfinders.push_back(new GridPathfinder(map));
+    }
+}
+
+#endif
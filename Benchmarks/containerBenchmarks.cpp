@@ -0,0 +1,599 @@
+/* DESCRIPTION OF PROGRAM
+
+    This program benchmarks every container in the repository against its standard library equivalent on fixed
+    workloads, so that changes can be measured without editing any of the containers' own test drivers.
+
+    Keys come from one of four workloads: random (a shuffle of 0..n-1), sorted, reverse, and Zipf (n draws with
+    skew 0.99 over n keys, so a few hot keys take most of the operations). Each operation is timed over the whole
+    workload, and every heap allocation is counted by replacing the global operator new. Results are printed as a
+    table, with each container's time relative to the standard library container of its group, and can also be
+    written as JSON with --json.
+
+    Usage: containerBenchmarks [--size n] [--threads n] [--json path]
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <math.h>
+#include <mutex>
+#include <queue>
+#include <stack>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "heapTracking.h"
+#include "stdAdapters.h"
+
+#include "adaptiveRadixTree.h"
+#include "arrayStack.h"
+#include "bPlusTree.h"
+#include "bst.h"
+#include "listQueue.h"
+#include "listStack.h"
+#include "priorityQueue.h"
+#include "redBlackTree.h"
+#include "skipList.h"
+#include "vector.h"
+
+using namespace std;
+
+//WORKLOADS
+
+//Named sequence of keys that every container in a group is run on
+class Workload {
+
+    public:
+        string name;
+        std::vector<int> keys;
+};
+
+/* Function: makeWorkloads
+ * Description: Builds the random, sorted, reverse and Zipf workloads of numKeys keys each. The Zipf workload draws
+ *              ranks with probability proportional to 1 / rank^0.99 and maps them onto a shuffle of 0..n-1, so that
+ *              the hot keys are spread over the key space rather than being the smallest keys.
+ *
+ * Param: int numKeys
+*/
+std::vector<Workload> makeWorkloads(int numKeys) {
+    std::vector<Workload> workloads(4);
+    std::vector<int> shuffled(numKeys);
+    std::vector<double> cumulative(numKeys);
+    unsigned int seed = 1;
+    double total = 0;
+
+    for (int i = 0; i < numKeys; i++) {
+        shuffled[i] = i;
+    }
+
+    for (int i = numKeys - 1; i > 0; i--) {
+        seed = seed * 1103515245 + 12345;
+        std::swap(shuffled[i], shuffled[(seed >> 8) % (i + 1)]);
+    }
+
+    for (int i = 0; i < numKeys; i++) {
+        total += 1.0 / pow(i + 1, 0.99);
+        cumulative[i] = total;
+    }
+
+    workloads[0].name = "random";
+    workloads[0].keys = shuffled;
+    workloads[1].name = "sorted";
+    workloads[2].name = "reverse";
+    workloads[3].name = "zipf";
+
+    for (int i = 0; i < numKeys; i++) {
+        workloads[1].keys.push_back(i);
+        workloads[2].keys.push_back(numKeys - 1 - i);
+
+        seed = seed * 1103515245 + 12345;
+        double draw = total * ((seed >> 8) / 16777216.0);
+        int rank = std::lower_bound(cumulative.begin(), cumulative.end(), draw) - cumulative.begin();
+        workloads[3].keys.push_back(shuffled[std::min(rank, numKeys - 1)]);
+    }
+
+    return workloads;
+}
+
+//RESULTS
+
+//Timing of one operation of one container on one workload
+class Result {
+
+    public:
+        string group;
+        string container;
+        string workload;
+        string op;
+        long long numOps;
+        double nsPerOp;
+        double allocsPerOp;
+        double vsStd;
+};
+
+std::vector<Result> results;
+
+//Time per operation of each group's standard library container, by group, workload and operation
+std::map<string, double> stdNsPerOp;
+
+//Keeps the compiler from dropping lookups whose results are otherwise unused
+volatile long long benchmarkSink = 0;
+
+/* Function: measure
+ * Description: Runs the body once, recording its time and allocations per operation. The first container measured
+ *              for a group, workload and operation is the group's standard library container, and every other
+ *              container is reported relative to it.
+ *
+ * Param: const string& group, const string& container, const string& workload, const string& op, long long numOps, Body body
+*/
+template <typename Body>
+void measure(const string& group, const string& container, const string& workload, const string& op, long long numOps, Body body) {
+    long long startAllocations = heapAllocations.load();
+    auto start = std::chrono::steady_clock::now();
+
+    body();
+
+    auto end = std::chrono::steady_clock::now();
+    Result result;
+    string baselineKey = group + "/" + workload + "/" + op;
+
+    result.group = group;
+    result.container = container;
+    result.workload = workload;
+    result.op = op;
+    result.numOps = numOps;
+    result.nsPerOp = std::chrono::duration<double, std::nano>(end - start).count() / numOps;
+    result.allocsPerOp = (double) (heapAllocations.load() - startAllocations) / numOps;
+
+    if (stdNsPerOp.count(baselineKey) == 0) {
+        stdNsPerOp[baselineKey] = result.nsPerOp;
+    }
+
+    result.vsStd = result.nsPerOp / stdNsPerOp[baselineKey];
+    results.push_back(result);
+
+    cout << left << setw(16) << group << setw(22) << container << setw(9) << workload << setw(14) << op << right
+         << fixed << setprecision(1) << setw(10) << result.nsPerOp << " ns/op" << setprecision(2) << setw(8)
+         << result.allocsPerOp << " allocs/op" << setw(8) << result.vsStd << "x std" << endl;
+}
+
+/* Function: writeJson
+ * Description: Writes every result to the file at path as a JSON object, returning false if it cannot be written.
+ *
+ * Param: const char* path, int numKeys, int numThreads
+*/
+bool writeJson(const char* path, int numKeys, int numThreads) {
+    std::ofstream out(path);
+
+    if (!out) {
+        return false;
+    }
+
+    out << "{\n  \"size\": " << numKeys << ",\n  \"threads\": " << numThreads << ",\n  \"results\": [\n";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        Result& result = results[i];
+
+        out << "    {\"group\": \"" << result.group << "\", \"container\": \"" << result.container
+            << "\", \"workload\": \"" << result.workload << "\", \"op\": \"" << result.op
+            << "\", \"numOps\": " << result.numOps << ", \"nsPerOp\": " << result.nsPerOp
+            << ", \"allocsPerOp\": " << result.allocsPerOp << ", \"vsStd\": " << result.vsStd << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    out << "  ]\n}\n";
+    return (bool) out;
+}
+
+//CONTAINER ADAPTERS
+
+//Map guarded by one mutex, for comparing the lock-based maps with the SkipList under several threads
+template <typename Map>
+class LockedMap {
+
+    private:
+        Map map;
+        std::mutex lock;
+
+    public:
+        int get(int searchKey) {
+            std::lock_guard<std::mutex> guard(lock);
+            return map.get(searchKey);
+        }
+
+        void put(int newKey, int newValue) {
+            std::lock_guard<std::mutex> guard(lock);
+            map.put(newKey, newValue);
+        }
+
+        void remove(int searchKey) {
+            std::lock_guard<std::mutex> guard(lock);
+            map.remove(searchKey);
+        }
+};
+
+//BENCHMARKS
+
+/* Function: benchmarkVector2
+ * Description: Times dot products, distances, normalization and angles on Vector2 against std::complex<float>,
+ *              with each workload's keys turned into coordinates.
+ *
+ * Param: const Workload& workload
+*/
+void benchmarkVector2(const Workload& workload) {
+    std::vector<Vector2> vectors;
+    std::vector<std::complex<float> > complexes;
+    int numOps = workload.keys.size() - 1;
+    float checksum = 0;
+
+    for (int key : workload.keys) {
+        vectors.push_back(Vector2((float) (key % 1000) + 1, (float) (key / 1000) + 1));
+        complexes.push_back(std::complex<float>((float) (key % 1000) + 1, (float) (key / 1000) + 1));
+    }
+
+    measure("vector2", "std::complex", workload.name, "dot", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += (std::conj(complexes[i]) * complexes[i + 1]).real();
+        }
+    });
+    measure("vector2", "Vector2", workload.name, "dot", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += vectors[i].dot(vectors[i + 1]);
+        }
+    });
+    measure("vector2", "std::complex", workload.name, "getDistance", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += std::abs(complexes[i] - complexes[i + 1]);
+        }
+    });
+    measure("vector2", "Vector2", workload.name, "getDistance", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += vectors[i].getDistance(vectors[i + 1]);
+        }
+    });
+    measure("vector2", "std::complex", workload.name, "normalize", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += (complexes[i] / std::abs(complexes[i])).real();
+        }
+    });
+    measure("vector2", "Vector2", workload.name, "normalize", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += vectors[i].normalize().xCoord;
+        }
+    });
+    measure("vector2", "std::complex", workload.name, "getAngle", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += std::arg(complexes[i]);
+        }
+    });
+    measure("vector2", "Vector2", workload.name, "getAngle", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += vectors[i].getAngle(false);
+        }
+    });
+
+    benchmarkSink += (long long) checksum;
+}
+
+/* Function: benchmarkStacks
+ * Description: Pushes every key of the workload and pops them all again on ArrayStack and the linked-list Stack,
+ *              against std::stack.
+ *
+ * Param: const Workload& workload
+*/
+void benchmarkStacks(const Workload& workload) {
+    int numOps = workload.keys.size();
+    long long checksum = 0;
+
+    std::stack<int>* stdStack = new std::stack<int>();
+    measure("stack", "std::stack", workload.name, "push", numOps, [&]() {
+        for (int key : workload.keys) {
+            stdStack->push(key);
+        }
+    });
+    measure("stack", "std::stack", workload.name, "pop", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += stdStack->top();
+            stdStack->pop();
+        }
+    });
+    delete stdStack;
+
+    ArrayStack<int>* arrayStack = new ArrayStack<int>();
+    measure("stack", "ArrayStack", workload.name, "push", numOps, [&]() {
+        for (int key : workload.keys) {
+            arrayStack->push(key);
+        }
+    });
+    measure("stack", "ArrayStack", workload.name, "pop", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += arrayStack->pop();
+        }
+    });
+    delete arrayStack;
+
+    Stack<int>* listStack = new Stack<int>();
+    measure("stack", "Stack", workload.name, "push", numOps, [&]() {
+        for (int key : workload.keys) {
+            listStack->push(key);
+        }
+    });
+    measure("stack", "Stack", workload.name, "pop", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += listStack->pop();
+        }
+    });
+    delete listStack;
+
+    benchmarkSink += checksum;
+}
+
+/* Function: benchmarkQueues
+ * Description: Enqueues every key of the workload and dequeues them all again on the linked-list Queue,
+ *              against std::queue.
+ *
+ * Param: const Workload& workload
+*/
+void benchmarkQueues(const Workload& workload) {
+    int numOps = workload.keys.size();
+    long long checksum = 0;
+
+    std::queue<int>* stdQueue = new std::queue<int>();
+    measure("queue", "std::queue", workload.name, "enqueue", numOps, [&]() {
+        for (int key : workload.keys) {
+            stdQueue->push(key);
+        }
+    });
+    measure("queue", "std::queue", workload.name, "dequeue", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += stdQueue->front();
+            stdQueue->pop();
+        }
+    });
+    delete stdQueue;
+
+    Queue<int>* listQueue = new Queue<int>();
+    measure("queue", "Queue", workload.name, "enqueue", numOps, [&]() {
+        for (int key : workload.keys) {
+            listQueue->enqueue(key);
+        }
+    });
+    measure("queue", "Queue", workload.name, "dequeue", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += listQueue->dequeue();
+        }
+    });
+    delete listQueue;
+
+    benchmarkSink += checksum;
+}
+
+/* Function: benchmarkPriorityQueues
+ * Description: Inserts every key of the workload as its own priority and removes them all in priority order on
+ *              PriorityQ and MinMaxPriorityQ, against std::priority_queue.
+ *
+ * Param: const Workload& workload
+*/
+void benchmarkPriorityQueues(const Workload& workload) {
+    int numOps = workload.keys.size();
+    long long checksum = 0;
+
+    std::priority_queue<std::pair<int,int> >* stdQueue = new std::priority_queue<std::pair<int,int> >();
+    measure("priorityQueue", "std::priority_queue", workload.name, "insert", numOps, [&]() {
+        for (int key : workload.keys) {
+            stdQueue->push(std::make_pair(key, key));
+        }
+    });
+    measure("priorityQueue", "std::priority_queue", workload.name, "deleteMax", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += stdQueue->top().second;
+            stdQueue->pop();
+        }
+    });
+    delete stdQueue;
+
+    PriorityQ<int>* heap = new PriorityQ<int>();
+    measure("priorityQueue", "PriorityQ", workload.name, "insert", numOps, [&]() {
+        for (int key : workload.keys) {
+            heap->insert(key, key);
+        }
+    });
+    measure("priorityQueue", "PriorityQ", workload.name, "deleteMax", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += heap->deleteMax();
+        }
+    });
+    delete heap;
+
+    MinMaxPriorityQ<int>* minMaxHeap = new MinMaxPriorityQ<int>();
+    measure("priorityQueue", "MinMaxPriorityQ", workload.name, "insert", numOps, [&]() {
+        for (int key : workload.keys) {
+            minMaxHeap->insert(key, key);
+        }
+    });
+    measure("priorityQueue", "MinMaxPriorityQ", workload.name, "deleteMax", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            checksum += minMaxHeap->deleteMax();
+        }
+    });
+    delete minMaxHeap;
+
+    benchmarkSink += checksum;
+}
+
+/* Function: benchmarkMap
+ * Description: Puts every key of the workload into a fresh map, gets each of them, then removes each of them,
+ *              timing the three passes separately. Keys repeated by the Zipf workload are updated, looked up
+ *              again and removed again (a miss) like any other operation.
+ *
+ * Param: const string& container, const Workload& workload
+*/
+template <typename Map>
+void benchmarkMap(const string& container, const Workload& workload) {
+    Map* map = new Map();
+    int numOps = workload.keys.size();
+    long long checksum = 0;
+
+    measure("orderedMap", container, workload.name, "put", numOps, [&]() {
+        for (int i = 0; i < numOps; i++) {
+            map->put(workload.keys[i], i);
+        }
+    });
+    measure("orderedMap", container, workload.name, "get", numOps, [&]() {
+        for (int key : workload.keys) {
+            checksum += map->get(key);
+        }
+    });
+    measure("orderedMap", container, workload.name, "remove", numOps, [&]() {
+        for (int key : workload.keys) {
+            map->remove(key);
+        }
+    });
+
+    delete map;
+    benchmarkSink += checksum;
+}
+
+/* Function: benchmarkMaps
+ * Description: Runs benchmarkMap on every ordered map, against std::map. The unbalanced BST is skipped on the
+ *              sorted and reverse workloads, where it degrades to a linked list and would take O(n^2) time.
+ *
+ * Param: const Workload& workload
+*/
+void benchmarkMaps(const Workload& workload) {
+    bool ordered = workload.name == "sorted" || workload.name == "reverse";
+
+    benchmarkMap<StdMap<int,int> >("std::map", workload);
+    benchmarkMap<RedBlack<int,int> >("RedBlack", workload);
+    benchmarkMap<CompactRedBlack<int,int> >("CompactRedBlack", workload);
+
+    if (!ordered) {
+        benchmarkMap<BST<int,int,Unbalanced> >("BST<Unbalanced>", workload);
+    }
+
+    benchmarkMap<BST<int,int,Treap> >("BST<Treap>", workload);
+    benchmarkMap<BST<int,int,Scapegoat> >("BST<Scapegoat>", workload);
+    benchmarkMap<BST<int,int,Splay> >("BST<Splay>", workload);
+    benchmarkMap<BST<int,int,SemiSplay> >("BST<SemiSplay>", workload);
+    benchmarkMap<BPlusTree<int,int> >("BPlusTree", workload);
+    benchmarkMap<AdaptiveRadixTree<int,int> >("AdaptiveRadixTree", workload);
+    benchmarkMap<SkipList<int,int> >("SkipList", workload);
+}
+
+/* Function: benchmarkConcurrentMap
+ * Description: Runs numThreads threads doing random gets, puts and removes (writes split evenly between puts and
+ *              removes) on a map prefilled with every other key, and records the wall time per operation.
+ *
+ * Param: const string& container, int readPercent, int numThreads, int numKeys
+*/
+template <typename Map>
+void benchmarkConcurrentMap(const string& container, int readPercent, int numThreads, int numKeys) {
+    Map* map = new Map();
+    std::atomic<long long> checksum{0};
+    int opsPerThread = numKeys;
+
+    for (int i = 0; i < numKeys; i += 2) {
+        map->put(i, i);
+    }
+
+    measure("concurrentMap", container, std::to_string(readPercent) + "%read", "mixed", (long long) numThreads * opsPerThread, [&]() {
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < numThreads; i++) {
+            threads.push_back(std::thread([&, i]() {
+                unsigned int seed = i + 1;
+                long long threadChecksum = 0;
+
+                for (int j = 0; j < opsPerThread; j++) {
+                    seed = seed * 1103515245 + 12345;
+                    int key = (seed >> 8) % numKeys;
+
+                    if ((int) ((seed >> 4) % 100) < readPercent) {
+                        threadChecksum += map->get(key);
+                    }
+
+                    else if (j % 2 == 0) {
+                        map->put(key, j);
+                    }
+
+                    else {
+                        map->remove(key);
+                    }
+                }
+
+                checksum.fetch_add(threadChecksum);
+            }));
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    });
+
+    delete map;
+    benchmarkSink += checksum.load();
+}
+
+//Compares the lock-free SkipList with RedBlack and std::map behind one mutex, at several read percentages
+void benchmarkConcurrentMaps(int numThreads, int numKeys) {
+    int readPercents[] = {50, 90, 99};
+
+    for (int readPercent : readPercents) {
+        benchmarkConcurrentMap<LockedMap<StdMap<int,int> > >("mutex std::map", readPercent, numThreads, numKeys);
+        benchmarkConcurrentMap<LockedMap<RedBlack<int,int> > >("mutex RedBlack", readPercent, numThreads, numKeys);
+        benchmarkConcurrentMap<SkipList<int,int> >("SkipList", readPercent, numThreads, numKeys);
+    }
+}
+
+//Driver for the benchmark suite
+int main(int argc, char** argv) {
+    int numKeys = 100000;
+    int numThreads = std::max(2, (int) std::thread::hardware_concurrency());
+    const char* jsonPath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            numKeys = std::max(2, atoi(argv[++i]));
+        }
+
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numThreads = std::max(1, atoi(argv[++i]));
+        }
+
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+
+        else {
+            cout << "Usage: " << argv[0] << " [--size n] [--threads n] [--json path]" << endl;
+            return 1;
+        }
+    }
+
+    std::vector<Workload> workloads = makeWorkloads(numKeys);
+
+    for (Workload& workload : workloads) {
+        benchmarkVector2(workload);
+        benchmarkStacks(workload);
+        benchmarkQueues(workload);
+        benchmarkPriorityQueues(workload);
+        benchmarkMaps(workload);
+    }
+
+    benchmarkConcurrentMaps(numThreads, numKeys);
+
+    if (jsonPath != NULL && !writeJson(jsonPath, numKeys, numThreads)) {
+        cout << "Error: Could not write " << jsonPath << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+/* DESCRIPTION OF FILE
+
+    Replacements for the global operator new and delete that keep the counters declared in heapTracking.h. They live
+    in their own translation unit so that a program has exactly one definition of them.
+*/
+
+#include <algorithm>
+#include <malloc.h>
+#include <new>
+#include <stdlib.h>
+
+#include "heapTracking.h"
+
+std::atomic<long long> heapAllocations{0};
+std::atomic<long long> heapLiveBytes{0};
+std::atomic<long long> heapPeakBytes{0};
+
+//Counts a new allocation and raises the peak if needed
+static void* trackAllocation(void* memory) {
+    long long numBytes = malloc_usable_size(memory);
+    long long liveBytes = heapLiveBytes.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+    long long peakBytes = heapPeakBytes.load(std::memory_order_relaxed);
+
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    while (peakBytes < liveBytes && !heapPeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {}
+
+    return memory;
+}
+
+static void trackFree(void* memory) {
+    if (memory != NULL) {
+        heapLiveBytes.fetch_sub(malloc_usable_size(memory), std::memory_order_relaxed);
+        free(memory);
+    }
+}
+
+void* operator new(size_t numBytes) {
+    void* memory = malloc(numBytes > 0 ? numBytes : 1);
+
+    if (memory == NULL) {
+        throw std::bad_alloc();
+    }
+
+    return trackAllocation(memory);
+}
+
+void* operator new[](size_t numBytes) {
+    return operator new(numBytes);
+}
+
+void* operator new(size_t numBytes, std::align_val_t alignment) {
+    size_t align = std::max((size_t) alignment, sizeof(void*));
+    void* memory = NULL;
+
+    if (posix_memalign(&memory, align, numBytes > 0 ? numBytes : 1) != 0) {
+        throw std::bad_alloc();
+    }
+
+    return trackAllocation(memory);
+}
+
+void* operator new[](size_t numBytes, std::align_val_t alignment) {
+    return operator new(numBytes, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+    trackFree(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    trackFree(memory);
+}
+
+void operator delete(void* memory, size_t numBytes) noexcept {
+    trackFree(memory);
+}
+
+void operator delete[](void* memory, size_t numBytes) noexcept {
+    trackFree(memory);
+}
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+    trackFree(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t alignment) noexcept {
+    trackFree(memory);
+}
+
+void operator delete(void* memory, size_t numBytes, std::align_val_t alignment) noexcept {
+    trackFree(memory);
+}
+
+void operator delete[](void* memory, size_t numBytes, std::align_val_t alignment) noexcept {
+    trackFree(memory);
+}
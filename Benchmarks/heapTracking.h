@@ -0,0 +1,27 @@
+/* DESCRIPTION OF FILE
+
+    Heap counters for the benchmark programs, kept by the replacements for the global operator new and delete in
+    heapTracking.cpp, which must be linked into any program including this file. Every heap allocation is counted
+    and the bytes live on the heap and their peak are tracked.
+
+    Sizes come from malloc_usable_size, so they include the allocator's rounding and are specific to glibc.
+*/
+
+#ifndef HEAP_TRACKING_H
+#define HEAP_TRACKING_H
+
+#include <atomic>
+
+//Number of heap allocations made so far by any thread
+extern std::atomic<long long> heapAllocations;
+
+//Bytes currently allocated, and the most allocated at once since the last resetHeapPeak
+extern std::atomic<long long> heapLiveBytes;
+extern std::atomic<long long> heapPeakBytes;
+
+//Starts a new peak from the bytes allocated now
+inline void resetHeapPeak() {
+    heapPeakBytes.store(heapLiveBytes.load());
+}
+
+#endif
@@ -0,0 +1,96 @@
+/* DESCRIPTION OF FILE
+
+    Standard library containers behind the interfaces of the repository's own containers, so the benchmark programs
+    can run the same code against both.
+*/
+
+#ifndef STD_ADAPTERS_H
+#define STD_ADAPTERS_H
+
+#include <map>
+#include <queue>
+#include <utility>
+
+//std::map behind the put/get/remove interface of the repository's maps
+template <typename K, typename V>
+class StdMap {
+
+    private:
+        std::map<K,V> entries;
+
+    public:
+        V get(const K& searchKey) {
+            typename std::map<K,V>::iterator found = entries.find(searchKey);
+            return found != entries.end() ? found->second : V();
+        }
+
+        void put(const K& newKey, const V& newValue) {
+            entries[newKey] = newValue;
+        }
+
+        void remove(const K& searchKey) {
+            entries.erase(searchKey);
+        }
+
+        int size() {
+            return entries.size();
+        }
+};
+
+//std::priority_queue behind the insert/deleteMax interface of PriorityQ
+template <typename V>
+class StdPriorityQueue {
+
+    private:
+        std::priority_queue<std::pair<int,V> > entries;
+
+    public:
+        V deleteMax() {
+            V max = V();
+
+            if (!entries.empty()) {
+                max = entries.top().second;
+                entries.pop();
+            }
+
+            return max;
+        }
+
+        void insert(int priority, V value) {
+            entries.push(std::make_pair(priority, value));
+        }
+
+        int size() {
+            return entries.size();
+        }
+};
+
+//std::queue behind the enqueue/dequeue interface of Queue
+template <typename V>
+class StdQueue {
+
+    private:
+        std::queue<V> entries;
+
+    public:
+        V dequeue() {
+            V front = V();
+
+            if (!entries.empty()) {
+                front = entries.front();
+                entries.pop();
+            }
+
+            return front;
+        }
+
+        void enqueue(V value) {
+            entries.push(value);
+        }
+
+        int size() {
+            return entries.size();
+        }
+};
+
+#endif
@@ -0,0 +1,280 @@
+/* DESCRIPTION OF PROGRAM
+
+    This program replays an operation trace recorded from a RedBlack tree, a PriorityQ or MinMaxPriorityQ, or a
+    Queue (see traceRecorder.h) against every container with the same interface, to judge new containers on real
+    traffic rather than synthetic loops.
+
+    Map traces are replayed on std::map and the repository's ordered maps, priority queue traces on
+    std::priority_queue, PriorityQ and MinMaxPriorityQ (only MinMaxPriorityQ if the trace has a deleteMin), and
+    queue traces on std::queue and Queue. Keys and priorities are replayed as recorded and values are the record's
+    position in the trace.
+
+    Each container replays the trace twice. The first run is timed as a whole, for throughput. The second run times
+    every operation, for the latency percentiles, and tracks the heap bytes allocated above what was live before
+    the container was built, for the peak memory. The container's size at the end is checked against the trace.
+
+    Usage: traceReplay trace [--container name]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "heapTracking.h"
+#include "stdAdapters.h"
+
+#include "adaptiveRadixTree.h"
+#include "bPlusTree.h"
+#include "bst.h"
+#include "listQueue.h"
+#include "priorityQueue.h"
+#include "redBlackTree.h"
+#include "skipList.h"
+#include "traceRecorder.h"
+
+using namespace std;
+
+//Kinds of container a trace can be replayed on, decided by the operations it holds
+enum TraceKind { MAP_TRACE, PRIORITY_TRACE, QUEUE_TRACE, MIXED_TRACE };
+
+//Keeps the compiler from dropping operations whose results are otherwise unused
+volatile long long replaySink = 0;
+
+//APPLYING RECORDS
+
+//Applies one record of a map trace, returning the value read if any
+template <typename Map>
+long long applyMapRecord(Map& map, const TraceRecord& record, int64_t position) {
+
+    if (record.op == TRACE_GET) {
+        return map.get(record.key);
+    }
+
+    else if (record.op == TRACE_PUT) {
+        map.put(record.key, position);
+    }
+
+    else {
+        map.remove(record.key);
+    }
+
+    return 0;
+}
+
+//Applies one record of a priority queue trace, returning the value removed if any
+template <typename PriorityQueue>
+long long applyPriorityRecord(PriorityQueue& queue, const TraceRecord& record, int64_t position) {
+
+    if (record.op == TRACE_INSERT) {
+        queue.insert((int) record.priority, position);
+        return 0;
+    }
+
+    return queue.deleteMax();
+}
+
+//Applies one record of a priority queue trace to a MinMaxPriorityQ, which also replays deleteMin
+template <typename PriorityQueue>
+long long applyMinMaxRecord(PriorityQueue& queue, const TraceRecord& record, int64_t position) {
+
+    if (record.op == TRACE_INSERT) {
+        queue.insert((int) record.priority, position);
+        return 0;
+    }
+
+    else if (record.op == TRACE_DELETE_MIN) {
+        return queue.deleteMin();
+    }
+
+    return queue.deleteMax();
+}
+
+//Applies one record of a queue trace, returning the value dequeued if any
+template <typename Queue>
+long long applyQueueRecord(Queue& queue, const TraceRecord& record, int64_t position) {
+
+    if (record.op == TRACE_ENQUEUE) {
+        queue.enqueue(position);
+        return 0;
+    }
+
+    return queue.dequeue();
+}
+
+//REPLAY
+
+/* Function: classifyTrace
+ * Description: Returns the kind of container the trace's operations belong to, or MIXED_TRACE if they belong to
+ *              more than one. Sets hasDeleteMin to whether the trace removes minimums.
+ *
+ * Param: const std::vector<TraceRecord>& records, bool& hasDeleteMin
+*/
+TraceKind classifyTrace(const std::vector<TraceRecord>& records, bool& hasDeleteMin) {
+    bool seen[3] = {false, false, false};
+
+    hasDeleteMin = false;
+
+    for (const TraceRecord& record : records) {
+        if (record.op <= TRACE_REMOVE) {
+            seen[MAP_TRACE] = true;
+        }
+
+        else if (record.op <= TRACE_DELETE_MIN) {
+            seen[PRIORITY_TRACE] = true;
+            hasDeleteMin |= record.op == TRACE_DELETE_MIN;
+        }
+
+        else {
+            seen[QUEUE_TRACE] = true;
+        }
+    }
+
+    if (seen[MAP_TRACE] + seen[PRIORITY_TRACE] + seen[QUEUE_TRACE] > 1) {
+        return MIXED_TRACE;
+    }
+
+    return seen[PRIORITY_TRACE] ? PRIORITY_TRACE : seen[QUEUE_TRACE] ? QUEUE_TRACE : MAP_TRACE;
+}
+
+/* Function: replay
+ * Description: Replays the trace on a fresh container twice, once timed as a whole and once timing every
+ *              operation and tracking the heap, and prints the throughput, latency percentiles and peak memory.
+ *              Does nothing if a container filter is given and does not match the name.
+ *
+ * Param: const string& name, const std::vector<TraceRecord>& records, const string& filter, Apply apply
+*/
+template <typename Container, typename Apply>
+void replay(const string& name, const std::vector<TraceRecord>& records, const string& filter, Apply apply) {
+    std::vector<uint64_t> latencies(records.size());
+    long long checksum = 0;
+    int64_t numRecords = records.size();
+
+    if (!filter.empty() && filter != name) {
+        return;
+    }
+
+    Container* container = new Container();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int64_t i = 0; i < numRecords; i++) {
+        checksum += apply(*container, records[i], i);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    delete container;
+
+    resetHeapPeak();
+    long long baselineBytes = heapLiveBytes.load();
+    container = new Container();
+
+    for (int64_t i = 0; i < numRecords; i++) {
+        auto opStart = std::chrono::steady_clock::now();
+        checksum += apply(*container, records[i], i);
+        latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - opStart).count();
+    }
+
+    long long peakBytes = heapPeakBytes.load() - baselineBytes;
+    bool sizeMatches = (uint64_t) container->size() == records.back().size;
+    delete container;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    cout << left << setw(22) << name << right << setw(12) << (long long) (numRecords / seconds) << " ops/s"
+         << "   p50 " << setw(6) << latencies[numRecords / 2] << "ns"
+         << "   p99 " << setw(6) << latencies[numRecords * 99 / 100] << "ns"
+         << "   p99.9 " << setw(7) << latencies[numRecords * 999 / 1000] << "ns"
+         << "   max " << setw(8) << latencies.back() << "ns"
+         << "   peak " << setw(10) << peakBytes << " bytes"
+         << (sizeMatches ? "" : "   (final size differs from the trace)") << endl;
+
+    replaySink += checksum;
+}
+
+//Replays a map trace on every ordered map
+void replayMaps(const std::vector<TraceRecord>& records, const string& filter) {
+    replay<StdMap<int64_t,int64_t> >("std::map", records, filter, applyMapRecord<StdMap<int64_t,int64_t> >);
+    replay<RedBlack<int64_t,int64_t> >("RedBlack", records, filter, applyMapRecord<RedBlack<int64_t,int64_t> >);
+    replay<CompactRedBlack<int64_t,int64_t> >("CompactRedBlack", records, filter, applyMapRecord<CompactRedBlack<int64_t,int64_t> >);
+    replay<BST<int64_t,int64_t,Treap> >("BST<Treap>", records, filter, applyMapRecord<BST<int64_t,int64_t,Treap> >);
+    replay<BST<int64_t,int64_t,Scapegoat> >("BST<Scapegoat>", records, filter, applyMapRecord<BST<int64_t,int64_t,Scapegoat> >);
+    replay<BST<int64_t,int64_t,Splay> >("BST<Splay>", records, filter, applyMapRecord<BST<int64_t,int64_t,Splay> >);
+    replay<BPlusTree<int64_t,int64_t> >("BPlusTree", records, filter, applyMapRecord<BPlusTree<int64_t,int64_t> >);
+    replay<AdaptiveRadixTree<int64_t,int64_t> >("AdaptiveRadixTree", records, filter, applyMapRecord<AdaptiveRadixTree<int64_t,int64_t> >);
+    replay<SkipList<int64_t,int64_t> >("SkipList", records, filter, applyMapRecord<SkipList<int64_t,int64_t> >);
+}
+
+//Replays a priority queue trace on every priority queue that has its operations
+void replayPriorityQueues(const std::vector<TraceRecord>& records, const string& filter, bool hasDeleteMin) {
+
+    if (!hasDeleteMin) {
+        replay<StdPriorityQueue<int64_t> >("std::priority_queue", records, filter, applyPriorityRecord<StdPriorityQueue<int64_t> >);
+        replay<PriorityQ<int64_t> >("PriorityQ", records, filter, applyPriorityRecord<PriorityQ<int64_t> >);
+    }
+
+    replay<MinMaxPriorityQ<int64_t> >("MinMaxPriorityQ", records, filter, applyMinMaxRecord<MinMaxPriorityQ<int64_t> >);
+}
+
+//Replays a queue trace on every queue
+void replayQueues(const std::vector<TraceRecord>& records, const string& filter) {
+    replay<StdQueue<int64_t> >("std::queue", records, filter, applyQueueRecord<StdQueue<int64_t> >);
+    replay<Queue<int64_t> >("Queue", records, filter, applyQueueRecord<Queue<int64_t> >);
+}
+
+//Driver for replaying a trace
+int main(int argc, char** argv) {
+    std::vector<TraceRecord> records;
+    string filter;
+    bool hasDeleteMin;
+
+    if (argc == 4 && strcmp(argv[2], "--container") == 0) {
+        filter = argv[3];
+    }
+
+    else if (argc != 2) {
+        cout << "Usage: " << argv[0] << " trace [--container name]" << endl;
+        return 1;
+    }
+
+    if (!loadTrace(argv[1], records)) {
+        cout << "Error: Could not read a trace from " << argv[1] << endl;
+        return 1;
+    }
+
+    if (records.empty()) {
+        cout << "Error: The trace holds no operations." << endl;
+        return 1;
+    }
+
+    TraceKind kind = classifyTrace(records, hasDeleteMin);
+    uint64_t maxSize = 0;
+
+    for (const TraceRecord& record : records) {
+        maxSize = std::max(maxSize, record.size);
+    }
+
+    cout << records.size() << " operations, up to " << maxSize << " elements" << endl;
+
+    if (kind == MAP_TRACE) {
+        replayMaps(records, filter);
+    }
+
+    else if (kind == PRIORITY_TRACE) {
+        replayPriorityQueues(records, filter, hasDeleteMin);
+    }
+
+    else if (kind == QUEUE_TRACE) {
+        replayQueues(records, filter);
+    }
+
+    else {
+        cout << "Error: The trace mixes operations of different containers." << endl;
+        return 1;
+    }
+
+    return 0;
+}
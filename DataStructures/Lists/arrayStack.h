@@ -0,0 +1,90 @@
+#ifndef ARRAY_STACK_H
+#define ARRAY_STACK_H
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+//Simple single-type ArrayStackNode class
+template <class V>
+class ArrayStackNode {
+
+    public:
+        V value;
+
+        ArrayStackNode(V value) {
+            this->value = value;
+        }
+};
+
+//Resizing-Array Implemented Stack
+template <typename V>
+class ArrayStack {
+
+    private:
+        std::vector<ArrayStackNode<V>*> nodes;
+
+    public:
+        void push(V value);
+        V pop();
+        int size();
+
+        ArrayStack(int startSize = 10) {
+            nodes.reserve(startSize);
+        }
+};
+
+/* Function: push
+ * Description: This function pushes the passed value to the stack by assigning it to a new node.
+*/ 
+template <typename V>
+void ArrayStack<V>::push(V value) {
+    ArrayStackNode<V>* newNode = new ArrayStackNode<V>(value);
+
+    //Double the node stack's capacity when it is full
+    if (nodes.size() == nodes.capacity()) {
+        nodes.reserve(std::max((size_t) 1, nodes.capacity() * 2));
+    }
+
+    nodes.push_back(newNode);
+}
+
+/* Function: pop
+ * Description: This function pops the most recent value added to the stack, and deletes the associated node.
+*/ 
+template <typename V>
+V ArrayStack<V>::pop() {
+    V popValue;
+
+    //Retrieve the node's value and remove it from the stack
+    if (nodes.size() > 0) {
+        popValue = nodes.back()->value;
+        delete nodes.back();
+        nodes.pop_back();
+
+        //Halve node stack capacity when num nodes N < Capacity/4
+        if (nodes.size() < nodes.capacity() / 4) {
+            std::vector<ArrayStackNode<V>*> smallerNodes;
+            smallerNodes.reserve(nodes.capacity() / 2);
+            smallerNodes.assign(nodes.begin(), nodes.end());
+            nodes.swap(smallerNodes);
+        }
+    }
+    
+    else {
+        cout << "Error: Attempt to pop from empty stack.\n";
+        exit(1);
+    }
+
+    return popValue;
+}
+
+//Return number of nodes in the stack
+template <typename V>
+int ArrayStack<V>::size() {
+  return nodes.size();
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef LIST_QUEUE_H
+#define LIST_QUEUE_H
+
+#include <iostream>
+
+#include "../nodeAllocators.h"
+#include "../traceRecorder.h"
+
+using namespace std;
+
+//Simple single-type QueueNode class
+template <class V>
+class QueueNode {
+
+    public:
+        V value;
+        QueueNode<V>* next;
+        
+        QueueNode(V value) {
+            this->value = value;
+            this->next = NULL;
+        }
+};
+
+//Linked-List Implemented Queue, nodes come from the Allocator (see nodeAllocators.h)
+template <typename V, template <class> class Allocator = HeapAllocator>
+class Queue {
+
+    private:
+        QueueNode<V>* head;
+        QueueNode<V>* tail;
+        int numNodes;
+        TraceRecorder* recorder;
+        Allocator<QueueNode<V> > nodes;
+
+    public:
+        void clear();
+        void enqueue(V value);
+        V dequeue();
+        void setRecorder(TraceRecorder* newRecorder);
+        int size();
+
+        Queue() {
+            head = NULL;
+            tail = NULL;
+            numNodes = 0;
+            recorder = NULL;
+        }
+
+        //Takes every node from the resource, for a queue using PmrAllocator
+        Queue(std::pmr::memory_resource* resource) : nodes(resource) {
+            head = NULL;
+            tail = NULL;
+            numNodes = 0;
+            recorder = NULL;
+        }
+
+        Queue(const Queue&) = delete;
+        Queue& operator=(const Queue&) = delete;
+
+        ~Queue() {
+            clear();
+        }
+};
+
+/* Function: clear
+ * Description: This function removes every value from the queue, and deletes their nodes. Clearing is not recorded.
+*/
+template <typename V, template <class> class Allocator>
+void Queue<V,Allocator>::clear() {
+    while (head != NULL) {
+        QueueNode<V>* deqNode = head;
+        head = head->next;
+        nodes.destroy(deqNode);
+    }
+
+    nodes.releaseAll();
+    tail = NULL;
+    numNodes = 0;
+}
+
+/* Function: dequeue
+ * Description: This function dequeues the last value added to the queue, and deletes its node.
+*/
+template <typename V, template <class> class Allocator>
+V Queue<V,Allocator>::dequeue() {
+    QueueNode<V>* deqNode = head;
+    V deqValue = V();
+
+    //Queue is empty
+    if (deqNode != NULL) {
+        deqValue = head->value;
+        head = head->next;
+        nodes.destroy(deqNode);
+        numNodes--;
+
+        //Last node was dequeued
+        if (head == NULL) {
+            tail = NULL;
+        }
+    }
+
+    if (recorder != NULL) {
+        recorder->record(TRACE_DEQUEUE, 0, 0, numNodes);
+    }
+    
+    return deqValue;
+}
+
+/* Function: enqueue
+ * Description: This function enqueues the passed value, adding it to the queue as a node.
+*/
+template <typename V, template <class> class Allocator>
+void Queue<V,Allocator>::enqueue(V value) {
+    QueueNode<V>* newNode = nodes.create(value);
+
+    if (newNode == NULL) {
+        cout << "Err: Could not allocate new queue node.\n";
+        exit(1);
+    }
+
+    //First node added
+    if (tail == NULL) {
+        tail = newNode;
+        head = tail;
+    }
+
+    //Subsequent nodes
+    else {
+        tail->next = newNode;
+        tail = newNode;
+    }
+
+    numNodes++;
+
+    if (recorder != NULL) {
+        recorder->record(TRACE_ENQUEUE, 0, 0, numNodes);
+    }
+}
+
+/* Function: setRecorder
+ * Description: This function records every enqueue and dequeue from now on to the recorder (see traceRecorder.h),
+ * or stops recording if it is NULL. The recorder must outlive the queue or be detached first.
+*/
+template <typename V, template <class> class Allocator>
+void Queue<V,Allocator>::setRecorder(TraceRecorder* newRecorder) {
+    recorder = newRecorder;
+}
+
+/* Function: size
+ * Description: This function returns the size of the queue as the number of elements within.
+*/
+template <typename V, template <class> class Allocator>
+int Queue<V,Allocator>::size() {
+    return numNodes;
+}
+
+#endif
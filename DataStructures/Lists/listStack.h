@@ -0,0 +1,106 @@
+#ifndef LIST_STACK_H
+#define LIST_STACK_H
+
+#include <iostream>
+
+#include "../nodeAllocators.h"
+
+using namespace std;
+
+//Simple single-type StackNode class
+template <class V>
+class StackNode {
+
+    public:
+        V value;
+        StackNode<V>* next;
+        
+        StackNode(V value, StackNode<V>* head) {
+            this->value = value;
+            next = head;
+        }
+};
+
+//Linked-List Implemented Stack, nodes come from the Allocator (see nodeAllocators.h)
+template <typename V, template <class> class Allocator = HeapAllocator>
+class Stack {
+
+    private:
+        StackNode<V>* head;
+        Allocator<StackNode<V> > nodes;
+
+    public:
+        void clear();
+        void push(V value);
+        V pop();
+        int size();
+
+        Stack() {
+            head = NULL;
+        }
+
+        //Takes every node from the resource, for a stack using PmrAllocator
+        Stack(std::pmr::memory_resource* resource) : nodes(resource) {
+            head = NULL;
+        }
+
+        Stack(const Stack&) = delete;
+        Stack& operator=(const Stack&) = delete;
+
+        ~Stack() {
+            clear();
+        }
+};
+
+/* Function: clear
+ * Description: This function removes every value from the stack, and deletes their nodes.
+*/
+template <typename V, template <class> class Allocator>
+void Stack<V,Allocator>::clear() {
+    while (this->head != NULL) {
+        StackNode<V>* poppedNode = this->head;
+        this->head = this->head->next;
+        nodes.destroy(poppedNode);
+    }
+
+    nodes.releaseAll();
+}
+
+/* Function: push
+ * Description: This function pushes the passed value to the stack by assigning it to a new node.
+*/
+template <typename V, template <class> class Allocator>
+void Stack<V,Allocator>::push(V value) {
+    StackNode<V>* newNode = nodes.create(value, this->head);
+    this->head = newNode;
+}
+
+/* Function: pop
+ * Description: This function pops the most recent value added to the stack, and deletes the associated node.
+*/
+template <typename V, template <class> class Allocator>
+V Stack<V,Allocator>::pop() {
+    StackNode<V>* poppedNode = this->head;
+    V poppedValue = poppedNode->value;
+    this->head = this->head->next;
+    nodes.destroy(poppedNode);
+
+    return poppedValue;    
+}
+
+//Return number of nodes in the stack
+template <typename V, template <class> class Allocator>
+int Stack<V,Allocator>::size() {
+    int stackSize = 0;
+
+    StackNode<V>* iterNode = this->head;
+
+    while (iterNode != NULL) {
+        iterNode = iterNode->next;
+        stackSize += 1;
+    }
+
+    return stackSize;
+}
+
+#endif
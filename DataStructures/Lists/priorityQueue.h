@@ -0,0 +1,531 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <iostream>
+#include <math.h>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "../nodeAllocators.h"
+#include "../traceRecorder.h"
+
+using namespace std;
+
+//Simple single-type PriorityNode class
+template <class V>
+class PriorityNode {
+
+    public:
+        int priority;
+        V value;
+
+        PriorityNode(int priority, V value) {
+            this->priority = priority;
+            this->value = value;
+        }
+};
+
+//Linked-List Implemented PriorityQ, nodes come from the Allocator (see nodeAllocators.h) and the heap array from
+//the Allocator's resource
+template <typename V, template <class> class Allocator = HeapAllocator>
+class PriorityQ {
+
+    private:
+        Allocator<PriorityNode<V> > nodeAllocator;
+        std::pmr::vector<PriorityNode<V>*> nodes;
+        TraceRecorder* recorder = NULL;
+
+        void exchange(int firstKey, int secondKey);
+        void swim(int searchNode);
+        void sink(int searchNode);
+
+    public:
+        void clear();
+        V deleteMax();
+        void insert(int priority, V value);
+        void setRecorder(TraceRecorder* newRecorder);
+        int size();
+
+        PriorityQ(int startSize=10) : nodes(nodeAllocator.resource()) {
+            nodes.reserve(startSize);
+        }
+
+        //Takes every node and the heap array from the resource, for a queue using PmrAllocator
+        PriorityQ(std::pmr::memory_resource* resource, int startSize=10) : nodeAllocator(resource), nodes(resource) {
+            nodes.reserve(startSize);
+        }
+
+        PriorityQ(const PriorityQ&) = delete;
+        PriorityQ& operator=(const PriorityQ&) = delete;
+
+        ~PriorityQ() {
+            clear();
+        }
+};
+
+//Min-Max (double-ended) PriorityQ, with nodes stored inline in a single array taken from a memory resource.
+//Even levels (starting at the root) hold minimums of their subtrees, odd levels hold maximums.
+template <typename V>
+class MinMaxPriorityQ {
+
+    private:
+        std::pmr::vector<PriorityNode<V> > nodes;
+        TraceRecorder* recorder = NULL;
+
+        void exchange(int firstIndex, int secondIndex);
+        bool isMinLevel(int nodeIndex);
+        int maxIndex();
+        void removeAt(int nodeIndex);
+        void swim(int nodeIndex);
+        void swimMax(int nodeIndex);
+        void swimMin(int nodeIndex);
+        void sink(int nodeIndex);
+        void sinkMax(int nodeIndex);
+        void sinkMin(int nodeIndex);
+
+    public:
+        void clear();
+        V deleteMax();
+        V deleteMin();
+        void insert(int priority, V value);
+        V peekMax();
+        V peekMin();
+        void setRecorder(TraceRecorder* newRecorder);
+        int size();
+
+        MinMaxPriorityQ(int startSize=10, std::pmr::memory_resource* resource=std::pmr::get_default_resource()) : nodes(resource) {
+            nodes.reserve(startSize + 1);
+
+            //Index 0 is unused so that children of i are at 2i and 2i+1
+            nodes.push_back(PriorityNode<V>(0, V()));
+        }
+};
+
+/* Function: clear
+ * Description: This function removes all values from the queue in linear time, keeping the array's capacity.
+ * Clearing is not recorded.
+*/
+template <typename V, template <class> class Allocator>
+void PriorityQ<V,Allocator>::clear() {
+    for (size_t i = 1; i < nodes.size(); i++) {
+        nodeAllocator.destroy(nodes[i]);
+    }
+
+    nodes.clear();
+}
+
+/* Function: deleteMax
+ * Description: This function removes and returns the value pair with the highest priority (key) from the queue.
+*/
+template <typename V, template <class> class Allocator>
+V PriorityQ<V,Allocator>::deleteMax() {
+    V max = V();
+
+    if (nodes.size() > 1) {
+        max = nodes[1]->value;
+        exchange(1,nodes.size() - 1);
+        nodeAllocator.destroy(nodes.back());
+        nodes.pop_back();
+        sink(1);
+    }
+
+    if (recorder != NULL) {
+        recorder->record(TRACE_DELETE_MAX, 0, 0, size());
+    }
+    return max;
+}
+
+/* Function: exchange
+ * Description: This function exchanges two nodes in the queue by swapping their positions.
+ */
+template <typename V, template <class> class Allocator>
+void PriorityQ<V,Allocator>::exchange(int firstIndex, int secondIndex) {
+    PriorityNode<V>* swapNode = nodes[firstIndex];
+    nodes[firstIndex] = nodes[secondIndex];
+    nodes[secondIndex] = swapNode;
+}
+
+/* Function: insert
+ * Description: This function inserts a node into the queue and places it accordingly by its priority.
+ */
+template <typename V, template <class> class Allocator>
+void PriorityQ<V,Allocator>::insert(int newPriority, V newValue) {
+    PriorityNode<V>* newNode = nodeAllocator.create(newPriority, newValue);
+
+    if (nodes.size() == 0) {
+        nodes.push_back(NULL);
+        nodes.push_back(newNode);
+    }
+
+    else {
+        nodes.push_back(newNode);
+        swim(nodes.size()-1);
+    }
+
+    if (recorder != NULL) {
+        recorder->record(TRACE_INSERT, 0, newPriority, size());
+    }
+}
+
+/* Function: setRecorder
+ * Description: This function records every insert and deleteMax from now on to the recorder (see traceRecorder.h),
+ * or stops recording if it is NULL. The recorder must outlive the queue or be detached first.
+ */
+template <typename V, template <class> class Allocator>
+void PriorityQ<V,Allocator>::setRecorder(TraceRecorder* newRecorder) {
+    recorder = newRecorder;
+}
+
+/* Function: sink
+ * Description: This function sinks a node to its proper position by swapping it with one of its children.
+ * This function is used when a parent key is lower priority than one or both of its children.
+ */
+template <typename V, template <class> class Allocator>
+void PriorityQ<V,Allocator>::sink(int nodeIndex) {
+    int numNodes = nodes.size()-1;
+
+    while (2 * nodeIndex <= numNodes) {
+        int j = 2 * nodeIndex;
+
+        //If the second child > first child, the swap should be with that child
+        if (j < numNodes && nodes[j]->priority < nodes[j+1]->priority) {
+            j++;
+        }
+
+        //PriorityNode is in its proper position
+        if (nodes[nodeIndex]->priority >= nodes[j]->priority) {
+            break;
+        }
+
+        //Swap parent node with higher-priority child node
+        exchange(nodeIndex, j);
+        nodeIndex = j;
+    }
+}
+
+//Return number of nodes in the queue
+template <typename V, template <class> class Allocator>
+int PriorityQ<V,Allocator>::size() {
+    return nodes.empty() ? 0 : nodes.size()-1;
+}
+
+/* Function: swim
+ * Description: This function swims a node (up) to its proper position by swapping its parent.
+ * This function is used when a child key is higher priority than its parent.
+ */
+template <typename V, template <class> class Allocator>
+void PriorityQ<V,Allocator>::swim(int nodeIndex) {
+    while (nodeIndex > 1 && nodes[floor(nodeIndex / 2)]->priority < nodes[nodeIndex]->priority) {
+        exchange(floor(nodeIndex / 2), nodeIndex);
+        nodeIndex /= 2;
+    }
+}
+
+
+/* Function: clear
+ * Description: This function removes all values from the queue.
+*/
+template <typename V>
+void MinMaxPriorityQ<V>::clear() {
+    nodes.resize(1, PriorityNode<V>(0, V()));
+}
+
+/* Function: deleteMax
+ * Description: This function removes and returns the value pair with the highest priority (key) from the queue.
+ * The maximum is always one of the root's children, or the root itself when it has none.
+*/
+template <typename V>
+V MinMaxPriorityQ<V>::deleteMax() {
+    V max = V();
+
+    if (nodes.size() > 1) {
+        int nodeIndex = maxIndex();
+        max = nodes[nodeIndex].value;
+        removeAt(nodeIndex);
+    }
+
+    if (recorder != NULL) {
+        recorder->record(TRACE_DELETE_MAX, 0, 0, size());
+    }
+    return max;
+}
+
+/* Function: deleteMin
+ * Description: This function removes and returns the value pair with the lowest priority (key) from the queue.
+*/
+template <typename V>
+V MinMaxPriorityQ<V>::deleteMin() {
+    V min = V();
+
+    if (nodes.size() > 1) {
+        min = nodes[1].value;
+        removeAt(1);
+    }
+
+    if (recorder != NULL) {
+        recorder->record(TRACE_DELETE_MIN, 0, 0, size());
+    }
+    return min;
+}
+
+/* Function: exchange
+ * Description: This function exchanges two nodes in the queue by swapping their positions.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::exchange(int firstIndex, int secondIndex) {
+    std::swap(nodes[firstIndex], nodes[secondIndex]);
+}
+
+/* Function: insert
+ * Description: This function inserts a node into the queue and places it accordingly by its priority.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::insert(int newPriority, V newValue) {
+    nodes.push_back(PriorityNode<V>(newPriority, newValue));
+    swim(nodes.size()-1);
+
+    if (recorder != NULL) {
+        recorder->record(TRACE_INSERT, 0, newPriority, size());
+    }
+}
+
+/* Function: isMinLevel
+ * Description: This function returns whether the node index lies on a min level (even depth) of the heap.
+ */
+template <typename V>
+bool MinMaxPriorityQ<V>::isMinLevel(int nodeIndex) {
+    int depth = 0;
+
+    while (nodeIndex > 1) {
+        nodeIndex /= 2;
+        depth++;
+    }
+
+    return depth % 2 == 0;
+}
+
+/* Function: maxIndex
+ * Description: This function returns the index of the highest-priority node, which is the larger of the
+ * root's children, or the root when the queue holds a single node.
+ */
+template <typename V>
+int MinMaxPriorityQ<V>::maxIndex() {
+    int numNodes = nodes.size()-1;
+
+    if (numNodes == 1) {
+        return 1;
+    }
+
+    if (numNodes >= 3 && nodes[2].priority < nodes[3].priority) {
+        return 3;
+    }
+
+    return 2;
+}
+
+/* Function: peekMax
+ * Description: This function returns the value with the highest priority without removing it.
+ */
+template <typename V>
+V MinMaxPriorityQ<V>::peekMax() {
+    if (nodes.size() > 1) {
+        return nodes[maxIndex()].value;
+    }
+    return V();
+}
+
+/* Function: peekMin
+ * Description: This function returns the value with the lowest priority without removing it.
+ */
+template <typename V>
+V MinMaxPriorityQ<V>::peekMin() {
+    if (nodes.size() > 1) {
+        return nodes[1].value;
+    }
+    return V();
+}
+
+/* Function: removeAt
+ * Description: This function replaces the node at the passed index with the last node and sinks it into place.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::removeAt(int nodeIndex) {
+    exchange(nodeIndex, nodes.size() - 1);
+    nodes.pop_back();
+
+    if (nodeIndex < (int) nodes.size()) {
+        sink(nodeIndex);
+    }
+}
+
+/* Function: setRecorder
+ * Description: This function records every insert, deleteMax and deleteMin from now on to the recorder
+ * (see traceRecorder.h), or stops recording if it is NULL. The recorder must outlive the queue or be detached first.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::setRecorder(TraceRecorder* newRecorder) {
+    recorder = newRecorder;
+}
+
+/* Function: sink
+ * Description: This function sinks a node to its proper position using the rule for the level it sits on.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::sink(int nodeIndex) {
+    if (isMinLevel(nodeIndex)) {
+        sinkMin(nodeIndex);
+    }
+
+    else {
+        sinkMax(nodeIndex);
+    }
+}
+
+/* Function: sinkMax
+ * Description: This function sinks a node on a max level by swapping it with its highest-priority
+ * child or grandchild. Grandchild swaps may leave the node below its new parent, which is then exchanged.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::sinkMax(int nodeIndex) {
+    int numNodes = nodes.size()-1;
+
+    while (2 * nodeIndex <= numNodes) {
+        int j = 2 * nodeIndex;
+
+        //Find the highest-priority child or grandchild
+        if (j < numNodes && nodes[j].priority < nodes[j+1].priority) {
+            j++;
+        }
+
+        for (int k = 4 * nodeIndex; k <= numNodes && k <= 4 * nodeIndex + 3; k++) {
+            if (nodes[j].priority < nodes[k].priority) {
+                j = k;
+            }
+        }
+
+        //PriorityNode is in its proper position
+        if (nodes[nodeIndex].priority >= nodes[j].priority) {
+            break;
+        }
+
+        exchange(nodeIndex, j);
+
+        //Swapped with a child, which sits on a min level and has no further descendants to check
+        if (j <= 2 * nodeIndex + 1) {
+            break;
+        }
+
+        if (nodes[j].priority < nodes[j / 2].priority) {
+            exchange(j, j / 2);
+        }
+        nodeIndex = j;
+    }
+}
+
+/* Function: sinkMin
+ * Description: This function sinks a node on a min level by swapping it with its lowest-priority
+ * child or grandchild. Grandchild swaps may leave the node above its new parent, which is then exchanged.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::sinkMin(int nodeIndex) {
+    int numNodes = nodes.size()-1;
+
+    while (2 * nodeIndex <= numNodes) {
+        int j = 2 * nodeIndex;
+
+        //Find the lowest-priority child or grandchild
+        if (j < numNodes && nodes[j+1].priority < nodes[j].priority) {
+            j++;
+        }
+
+        for (int k = 4 * nodeIndex; k <= numNodes && k <= 4 * nodeIndex + 3; k++) {
+            if (nodes[k].priority < nodes[j].priority) {
+                j = k;
+            }
+        }
+
+        //PriorityNode is in its proper position
+        if (nodes[nodeIndex].priority <= nodes[j].priority) {
+            break;
+        }
+
+        exchange(nodeIndex, j);
+
+        //Swapped with a child, which sits on a max level and has no further descendants to check
+        if (j <= 2 * nodeIndex + 1) {
+            break;
+        }
+
+        if (nodes[j].priority > nodes[j / 2].priority) {
+            exchange(j, j / 2);
+        }
+        nodeIndex = j;
+    }
+}
+
+//Return number of nodes in the queue
+template <typename V>
+int MinMaxPriorityQ<V>::size() {
+    return nodes.size()-1;
+}
+
+/* Function: swim
+ * Description: This function swims a newly added node (up) to its proper position.
+ * The node is first compared against its parent to decide whether it belongs on the min or max levels,
+ * and then swims up through its grandparents on those levels.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::swim(int nodeIndex) {
+    int parentIndex = nodeIndex / 2;
+
+    if (parentIndex < 1) {
+        return;
+    }
+
+    if (isMinLevel(nodeIndex)) {
+        if (nodes[nodeIndex].priority > nodes[parentIndex].priority) {
+            exchange(nodeIndex, parentIndex);
+            swimMax(parentIndex);
+        }
+
+        else {
+            swimMin(nodeIndex);
+        }
+    }
+
+    else {
+        if (nodes[nodeIndex].priority < nodes[parentIndex].priority) {
+            exchange(nodeIndex, parentIndex);
+            swimMin(parentIndex);
+        }
+
+        else {
+            swimMax(nodeIndex);
+        }
+    }
+}
+
+/* Function: swimMax
+ * Description: This function swims a node on a max level up by swapping it with lower-priority grandparents.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::swimMax(int nodeIndex) {
+    while (nodeIndex > 3 && nodes[nodeIndex / 4].priority < nodes[nodeIndex].priority) {
+        exchange(nodeIndex / 4, nodeIndex);
+        nodeIndex /= 4;
+    }
+}
+
+/* Function: swimMin
+ * Description: This function swims a node on a min level up by swapping it with higher-priority grandparents.
+ */
+template <typename V>
+void MinMaxPriorityQ<V>::swimMin(int nodeIndex) {
+    while (nodeIndex > 3 && nodes[nodeIndex / 4].priority > nodes[nodeIndex].priority) {
+        exchange(nodeIndex / 4, nodeIndex);
+        nodeIndex /= 4;
+    }
+}
+
+#endif
@@ -0,0 +1,142 @@
+/* DESCRIPTION OF PROGRAM
+
+    Benchmarks and test driver for the lock-free SkipList (see skipList.h).
+
+    Usage: skipList [--benchmark [numKeys]]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#include "skipList.h"
+
+//BENCHMARKS
+
+/* Function: benchmarkSkipList
+ * Description: Runs the passed number of threads against a SkipList and against a std::map behind one mutex, for
+ *              several read percentages. Writes are split evenly between puts and removes so the map keeps its
+ *              size, and the throughput of each is printed.
+ *
+ * Param: int numThreads, int numKeys, int opsPerThread
+*/
+void benchmarkSkipList(int numThreads, int numKeys, int opsPerThread) {
+    int readPercents[] = {50, 90, 99};
+
+    for (int readPercent : readPercents) {
+        SkipList<int,int>* skipList = new SkipList<int,int>();
+        std::map<int,int>* lockedMap = new std::map<int,int>();
+        std::mutex mapLock;
+        std::atomic<long long> numFound{0};
+
+        for (int i = 0; i < numKeys; i += 2) {
+            skipList->put(i, i);
+            (*lockedMap)[i] = i;
+        }
+
+        for (int useSkipList = 1; useSkipList >= 0; useSkipList--) {
+            std::vector<std::thread> threads;
+            auto start = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < numThreads; i++) {
+                threads.push_back(std::thread([&, i]() {
+                    unsigned int seed = i + 1;
+                    long long found = 0;
+
+                    for (int j = 0; j < opsPerThread; j++) {
+                        seed = seed * 1103515245 + 12345;
+                        int key = (seed >> 8) % numKeys;
+                        int roll = (seed >> 4) % 100;
+
+                        if (useSkipList && roll < readPercent) {
+                            found += skipList->contains(key);
+                        }
+
+                        else if (useSkipList && j % 2 == 0) {
+                            skipList->put(key, j);
+                        }
+
+                        else if (useSkipList) {
+                            skipList->remove(key);
+                        }
+
+                        else {
+                            std::lock_guard<std::mutex> guard(mapLock);
+
+                            if (roll < readPercent) {
+                                found += lockedMap->count(key);
+                            }
+
+                            else if (j % 2 == 0) {
+                                (*lockedMap)[key] = j;
+                            }
+
+                            else {
+                                lockedMap->erase(key);
+                            }
+                        }
+                    }
+
+                    numFound.fetch_add(found);
+                }));
+            }
+
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            cout << numThreads << " threads, " << readPercent << "% reads, " << (useSkipList ? "SkipList: " : "mutex std::map: ")
+                 << (long long) (numThreads * (double) opsPerThread / seconds) << " ops/s" << endl;
+        }
+
+        cout << "  (" << numFound.load() << " reads found their key)" << endl;
+
+        delete skipList;
+        delete lockedMap;
+    }
+}
+
+//Runs the SkipList benchmark on one thread and on doubling thread counts up to the number of hardware threads
+void runBenchmarks(int numKeys) {
+    int maxThreads = std::max(1, (int) std::thread::hardware_concurrency());
+
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        benchmarkSkipList(numThreads, numKeys, numKeys);
+    }
+}
+
+//Driver for testing
+int main(int argc, char** argv) {
+
+    //Benchmarks (run with --benchmark [numKeys])
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "--benchmark") != 0 || argc > 3) {
+            cout << "Usage: " << argv[0] << " [--benchmark [numKeys]]" << endl;
+            return 1;
+        }
+
+        runBenchmarks(argc == 3 ? std::max(1000, atoi(argv[2])) : 1000000);
+        return 0;
+    }
+
+    // SkipList<int,int>* testList = new SkipList<int,int>();
+
+    // testList->put(1, 10);
+    // testList->put(3, 30);
+    // testList->put(11, 110);
+    // testList->put(8, 80);
+    // testList->put(26, 260);
+    // testList->put(18, 180);
+    // testList->remove(11);
+
+    // cout << testList->get(8) << " " << testList->contains(11) << " " << testList->size() << endl;
+    // testList->forEach([](int key, int value) { cout << key << " " << value << endl; });
+    // testList->rangeScan(2, 20, [](int key, int value) { cout << key << " " << value << endl; });
+    // delete testList;
+}
@@ -0,0 +1,722 @@
+/* DESCRIPTION OF FILE
+
+    This file implements a lock-free skip list ordered map, for workloads where many threads put, get and remove
+    keys at once. Code was written by myself, but follows the lock-free skip list from Herlihy and Shavit's
+    "The Art of Multiprocessor Programming" (chapter 14), with the epoch-based reclamation described here:
+    https://www.cl.cam.ac.uk/techreports/UCAM-CL-TR-579.pdf
+
+    Each key is stored in a tower holding one next link per level. Towers are linked into each level with a single
+    compare-and-swap, lowest level first, so an insert never rebalances anything beyond its own tower. A key is
+    removed by setting the low bit (the mark) of each of its tower's links, highest level first, and the key leaves
+    the map once its level 0 link is marked. Any thread that walks past a marked link unlinks the tower from that level.
+
+    Towers are carved from per-thread pools sorted by height. A removed tower goes back to a pool only once every
+    thread that could still be reading it has finished its operation, which each thread announces by publishing the
+    global epoch it started in. Values are swapped in place when a key is put again, so they must be trivially copyable.
+*/
+
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+const int SKIP_MAX_LEVEL = 16;
+const int SKIP_MAX_THREADS = 128;
+
+//Number of retired towers a thread gathers between attempts to move the global epoch forward
+const int SKIP_RETIRES_PER_ADVANCE = 64;
+
+const size_t SKIP_CHUNK_BYTES = 64 * 1024;
+
+//Gives every SkipList an id that is never reused, so threads can tell their registrations apart
+inline std::atomic<uint64_t> nextSkipListId{1};
+
+//NODE CLASSES
+
+//Tower for one key. Its next links are stored directly after it in the same allocation, one per level,
+//with the low bit of a link marking the tower as removed from that level.
+template <class K, class V>
+class SkipNode {
+
+    public:
+        K key;
+        std::atomic<V> value;
+
+        //Insert and remove both hold the tower, and whichever finishes with it last retires it
+        std::atomic<int> owners;
+        int height;
+
+        //Link in a thread's free or retired list, never read by other threads
+        SkipNode<K,V>* nextFree;
+
+        SkipNode(const K& key, V value, int height) : key(key), value(value), owners(2), height(height), nextFree(NULL) {}
+
+        std::atomic<uintptr_t>* links() {
+            return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1);
+        }
+};
+
+//State kept by each thread using a SkipList: its announced epoch, its retired towers and its tower pools
+template <class K, class V>
+class alignas(64) SkipThread {
+
+    public:
+        //0 while the thread is outside an operation, otherwise its epoch * 2 + 1
+        std::atomic<uint64_t> announced{0};
+        std::atomic<bool> claimed{false};
+        int guardDepth = 0;
+
+        //Towers retired in each of the last three epochs, tagged with the epoch they were retired in
+        SkipNode<K,V>* limbo[3] = {NULL, NULL, NULL};
+        uint64_t limboEpoch[3] = {0, 0, 0};
+        int numRetired = 0;
+
+        //Free towers by height, and the chunk new towers are carved from
+        SkipNode<K,V>* freeTowers[SKIP_MAX_LEVEL + 1] = {};
+        char* chunk = NULL;
+        size_t chunkLeft = 0;
+        std::vector<char*> chunks;
+
+        uint32_t seed = 0;
+};
+
+//Shared by a SkipList and every thread registered with it, so that a thread exiting after the list is destroyed
+//knows not to touch its record
+class SkipListLife {
+
+    public:
+        std::mutex lock;
+        std::atomic<bool> alive{true};
+};
+
+//One list a thread has claimed a record in
+template <class K, class V>
+class SkipRegistration {
+
+    public:
+        uint64_t listId;
+        SkipThread<K,V>* record;
+        std::shared_ptr<SkipListLife> life;
+};
+
+//A thread's registrations with every SkipList<K,V> it has used. When the thread exits, each record whose list is
+//still alive is released for another thread to claim, keeping its pools and retired towers. Its retired towers are
+//freed by whichever thread claims it next, once their epoch slot comes round again.
+template <class K, class V>
+class SkipRegistrations {
+
+    public:
+        std::vector<SkipRegistration<K,V> > entries;
+
+        ~SkipRegistrations() {
+            for (SkipRegistration<K,V>& entry : entries) {
+                std::lock_guard<std::mutex> guard(entry.life->lock);
+
+                if (entry.life->alive.load()) {
+                    entry.record->claimed.store(false);
+                }
+            }
+        }
+};
+
+//Announces that the thread is reading the list for as long as the guard lives.
+//Guards may nest, for callbacks that use the list again.
+template <class K, class V>
+class EpochGuard {
+
+    private:
+        SkipThread<K,V>* thread;
+
+    public:
+        EpochGuard(SkipThread<K,V>* thread, std::atomic<uint64_t>& globalEpoch) : thread(thread) {
+            if (thread->guardDepth++ == 0) {
+                thread->announced.store(globalEpoch.load() * 2 + 1);
+            }
+        }
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+
+        ~EpochGuard() {
+            if (--thread->guardDepth == 0) {
+                thread->announced.store(0, std::memory_order_release);
+            }
+        }
+};
+
+//SKIP LIST
+
+//SkipList class to store key-value pairs in a lock-free skip list, ordered by key.
+//Every function may be called from any number of threads at once. Scans are weakly consistent: they see each
+//key that stays in the map for the whole scan, and may or may not see keys put or removed while they run.
+template <typename K, typename V>
+class SkipList {
+    static_assert(std::is_trivially_copyable<V>::value, "SkipList values are stored in a std::atomic");
+
+    private:
+        std::atomic<uintptr_t> headLinks[SKIP_MAX_LEVEL];
+        std::atomic<uint64_t> globalEpoch{1};
+        std::atomic<long long> numKeys{0};
+        SkipThread<K,V> threads[SKIP_MAX_THREADS];
+        uint64_t listId;
+        std::shared_ptr<SkipListLife> life;
+
+        SkipNode<K,V>* allocTower(SkipThread<K,V>* self, const K& newKey, V newValue, int height);
+        bool find(const K& searchKey, std::atomic<uintptr_t>** preds, SkipNode<K,V>** succs);
+        SkipNode<K,V>* findTower(const K& searchKey);
+        void freeTower(SkipThread<K,V>* self, SkipNode<K,V>* tower);
+        void freeTowers(SkipThread<K,V>* self, SkipNode<K,V>* towers);
+        int randomHeight(SkipThread<K,V>* self);
+        void release(SkipThread<K,V>* self, SkipNode<K,V>* tower);
+        void retire(SkipThread<K,V>* self, SkipNode<K,V>* tower);
+        SkipThread<K,V>* thread();
+        void tryAdvanceEpoch();
+
+        static bool isMarked(uintptr_t link) {
+            return (link & 1) != 0;
+        }
+
+        static SkipNode<K,V>* towerOf(uintptr_t link) {
+            return (SkipNode<K,V>*) (link & ~(uintptr_t) 1);
+        }
+
+    public:
+        bool contains(const K& searchKey);
+        template <typename Callback>
+        void forEach(Callback callback);
+        V get(const K& searchKey);
+        void put(const K& newKey, V newValue);
+        template <typename Callback>
+        void rangeScan(const K& lowKey, const K& highKey, Callback callback);
+        void remove(const K& searchKey);
+        int size();
+
+        SkipList() : life(std::make_shared<SkipListLife>()) {
+            listId = nextSkipListId.fetch_add(1);
+
+            for (int i = 0; i < SKIP_MAX_LEVEL; i++) {
+                headLinks[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        SkipList(const SkipList&) = delete;
+        SkipList& operator=(const SkipList&) = delete;
+
+        //Must only run once no other thread is using the list
+        ~SkipList() {
+            {
+                std::lock_guard<std::mutex> guard(life->lock);
+                life->alive.store(false);
+            }
+
+            SkipNode<K,V>* tower = towerOf(headLinks[0].load());
+
+            while (tower != NULL) {
+                SkipNode<K,V>* nextTower = towerOf(tower->links()[0].load());
+                tower->~SkipNode();
+                tower = nextTower;
+            }
+
+            for (SkipThread<K,V>& record : threads) {
+                for (int i = 0; i < 3; i++) {
+                    for (SkipNode<K,V>* retired = record.limbo[i]; retired != NULL; ) {
+                        SkipNode<K,V>* nextRetired = retired->nextFree;
+                        retired->~SkipNode();
+                        retired = nextRetired;
+                    }
+                }
+            }
+
+            //Towers retired by one thread may sit in another thread's chunks, so chunks go last
+            for (SkipThread<K,V>& record : threads) {
+                for (char* chunk : record.chunks) {
+                    delete[] chunk;
+                }
+            }
+        }
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: allocTower
+ * Description: Builds a tower of the given height from the thread's pool, carving a new one from its chunk
+ *              if no free tower of that height is left.
+ *
+ * Param: SkipThread<K,V>* self, const K& newKey, V newValue, int height
+*/
+template <typename K, typename V>
+SkipNode<K,V>* SkipList<K,V>::allocTower(SkipThread<K,V>* self, const K& newKey, V newValue, int height) {
+    void* memory = self->freeTowers[height];
+
+    if (memory != NULL) {
+        self->freeTowers[height] = self->freeTowers[height]->nextFree;
+    }
+
+    else {
+        size_t numBytes = sizeof(SkipNode<K,V>) + height * sizeof(std::atomic<uintptr_t>);
+        numBytes = (numBytes + alignof(SkipNode<K,V>) - 1) / alignof(SkipNode<K,V>) * alignof(SkipNode<K,V>);
+
+        if (self->chunkLeft < numBytes) {
+            self->chunk = new char[SKIP_CHUNK_BYTES];
+            self->chunkLeft = SKIP_CHUNK_BYTES;
+            self->chunks.push_back(self->chunk);
+        }
+
+        memory = self->chunk;
+        self->chunk += numBytes;
+        self->chunkLeft -= numBytes;
+    }
+
+    SkipNode<K,V>* tower = new (memory) SkipNode<K,V>(newKey, newValue, height);
+
+    for (int i = 0; i < height; i++) {
+        new (&tower->links()[i]) std::atomic<uintptr_t>(0);
+    }
+
+    return tower;
+}
+
+/* Function: find
+ * Description: Fills preds with the links leading to the key on every level and succs with the towers they point to,
+ *              the first on each level whose key is not less than the search key. Marked towers passed on the way
+ *              are unlinked, starting over from the head if another thread changed a link first.
+ *              Returns whether an unmarked tower holding the key was found.
+ *
+ * Param: const K& searchKey, std::atomic<uintptr_t>** preds, SkipNode<K,V>** succs
+*/
+template <typename K, typename V>
+bool SkipList<K,V>::find(const K& searchKey, std::atomic<uintptr_t>** preds, SkipNode<K,V>** succs) {
+
+    retry:
+    std::atomic<uintptr_t>* predLinks = headLinks;
+    SkipNode<K,V>* curr = NULL;
+
+    for (int level = SKIP_MAX_LEVEL - 1; level >= 0; level--) {
+        curr = towerOf(predLinks[level].load(std::memory_order_acquire));
+
+        while (curr != NULL) {
+            uintptr_t succLink = curr->links()[level].load(std::memory_order_acquire);
+
+            //Tower is being removed, so unlink it from this level
+            if (isMarked(succLink)) {
+                uintptr_t expected = (uintptr_t) curr;
+
+                if (!predLinks[level].compare_exchange_strong(expected, succLink & ~(uintptr_t) 1, std::memory_order_acq_rel)) {
+                    goto retry;
+                }
+
+                curr = towerOf(succLink);
+                continue;
+            }
+
+            if (!(curr->key < searchKey)) {
+                break;
+            }
+
+            predLinks = curr->links();
+            curr = towerOf(succLink);
+        }
+
+        preds[level] = &predLinks[level];
+        succs[level] = curr;
+    }
+
+    return curr != NULL && !(searchKey < curr->key);
+}
+
+/* Function: findTower
+ * Description: Returns the unmarked tower holding the key, or NULL. Unlike find, marked towers are stepped over
+ *              rather than unlinked, so lookups never write to the list.
+ *
+ * Param: const K& searchKey
+*/
+template <typename K, typename V>
+SkipNode<K,V>* SkipList<K,V>::findTower(const K& searchKey) {
+    std::atomic<uintptr_t>* predLinks = headLinks;
+    SkipNode<K,V>* curr = NULL;
+
+    for (int level = SKIP_MAX_LEVEL - 1; level >= 0; level--) {
+        curr = towerOf(predLinks[level].load(std::memory_order_acquire));
+
+        while (curr != NULL) {
+            uintptr_t succLink = curr->links()[level].load(std::memory_order_acquire);
+
+            if (!isMarked(succLink) && !(curr->key < searchKey)) {
+                break;
+            }
+
+            if (!isMarked(succLink)) {
+                predLinks = curr->links();
+            }
+
+            curr = towerOf(succLink);
+        }
+    }
+
+    return curr != NULL && !(searchKey < curr->key) ? curr : NULL;
+}
+
+//Returns a tower that no other thread can reach to the thread's pool
+template <typename K, typename V>
+void SkipList<K,V>::freeTower(SkipThread<K,V>* self, SkipNode<K,V>* tower) {
+    int height = tower->height;
+
+    tower->key.~K();
+    tower->nextFree = self->freeTowers[height];
+    self->freeTowers[height] = tower;
+}
+
+//Returns a list of retired towers to the thread's pool
+template <typename K, typename V>
+void SkipList<K,V>::freeTowers(SkipThread<K,V>* self, SkipNode<K,V>* towers) {
+    while (towers != NULL) {
+        SkipNode<K,V>* nextTower = towers->nextFree;
+        freeTower(self, towers);
+        towers = nextTower;
+    }
+}
+
+//Returns a height from 1 to SKIP_MAX_LEVEL, each level above the first being reached with probability 1/4
+template <typename K, typename V>
+int SkipList<K,V>::randomHeight(SkipThread<K,V>* self) {
+    uint32_t bits;
+    int height = 1;
+
+    self->seed ^= self->seed << 13;
+    self->seed ^= self->seed >> 17;
+    self->seed ^= self->seed << 5;
+    bits = self->seed;
+
+    while ((bits & 3) == 0 && height < SKIP_MAX_LEVEL) {
+        bits >>= 2;
+        height++;
+    }
+
+    return height;
+}
+
+/* Function: release
+ * Description: Drops the calling operation's hold on the tower, retiring it if the tower's insert and remove
+ *              have both finished. Both run find after their last change, so by then the tower is on no level.
+ *
+ * Param: SkipThread<K,V>* self, SkipNode<K,V>* tower
+*/
+template <typename K, typename V>
+void SkipList<K,V>::release(SkipThread<K,V>* self, SkipNode<K,V>* tower) {
+    if (tower->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        retire(self, tower);
+    }
+}
+
+/* Function: retire
+ * Description: Holds an unlinked tower until no thread can still be reading it. Towers are kept in three lists by
+ *              the epoch they were retired in, and a list is freed when its slot comes round again three epochs
+ *              later, since by then every thread has started a new operation after the towers were unlinked.
+ *
+ * Param: SkipThread<K,V>* self, SkipNode<K,V>* tower
+*/
+template <typename K, typename V>
+void SkipList<K,V>::retire(SkipThread<K,V>* self, SkipNode<K,V>* tower) {
+    uint64_t epoch = globalEpoch.load();
+    int slot = epoch % 3;
+
+    if (self->limboEpoch[slot] != epoch) {
+        freeTowers(self, self->limbo[slot]);
+        self->limbo[slot] = NULL;
+        self->limboEpoch[slot] = epoch;
+    }
+
+    tower->nextFree = self->limbo[slot];
+    self->limbo[slot] = tower;
+
+    if (++self->numRetired % SKIP_RETIRES_PER_ADVANCE == 0) {
+        tryAdvanceEpoch();
+    }
+}
+
+/* Function: thread
+ * Description: Returns the calling thread's record for this list, claiming a free one the first time the thread
+ *              uses the list. Records stay claimed until the thread exits, so at most SKIP_MAX_THREADS threads may
+ *              use the list at once. Registrations with destroyed lists are dropped when a new one is made.
+*/
+template <typename K, typename V>
+SkipThread<K,V>* SkipList<K,V>::thread() {
+    thread_local uint64_t cachedListId = 0;
+    thread_local SkipThread<K,V>* cachedThread = NULL;
+    thread_local SkipRegistrations<K,V> registrations;
+
+    if (cachedListId == listId) {
+        return cachedThread;
+    }
+
+    cachedListId = listId;
+    cachedThread = NULL;
+
+    for (SkipRegistration<K,V>& registration : registrations.entries) {
+        if (registration.listId == listId) {
+            cachedThread = registration.record;
+            return cachedThread;
+        }
+    }
+
+    for (size_t i = 0; i < registrations.entries.size(); ) {
+        if (!registrations.entries[i].life->alive.load()) {
+            registrations.entries[i] = registrations.entries.back();
+            registrations.entries.pop_back();
+        }
+
+        else {
+            i++;
+        }
+    }
+
+    for (int i = 0; i < SKIP_MAX_THREADS && cachedThread == NULL; i++) {
+        if (!threads[i].claimed.exchange(true)) {
+            cachedThread = &threads[i];
+            cachedThread->seed = 2654435761u * (i + 1);
+        }
+    }
+
+    if (cachedThread == NULL) {
+        cout << "Err: More than " << SKIP_MAX_THREADS << " threads used one SkipList at once.\n";
+        exit(1);
+    }
+
+    registrations.entries.push_back(SkipRegistration<K,V>{listId, cachedThread, life});
+    return cachedThread;
+}
+
+//Moves the global epoch forward if every thread inside an operation has announced the current one
+template <typename K, typename V>
+void SkipList<K,V>::tryAdvanceEpoch() {
+    uint64_t epoch = globalEpoch.load();
+
+    for (SkipThread<K,V>& record : threads) {
+        uint64_t announced = record.announced.load();
+
+        if (announced != 0 && announced != epoch * 2 + 1) {
+            return;
+        }
+    }
+
+    globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+//PUBLIC FUNCTIONS
+
+//Returns whether or not the key appears in the list
+template <typename K, typename V>
+bool SkipList<K,V>::contains(const K& searchKey) {
+    EpochGuard<K,V> guard(thread(), globalEpoch);
+
+    return findTower(searchKey) != NULL;
+}
+
+/* Function: forEach
+ * Description: Calls callback(key, value) on every key in ascending order.
+ *
+ * Param: Callback callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void SkipList<K,V>::forEach(Callback callback) {
+    EpochGuard<K,V> guard(thread(), globalEpoch);
+    SkipNode<K,V>* tower = towerOf(headLinks[0].load(std::memory_order_acquire));
+
+    while (tower != NULL) {
+        uintptr_t nextLink = tower->links()[0].load(std::memory_order_acquire);
+
+        if (!isMarked(nextLink)) {
+            callback(tower->key, tower->value.load(std::memory_order_acquire));
+        }
+
+        tower = towerOf(nextLink);
+    }
+}
+
+//Returns the value of the key, or V() if the key is not in the list
+template <typename K, typename V>
+V SkipList<K,V>::get(const K& searchKey) {
+    EpochGuard<K,V> guard(thread(), globalEpoch);
+    SkipNode<K,V>* tower = findTower(searchKey);
+
+    return tower != NULL ? tower->value.load(std::memory_order_acquire) : V();
+}
+
+/* Function: put
+ * Description: Sets the key's value, or links a new tower for it. The tower is linked into level 0 first, which
+ *              adds the key to the map, then into each level above. If the tower is removed while its upper
+ *              levels are still being linked, the insert stops and runs find to unlink whatever it had linked.
+ *
+ * Param: const K& newKey, V newValue
+*/
+template <typename K, typename V>
+void SkipList<K,V>::put(const K& newKey, V newValue) {
+    SkipThread<K,V>* self = thread();
+    EpochGuard<K,V> guard(self, globalEpoch);
+    std::atomic<uintptr_t>* preds[SKIP_MAX_LEVEL];
+    SkipNode<K,V>* succs[SKIP_MAX_LEVEL];
+    SkipNode<K,V>* tower = NULL;
+    int height = randomHeight(self);
+
+    while (true) {
+        if (find(newKey, preds, succs)) {
+            succs[0]->value.store(newValue, std::memory_order_release);
+
+            //Tower was never linked, so no other thread has seen it
+            if (tower != NULL) {
+                freeTower(self, tower);
+            }
+
+            return;
+        }
+
+        if (tower == NULL) {
+            tower = allocTower(self, newKey, newValue, height);
+        }
+
+        for (int level = 0; level < height; level++) {
+            tower->links()[level].store((uintptr_t) succs[level], std::memory_order_relaxed);
+        }
+
+        uintptr_t expected = (uintptr_t) succs[0];
+
+        if (preds[0]->compare_exchange_strong(expected, (uintptr_t) tower, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    numKeys.fetch_add(1, std::memory_order_relaxed);
+
+    for (int level = 1; level < height; level++) {
+        while (true) {
+            uintptr_t link = tower->links()[level].load(std::memory_order_acquire);
+
+            //Link only fails to update once a remove has marked it
+            if (isMarked(link)) {
+                goto linked;
+            }
+
+            if (towerOf(link) != succs[level] &&
+                !tower->links()[level].compare_exchange_strong(link, (uintptr_t) succs[level], std::memory_order_acq_rel)) {
+                goto linked;
+            }
+
+            uintptr_t expected = (uintptr_t) succs[level];
+
+            if (preds[level]->compare_exchange_strong(expected, (uintptr_t) tower, std::memory_order_acq_rel)) {
+                break;
+            }
+
+            //Level changed under the insert, or the tower was removed from level 0 and must not be linked further
+            find(newKey, preds, succs);
+
+            if (succs[0] != tower) {
+                goto linked;
+            }
+        }
+    }
+
+    linked:
+    if (isMarked(tower->links()[0].load(std::memory_order_acquire))) {
+        find(newKey, preds, succs);
+    }
+
+    release(self, tower);
+}
+
+/* Function: rangeScan
+ * Description: Calls callback(key, value) on every key from lowKey to highKey (inclusive) in ascending order.
+ *
+ * Param: const K& lowKey, const K& highKey, Callback callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void SkipList<K,V>::rangeScan(const K& lowKey, const K& highKey, Callback callback) {
+    EpochGuard<K,V> guard(thread(), globalEpoch);
+    std::atomic<uintptr_t>* predLinks = headLinks;
+    SkipNode<K,V>* tower = NULL;
+
+    //Descend to the first tower at or above lowKey, without unlinking anything
+    for (int level = SKIP_MAX_LEVEL - 1; level >= 0; level--) {
+        tower = towerOf(predLinks[level].load(std::memory_order_acquire));
+
+        while (tower != NULL && tower->key < lowKey) {
+            uintptr_t nextLink = tower->links()[level].load(std::memory_order_acquire);
+
+            if (!isMarked(nextLink)) {
+                predLinks = tower->links();
+            }
+
+            tower = towerOf(nextLink);
+        }
+    }
+
+    while (tower != NULL && !(highKey < tower->key)) {
+        uintptr_t nextLink = tower->links()[0].load(std::memory_order_acquire);
+
+        if (!isMarked(nextLink)) {
+            callback(tower->key, tower->value.load(std::memory_order_acquire));
+        }
+
+        tower = towerOf(nextLink);
+    }
+}
+
+/* Function: remove
+ * Description: Removes the key if it is present. The tower's links are marked from the top level down, and the
+ *              remove that marks level 0 takes the key out of the map, then runs find to unlink the tower everywhere.
+ *
+ * Param: const K& searchKey
+*/
+template <typename K, typename V>
+void SkipList<K,V>::remove(const K& searchKey) {
+    SkipThread<K,V>* self = thread();
+    EpochGuard<K,V> guard(self, globalEpoch);
+    std::atomic<uintptr_t>* preds[SKIP_MAX_LEVEL];
+    SkipNode<K,V>* succs[SKIP_MAX_LEVEL];
+
+    if (!find(searchKey, preds, succs)) {
+        return;
+    }
+
+    SkipNode<K,V>* tower = succs[0];
+
+    for (int level = tower->height - 1; level > 0; level--) {
+        uintptr_t link = tower->links()[level].load(std::memory_order_acquire);
+
+        while (!isMarked(link) && !tower->links()[level].compare_exchange_weak(link, link | 1, std::memory_order_acq_rel)) {}
+    }
+
+    uintptr_t link = tower->links()[0].load(std::memory_order_acquire);
+
+    while (!isMarked(link)) {
+        if (tower->links()[0].compare_exchange_weak(link, link | 1, std::memory_order_acq_rel)) {
+            numKeys.fetch_sub(1, std::memory_order_relaxed);
+            find(searchKey, preds, succs);
+            release(self, tower);
+            return;
+        }
+    }
+
+    //Another thread removed the key first
+}
+
+//Return number of keys in the list
+template <typename K, typename V>
+int SkipList<K,V>::size() {
+    return (int) numKeys.load(std::memory_order_relaxed);
+}
+
+#endif
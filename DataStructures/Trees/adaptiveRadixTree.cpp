@@ -0,0 +1,150 @@
+/* DESCRIPTION OF PROGRAM
+
+    Benchmarks and test driver for the AdaptiveRadixTree (see adaptiveRadixTree.h), compared against the RedBlack
+    tree (see redBlackTree.h) and std::map.
+
+    Usage: adaptiveRadixTree [--benchmark [numKeys]]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+
+#include "adaptiveRadixTree.h"
+#include "redBlackTree.h"
+
+//BENCHMARKS
+
+/* Function: benchmarkKeys
+ * Description: Times inserts, lookups and a full ordered scan of the keys in an AdaptiveRadixTree against a RedBlack
+ *              tree and std::map.
+ *
+ * Param: string name, std::vector<K>& keys
+*/
+template <typename K>
+void benchmarkKeys(string name, std::vector<K>& keys) {
+    AdaptiveRadixTree<K,uint64_t>* tree = new AdaptiveRadixTree<K,uint64_t>();
+    RedBlack<K,uint64_t>* redBlack = new RedBlack<K,uint64_t>();
+    std::map<K,uint64_t>* stdMap = new std::map<K,uint64_t>();
+    uint64_t checksum = 0;
+    int numKeys = keys.size();
+    K lowKey = *std::min_element(keys.begin(), keys.end());
+    K highKey = *std::max_element(keys.begin(), keys.end());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numKeys; i++) {
+        tree->put(keys[i], i);
+    }
+    auto treePut = std::chrono::steady_clock::now();
+    for (K& key : keys) {
+        checksum += tree->get(key);
+    }
+    auto treeGet = std::chrono::steady_clock::now();
+    tree->rangeScan(lowKey, highKey, [&](const K& key, uint64_t value) { checksum += value; });
+    auto treeScan = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < numKeys; i++) {
+        redBlack->put(keys[i], i);
+    }
+    auto redBlackPut = std::chrono::steady_clock::now();
+    for (K& key : keys) {
+        checksum += redBlack->get(key);
+    }
+    auto redBlackGet = std::chrono::steady_clock::now();
+    redBlack->rangeScan(lowKey, highKey, [&](const K& key, uint64_t value) { checksum += value; });
+    auto redBlackScan = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < numKeys; i++) {
+        (*stdMap)[keys[i]] = i;
+    }
+    auto mapPut = std::chrono::steady_clock::now();
+    for (K& key : keys) {
+        checksum += stdMap->find(key)->second;
+    }
+    auto mapGet = std::chrono::steady_clock::now();
+    for (auto& entry : *stdMap) {
+        checksum += entry.second;
+    }
+    auto mapScan = std::chrono::steady_clock::now();
+
+    cout << name << ", " << numKeys << " keys (checksum " << checksum << ")" << endl;
+    cout << "  AdaptiveRadixTree: put " << std::chrono::duration<double, std::nano>(treePut - start).count() / numKeys
+         << " ns/op, get " << std::chrono::duration<double, std::nano>(treeGet - treePut).count() / numKeys
+         << " ns/op, scan " << std::chrono::duration<double, std::nano>(treeScan - treeGet).count() / numKeys << " ns/op" << endl;
+    cout << "  RedBlack:          put " << std::chrono::duration<double, std::nano>(redBlackPut - treeScan).count() / numKeys
+         << " ns/op, get " << std::chrono::duration<double, std::nano>(redBlackGet - redBlackPut).count() / numKeys
+         << " ns/op, scan " << std::chrono::duration<double, std::nano>(redBlackScan - redBlackGet).count() / numKeys << " ns/op" << endl;
+    cout << "  std::map:          put " << std::chrono::duration<double, std::nano>(mapPut - redBlackScan).count() / numKeys
+         << " ns/op, get " << std::chrono::duration<double, std::nano>(mapGet - mapPut).count() / numKeys
+         << " ns/op, scan " << std::chrono::duration<double, std::nano>(mapScan - mapGet).count() / numKeys << " ns/op" << endl;
+
+    delete tree;
+    delete redBlack;
+    delete stdMap;
+}
+
+/* Function: runBenchmarks
+ * Description: Runs the benchmark on dense integer keys (0..n-1, shuffled), sparse random 64-bit keys,
+ *              and short string keys.
+ *
+ * Param: int numKeys
+*/
+void runBenchmarks(int numKeys) {
+    std::vector<uint64_t> denseKeys(numKeys);
+    std::vector<uint64_t> sparseKeys(numKeys);
+    std::vector<string> stringKeys(numKeys);
+
+    for (int i = 0; i < numKeys; i++) {
+        denseKeys[i] = i;
+        sparseKeys[i] = ((uint64_t) rand() << 42) ^ ((uint64_t) rand() << 21) ^ rand();
+    }
+
+    for (int i = numKeys - 1; i > 0; i--) {
+        std::swap(denseKeys[i], denseKeys[rand() % (i + 1)]);
+    }
+
+    for (int i = 0; i < numKeys; i++) {
+        stringKeys[i] = "user:" + std::to_string(sparseKeys[i] % 100000000000ULL);
+    }
+
+    benchmarkKeys("Dense uint64_t", denseKeys);
+    benchmarkKeys("Sparse uint64_t", sparseKeys);
+    benchmarkKeys("String", stringKeys);
+}
+
+//Driver for testing
+int main(int argc, char** argv) {
+
+    //Benchmarks (run with --benchmark [numKeys])
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "--benchmark") != 0 || argc > 3) {
+            cout << "Usage: " << argv[0] << " [--benchmark [numKeys]]" << endl;
+            return 1;
+        }
+
+        runBenchmarks(argc == 3 ? std::max(1000, atoi(argv[2])) : 1000000);
+        return 0;
+    }
+
+    // AdaptiveRadixTree<string,int>* testTree = new AdaptiveRadixTree<string,int>();
+
+    // testTree->put("Alpha", 1);
+    // testTree->put("Charlie", 3);
+    // testTree->put("Frank", 6);
+    // testTree->put("Echo", 5);
+    // testTree->put("Hotel", 8);
+    // testTree->put("Kilo", 11);
+    // testTree->put("Zulu", 26);
+
+    // testTree->printInorder();
+    // cout << testTree->min() << " " << testTree->max() << " " << testTree->get("Echo") << endl;
+
+    // testTree->rangeScan("B", "I", [](string key, int value) { cout << key << " " << value << endl; });
+
+    // testTree->remove("Frank");
+    // testTree->remove("Alpha");
+    // delete testTree;
+}
@@ -0,0 +1,1007 @@
+/* DESCRIPTION OF FILE
+
+    This file implements an adaptive radix tree (ART) ordered map with the same interface as the RedBlack tree,
+    for integer and string keys. Code was written by myself, but follows the design described here:
+    https://db.in.tum.de/~leis/papers/ART.pdf
+
+    Keys are turned into bytes that sort in the same order as the keys (big-endian integers with the sign bit
+    flipped, strings with their terminating NUL), and the tree branches on one byte per level. Inner nodes grow
+    and shrink between four sizes (Node4, Node16, Node48 and Node256) with the number of children, and chains of
+    single-child nodes are compressed into a prefix stored in the node below them. Strings must not contain NULs.
+*/
+
+#ifndef ADAPTIVE_RADIX_TREE_H
+#define ADAPTIVE_RADIX_TREE_H
+
+#include <algorithm>
+#include <iostream>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+//KEY ENCODING
+
+//Bytes of a key, in an order where comparing bytes left to right matches comparing the keys
+class RadixKeyBytes {
+
+    public:
+        unsigned char inlineBytes[8];
+        const unsigned char* bytes;
+        int length;
+};
+
+/* Function: encodeKey
+ * Description: Writes an integer key big-endian, with the sign bit flipped for signed types so negatives sort first.
+ *
+ * Param: K key, RadixKeyBytes& keyBytes
+*/
+template <class K>
+typename std::enable_if<std::is_integral<K>::value>::type encodeKey(K key, RadixKeyBytes& keyBytes) {
+    typedef typename std::make_unsigned<K>::type UnsignedK;
+    UnsignedK bits = (UnsignedK) key;
+
+    if (std::is_signed<K>::value) {
+        bits ^= (UnsignedK) 1 << (8 * sizeof(K) - 1);
+    }
+
+    for (int i = 0; i < (int) sizeof(K); i++) {
+        keyBytes.inlineBytes[i] = (unsigned char) (bits >> (8 * (sizeof(K) - 1 - i)));
+    }
+
+    keyBytes.bytes = keyBytes.inlineBytes;
+    keyBytes.length = sizeof(K);
+}
+
+//Uses the string's own characters, including the terminating NUL so that no key is a prefix of another
+inline void encodeKey(const std::string& key, RadixKeyBytes& keyBytes) {
+    keyBytes.bytes = (const unsigned char*) key.c_str();
+    keyBytes.length = key.size() + 1;
+}
+
+//NODE CLASSES
+
+//Compressed path bytes stored in a node. Longer prefixes keep their length but only the first
+//MAX_PREFIX bytes; the rest are read back from a leaf below the node when needed.
+const int MAX_PREFIX = 8;
+
+const uint8_t ART_LEAF = 0;
+const uint8_t ART_NODE4 = 1;
+const uint8_t ART_NODE16 = 2;
+const uint8_t ART_NODE48 = 3;
+const uint8_t ART_NODE256 = 4;
+
+//Header shared by every node type
+class ArtNode {
+
+    public:
+        uint8_t type;
+        uint16_t numChildren;
+        uint32_t prefixLength;
+        unsigned char prefix[MAX_PREFIX];
+
+        ArtNode(uint8_t type) {
+            this->type = type;
+            numChildren = 0;
+            prefixLength = 0;
+        }
+};
+
+//Up to 4 children, with their key bytes in sorted order
+class ArtNode4 : public ArtNode {
+
+    public:
+        unsigned char keys[4];
+        ArtNode* children[4];
+
+        ArtNode4() : ArtNode(ART_NODE4) {}
+};
+
+//Up to 16 children, with their key bytes in sorted order and searched 16 at a time with SSE2
+class ArtNode16 : public ArtNode {
+
+    public:
+        unsigned char keys[16];
+        ArtNode* children[16];
+
+        ArtNode16() : ArtNode(ART_NODE16) {}
+};
+
+//Up to 48 children, found through a 256 entry index of child slots (0 == no child, else slot + 1)
+class ArtNode48 : public ArtNode {
+
+    public:
+        unsigned char childIndex[256];
+        ArtNode* children[48];
+
+        ArtNode48() : ArtNode(ART_NODE48) {
+            memset(childIndex, 0, sizeof(childIndex));
+            memset(children, 0, sizeof(children));
+        }
+};
+
+//One child pointer for every byte
+class ArtNode256 : public ArtNode {
+
+    public:
+        ArtNode* children[256];
+
+        ArtNode256() : ArtNode(ART_NODE256) {
+            memset(children, 0, sizeof(children));
+        }
+};
+
+//Leaf holding a key-value pair
+template <class K, class V>
+class ArtLeaf : public ArtNode {
+
+    public:
+        K key;
+        V value;
+
+        ArtLeaf(K newKey, V newValue) : ArtNode(ART_LEAF) {
+            key = newKey;
+            value = newValue;
+        }
+};
+
+//INNER NODE FUNCTIONS
+
+/* Function: findChild
+ * Description: Returns the link to the inner node's child for the key byte, or NULL if it has none.
+ *
+ * Param: ArtNode* node, unsigned char keyByte
+*/
+inline ArtNode** findChild(ArtNode* node, unsigned char keyByte) {
+    switch (node->type) {
+
+        case ART_NODE4: {
+            ArtNode4* node4 = (ArtNode4*) node;
+
+            for (int i = 0; i < node4->numChildren; i++) {
+                if (node4->keys[i] == keyByte) {
+                    return &node4->children[i];
+                }
+            }
+            return NULL;
+        }
+
+        case ART_NODE16: {
+            ArtNode16* node16 = (ArtNode16*) node;
+
+#if defined(__SSE2__)
+            __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8((char) keyByte), _mm_loadu_si128((__m128i*) node16->keys));
+            int matchMask = _mm_movemask_epi8(matches) & ((1 << node16->numChildren) - 1);
+
+            return matchMask != 0 ? &node16->children[__builtin_ctz(matchMask)] : NULL;
+#else
+            for (int i = 0; i < node16->numChildren; i++) {
+                if (node16->keys[i] == keyByte) {
+                    return &node16->children[i];
+                }
+            }
+            return NULL;
+#endif
+        }
+
+        case ART_NODE48: {
+            ArtNode48* node48 = (ArtNode48*) node;
+            return node48->childIndex[keyByte] != 0 ? &node48->children[node48->childIndex[keyByte] - 1] : NULL;
+        }
+
+        default: {
+            ArtNode256* node256 = (ArtNode256*) node;
+            return node256->children[keyByte] != NULL ? &node256->children[keyByte] : NULL;
+        }
+    }
+}
+
+//Returns the inner node's child with the smallest key byte
+inline ArtNode* firstChild(ArtNode* node) {
+    switch (node->type) {
+
+        case ART_NODE4:
+            return ((ArtNode4*) node)->children[0];
+
+        case ART_NODE16:
+            return ((ArtNode16*) node)->children[0];
+
+        case ART_NODE48: {
+            ArtNode48* node48 = (ArtNode48*) node;
+            int keyByte = 0;
+
+            while (node48->childIndex[keyByte] == 0) {
+                keyByte++;
+            }
+            return node48->children[node48->childIndex[keyByte] - 1];
+        }
+
+        default: {
+            ArtNode256* node256 = (ArtNode256*) node;
+            int keyByte = 0;
+
+            while (node256->children[keyByte] == NULL) {
+                keyByte++;
+            }
+            return node256->children[keyByte];
+        }
+    }
+}
+
+//Returns the inner node's child with the largest key byte
+inline ArtNode* lastChild(ArtNode* node) {
+    switch (node->type) {
+
+        case ART_NODE4:
+            return ((ArtNode4*) node)->children[node->numChildren - 1];
+
+        case ART_NODE16:
+            return ((ArtNode16*) node)->children[node->numChildren - 1];
+
+        case ART_NODE48: {
+            ArtNode48* node48 = (ArtNode48*) node;
+            int keyByte = 255;
+
+            while (node48->childIndex[keyByte] == 0) {
+                keyByte--;
+            }
+            return node48->children[node48->childIndex[keyByte] - 1];
+        }
+
+        default: {
+            ArtNode256* node256 = (ArtNode256*) node;
+            int keyByte = 255;
+
+            while (node256->children[keyByte] == NULL) {
+                keyByte--;
+            }
+            return node256->children[keyByte];
+        }
+    }
+}
+
+/* Function: forEachChild
+ * Description: Calls the callback with each child of the inner node, in key byte order.
+ *
+ * Param: ArtNode* node, Callback callback
+*/
+template <typename Callback>
+void forEachChild(ArtNode* node, Callback callback) {
+    switch (node->type) {
+
+        case ART_NODE4:
+            for (int i = 0; i < node->numChildren; i++) {
+                callback(((ArtNode4*) node)->children[i]);
+            }
+            break;
+
+        case ART_NODE16:
+            for (int i = 0; i < node->numChildren; i++) {
+                callback(((ArtNode16*) node)->children[i]);
+            }
+            break;
+
+        case ART_NODE48:
+            for (int keyByte = 0; keyByte < 256; keyByte++) {
+                if (((ArtNode48*) node)->childIndex[keyByte] != 0) {
+                    callback(((ArtNode48*) node)->children[((ArtNode48*) node)->childIndex[keyByte] - 1]);
+                }
+            }
+            break;
+
+        default:
+            for (int keyByte = 0; keyByte < 256; keyByte++) {
+                if (((ArtNode256*) node)->children[keyByte] != NULL) {
+                    callback(((ArtNode256*) node)->children[keyByte]);
+                }
+            }
+            break;
+    }
+}
+
+//Frees an inner node (not its children) as its own type
+inline void deleteInner(ArtNode* node) {
+    switch (node->type) {
+
+        case ART_NODE4:
+            delete (ArtNode4*) node;
+            break;
+
+        case ART_NODE16:
+            delete (ArtNode16*) node;
+            break;
+
+        case ART_NODE48:
+            delete (ArtNode48*) node;
+            break;
+
+        default:
+            delete (ArtNode256*) node;
+            break;
+    }
+}
+
+//Copies the child count and compressed prefix from one inner node to another
+inline void copyHeader(ArtNode* toNode, ArtNode* fromNode) {
+    toNode->numChildren = fromNode->numChildren;
+    toNode->prefixLength = fromNode->prefixLength;
+    memcpy(toNode->prefix, fromNode->prefix, MAX_PREFIX);
+}
+
+/* Function: addChild
+ * Description: Adds a child under the key byte, which the node must not already have. A full node is replaced
+ *              through its link by the next larger node type.
+ *
+ * Param: ArtNode** nodeLink, unsigned char keyByte, ArtNode* child
+*/
+inline void addChild(ArtNode** nodeLink, unsigned char keyByte, ArtNode* child) {
+    ArtNode* node = *nodeLink;
+
+    switch (node->type) {
+
+        case ART_NODE4: {
+            ArtNode4* node4 = (ArtNode4*) node;
+
+            if (node4->numChildren < 4) {
+                int position = node4->numChildren;
+
+                for (; position > 0 && node4->keys[position - 1] > keyByte; position--) {
+                    node4->keys[position] = node4->keys[position - 1];
+                    node4->children[position] = node4->children[position - 1];
+                }
+
+                node4->keys[position] = keyByte;
+                node4->children[position] = child;
+                node4->numChildren++;
+                return;
+            }
+
+            ArtNode16* node16 = new ArtNode16();
+            copyHeader(node16, node4);
+            memcpy(node16->keys, node4->keys, 4);
+            memcpy(node16->children, node4->children, 4 * sizeof(ArtNode*));
+            *nodeLink = node16;
+            delete node4;
+            break;
+        }
+
+        case ART_NODE16: {
+            ArtNode16* node16 = (ArtNode16*) node;
+
+            if (node16->numChildren < 16) {
+                int position = node16->numChildren;
+
+                for (; position > 0 && node16->keys[position - 1] > keyByte; position--) {
+                    node16->keys[position] = node16->keys[position - 1];
+                    node16->children[position] = node16->children[position - 1];
+                }
+
+                node16->keys[position] = keyByte;
+                node16->children[position] = child;
+                node16->numChildren++;
+                return;
+            }
+
+            ArtNode48* node48 = new ArtNode48();
+            copyHeader(node48, node16);
+
+            for (int i = 0; i < 16; i++) {
+                node48->childIndex[node16->keys[i]] = i + 1;
+                node48->children[i] = node16->children[i];
+            }
+
+            *nodeLink = node48;
+            delete node16;
+            break;
+        }
+
+        case ART_NODE48: {
+            ArtNode48* node48 = (ArtNode48*) node;
+
+            if (node48->numChildren < 48) {
+                int slot = 0;
+
+                while (node48->children[slot] != NULL) {
+                    slot++;
+                }
+
+                node48->children[slot] = child;
+                node48->childIndex[keyByte] = slot + 1;
+                node48->numChildren++;
+                return;
+            }
+
+            ArtNode256* node256 = new ArtNode256();
+            copyHeader(node256, node48);
+
+            for (int i = 0; i < 256; i++) {
+                if (node48->childIndex[i] != 0) {
+                    node256->children[i] = node48->children[node48->childIndex[i] - 1];
+                }
+            }
+
+            *nodeLink = node256;
+            delete node48;
+            break;
+        }
+
+        default: {
+            ArtNode256* node256 = (ArtNode256*) node;
+            node256->children[keyByte] = child;
+            node256->numChildren++;
+            return;
+        }
+    }
+
+    //The node was grown, add the child to its replacement
+    addChild(nodeLink, keyByte, child);
+}
+
+/* Function: removeChild
+ * Description: Removes the child under the key byte. A node left sparse is replaced through its link by the next
+ *              smaller node type, and a Node4 left with one child is replaced by that child, whose prefix gains the
+ *              node's prefix and key byte.
+ *
+ * Param: ArtNode** nodeLink, unsigned char keyByte
+*/
+inline void removeChild(ArtNode** nodeLink, unsigned char keyByte) {
+    ArtNode* node = *nodeLink;
+
+    switch (node->type) {
+
+        case ART_NODE4: {
+            ArtNode4* node4 = (ArtNode4*) node;
+            int position = 0;
+
+            while (node4->keys[position] != keyByte) {
+                position++;
+            }
+
+            for (; position + 1 < node4->numChildren; position++) {
+                node4->keys[position] = node4->keys[position + 1];
+                node4->children[position] = node4->children[position + 1];
+            }
+
+            node4->numChildren--;
+
+            if (node4->numChildren == 1) {
+                ArtNode* child = node4->children[0];
+
+                if (child->type != ART_LEAF) {
+                    unsigned char prefix[MAX_PREFIX];
+                    int numStored = std::min((int) node4->prefixLength, MAX_PREFIX);
+
+                    memcpy(prefix, node4->prefix, numStored);
+
+                    if (numStored < MAX_PREFIX) {
+                        prefix[numStored++] = node4->keys[0];
+                    }
+
+                    int numFromChild = std::min((int) child->prefixLength, MAX_PREFIX - numStored);
+                    memcpy(prefix + numStored, child->prefix, numFromChild);
+                    memcpy(child->prefix, prefix, numStored + numFromChild);
+                    child->prefixLength += node4->prefixLength + 1;
+                }
+
+                *nodeLink = child;
+                delete node4;
+            }
+            break;
+        }
+
+        case ART_NODE16: {
+            ArtNode16* node16 = (ArtNode16*) node;
+            int position = 0;
+
+            while (node16->keys[position] != keyByte) {
+                position++;
+            }
+
+            for (; position + 1 < node16->numChildren; position++) {
+                node16->keys[position] = node16->keys[position + 1];
+                node16->children[position] = node16->children[position + 1];
+            }
+
+            node16->numChildren--;
+
+            if (node16->numChildren == 3) {
+                ArtNode4* node4 = new ArtNode4();
+                copyHeader(node4, node16);
+                memcpy(node4->keys, node16->keys, 3);
+                memcpy(node4->children, node16->children, 3 * sizeof(ArtNode*));
+                *nodeLink = node4;
+                delete node16;
+            }
+            break;
+        }
+
+        case ART_NODE48: {
+            ArtNode48* node48 = (ArtNode48*) node;
+            node48->children[node48->childIndex[keyByte] - 1] = NULL;
+            node48->childIndex[keyByte] = 0;
+            node48->numChildren--;
+
+            if (node48->numChildren == 12) {
+                ArtNode16* node16 = new ArtNode16();
+                int position = 0;
+                copyHeader(node16, node48);
+
+                for (int i = 0; i < 256; i++) {
+                    if (node48->childIndex[i] != 0) {
+                        node16->keys[position] = i;
+                        node16->children[position++] = node48->children[node48->childIndex[i] - 1];
+                    }
+                }
+
+                *nodeLink = node16;
+                delete node48;
+            }
+            break;
+        }
+
+        default: {
+            ArtNode256* node256 = (ArtNode256*) node;
+            node256->children[keyByte] = NULL;
+            node256->numChildren--;
+
+            if (node256->numChildren == 37) {
+                ArtNode48* node48 = new ArtNode48();
+                int slot = 0;
+                copyHeader(node48, node256);
+
+                for (int i = 0; i < 256; i++) {
+                    if (node256->children[i] != NULL) {
+                        node48->children[slot] = node256->children[i];
+                        node48->childIndex[i] = ++slot;
+                    }
+                }
+
+                *nodeLink = node48;
+                delete node256;
+            }
+            break;
+        }
+    }
+}
+
+//AdaptiveRadixTree class to store key-value pairs in an adaptive radix tree, ordered by key
+template <typename K, typename V>
+class AdaptiveRadixTree {
+    private:
+        ArtNode* root = NULL;
+        int numKeys = 0;
+
+        void destroy(ArtNode* node);
+        ArtLeaf<K,V>* find(const K& searchKey);
+        bool put(ArtNode** nodeLink, const RadixKeyBytes& keyBytes, int depth, K newKey, V newValue);
+        ArtLeaf<K,V>* maxLeaf(ArtNode* node);
+        ArtLeaf<K,V>* minLeaf(ArtNode* node);
+        int prefixMismatch(ArtNode* node, const RadixKeyBytes& keyBytes, int depth);
+        void printInorder(ArtNode* node);
+        template <typename Callback>
+        void rangeScan(ArtNode* node, const K& lowKey, const K& highKey, Callback& callback);
+        bool remove(ArtNode** nodeLink, const RadixKeyBytes& keyBytes, int depth, const K& searchKey);
+
+    public:
+        void clear();
+        bool contains(K searchKey);
+        V get(K searchKey);
+        V min();
+        V max();
+        void printInorder();
+        void put(K newKey, V newValue);
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        void remove(K searchKey);
+        int size();
+
+        AdaptiveRadixTree() {}
+        AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+        AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+
+        ~AdaptiveRadixTree() {
+            clear();
+        }
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: destroy
+ * Description: Frees every node of the subtree.
+ *
+ * Param: ArtNode* node
+*/
+template <typename K, typename V>
+void AdaptiveRadixTree<K,V>::destroy(ArtNode* node) {
+
+    if (node->type == ART_LEAF) {
+        delete (ArtLeaf<K,V>*) node;
+        return;
+    }
+
+    forEachChild(node, [this](ArtNode* child) { destroy(child); });
+    deleteInner(node);
+}
+
+/* Function: find
+ * Description: Returns the leaf holding the key, or NULL. Prefixes longer than MAX_PREFIX are skipped
+ *              without being checked, since the leaf's key is compared in full at the end.
+ *
+ * Param: const K& searchKey
+*/
+template <typename K, typename V>
+ArtLeaf<K,V>* AdaptiveRadixTree<K,V>::find(const K& searchKey) {
+    RadixKeyBytes keyBytes;
+    ArtNode* node = root;
+    int depth = 0;
+
+    encodeKey(searchKey, keyBytes);
+
+    while (node != NULL) {
+        if (node->type == ART_LEAF) {
+            ArtLeaf<K,V>* leaf = (ArtLeaf<K,V>*) node;
+            return leaf->key == searchKey ? leaf : NULL;
+        }
+
+        int numChecked = std::min(std::min((int) node->prefixLength, MAX_PREFIX), keyBytes.length - depth);
+
+        if (numChecked > 0 && memcmp(node->prefix, keyBytes.bytes + depth, numChecked) != 0) {
+            return NULL;
+        }
+
+        depth += node->prefixLength;
+
+        if (depth >= keyBytes.length) {
+            return NULL;
+        }
+
+        ArtNode** childLink = findChild(node, keyBytes.bytes[depth]);
+
+        if (childLink == NULL) {
+            return NULL;
+        }
+
+        node = *childLink;
+        depth++;
+    }
+
+    return NULL;
+}
+
+//Returns the leaf with the largest key in the subtree
+template <typename K, typename V>
+ArtLeaf<K,V>* AdaptiveRadixTree<K,V>::maxLeaf(ArtNode* node) {
+    while (node->type != ART_LEAF) {
+        node = lastChild(node);
+    }
+
+    return (ArtLeaf<K,V>*) node;
+}
+
+//Returns the leaf with the smallest key in the subtree
+template <typename K, typename V>
+ArtLeaf<K,V>* AdaptiveRadixTree<K,V>::minLeaf(ArtNode* node) {
+    while (node->type != ART_LEAF) {
+        node = firstChild(node);
+    }
+
+    return (ArtLeaf<K,V>*) node;
+}
+
+/* Function: prefixMismatch
+ * Description: Returns how many bytes of the inner node's prefix match the key from the depth onwards.
+ *              Bytes past MAX_PREFIX are read from the smallest leaf below the node, which shares the prefix.
+ *
+ * Param: ArtNode* node, const RadixKeyBytes& keyBytes, int depth
+*/
+template <typename K, typename V>
+int AdaptiveRadixTree<K,V>::prefixMismatch(ArtNode* node, const RadixKeyBytes& keyBytes, int depth) {
+    int numChecked = std::min(std::min((int) node->prefixLength, MAX_PREFIX), keyBytes.length - depth);
+    int index = 0;
+
+    for (; index < numChecked; index++) {
+        if (node->prefix[index] != keyBytes.bytes[depth + index]) {
+            return index;
+        }
+    }
+
+    if ((int) node->prefixLength > MAX_PREFIX) {
+        RadixKeyBytes leafBytes;
+        encodeKey(minLeaf(node)->key, leafBytes);
+        numChecked = std::min((int) node->prefixLength, std::min(leafBytes.length, keyBytes.length) - depth);
+
+        for (; index < numChecked; index++) {
+            if (leafBytes.bytes[depth + index] != keyBytes.bytes[depth + index]) {
+                return index;
+            }
+        }
+    }
+
+    return index;
+}
+
+/* Function: printInorder
+ * Description: Prints every key in the subtree in order.
+ *
+ * Param: ArtNode* node
+*/
+template <typename K, typename V>
+void AdaptiveRadixTree<K,V>::printInorder(ArtNode* node) {
+
+    if (node->type == ART_LEAF) {
+        cout << "K: " << ((ArtLeaf<K,V>*) node)->key << endl;
+        return;
+    }
+
+    forEachChild(node, [this](ArtNode* child) { printInorder(child); });
+}
+
+/* Function: put
+ * Description: Inserts the pair below the link, returning false if the key was already present (its value is replaced).
+ *              A leaf in the way is split into a Node4 over the bytes the two keys share, and a prefix the key leaves
+ *              part way through is split the same way.
+ *
+ * Param: ArtNode** nodeLink, const RadixKeyBytes& keyBytes, int depth, K newKey, V newValue
+*/
+template <typename K, typename V>
+bool AdaptiveRadixTree<K,V>::put(ArtNode** nodeLink, const RadixKeyBytes& keyBytes, int depth, K newKey, V newValue) {
+    ArtNode* node = *nodeLink;
+
+    if (node == NULL) {
+        *nodeLink = new ArtLeaf<K,V>(newKey, newValue);
+        return true;
+    }
+
+    if (node->type == ART_LEAF) {
+        ArtLeaf<K,V>* leaf = (ArtLeaf<K,V>*) node;
+
+        if (leaf->key == newKey) {
+            leaf->value = newValue;
+            return false;
+        }
+
+        RadixKeyBytes leafBytes;
+        encodeKey(leaf->key, leafBytes);
+
+        int commonLength = 0;
+        int maxCommon = std::min(leafBytes.length, keyBytes.length) - depth;
+
+        while (commonLength < maxCommon && leafBytes.bytes[depth + commonLength] == keyBytes.bytes[depth + commonLength]) {
+            commonLength++;
+        }
+
+        ArtNode* newNode = new ArtNode4();
+        newNode->prefixLength = commonLength;
+        memcpy(newNode->prefix, keyBytes.bytes + depth, std::min(commonLength, MAX_PREFIX));
+
+        addChild(&newNode, leafBytes.bytes[depth + commonLength], leaf);
+        addChild(&newNode, keyBytes.bytes[depth + commonLength], new ArtLeaf<K,V>(newKey, newValue));
+        *nodeLink = newNode;
+        return true;
+    }
+
+    if (node->prefixLength > 0) {
+        int mismatch = prefixMismatch(node, keyBytes, depth);
+
+        if (mismatch < (int) node->prefixLength) {
+            ArtNode* newNode = new ArtNode4();
+            newNode->prefixLength = mismatch;
+            memcpy(newNode->prefix, node->prefix, std::min(mismatch, MAX_PREFIX));
+
+            //The old node keeps the part of its prefix after the mismatched byte
+            if (node->prefixLength <= (uint32_t) MAX_PREFIX) {
+                addChild(&newNode, node->prefix[mismatch], node);
+                node->prefixLength -= mismatch + 1;
+                memmove(node->prefix, node->prefix + mismatch + 1, node->prefixLength);
+            }
+
+            else {
+                RadixKeyBytes leafBytes;
+                encodeKey(minLeaf(node)->key, leafBytes);
+                addChild(&newNode, leafBytes.bytes[depth + mismatch], node);
+                node->prefixLength -= mismatch + 1;
+                memcpy(node->prefix, leafBytes.bytes + depth + mismatch + 1, std::min((int) node->prefixLength, MAX_PREFIX));
+            }
+
+            addChild(&newNode, keyBytes.bytes[depth + mismatch], new ArtLeaf<K,V>(newKey, newValue));
+            *nodeLink = newNode;
+            return true;
+        }
+
+        depth += node->prefixLength;
+    }
+
+    ArtNode** childLink = findChild(node, keyBytes.bytes[depth]);
+
+    if (childLink != NULL) {
+        return put(childLink, keyBytes, depth + 1, newKey, newValue);
+    }
+
+    addChild(nodeLink, keyBytes.bytes[depth], new ArtLeaf<K,V>(newKey, newValue));
+    return true;
+}
+
+/* Function: rangeScan
+ * Description: Calls the callback with each pair of the subtree between lowKey and highKey (inclusive), in key order,
+ *              skipping subtrees whose smallest or largest key shows they are out of range.
+ *
+ * Param: ArtNode* node, const K& lowKey, const K& highKey, Callback& callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void AdaptiveRadixTree<K,V>::rangeScan(ArtNode* node, const K& lowKey, const K& highKey, Callback& callback) {
+
+    if (node->type == ART_LEAF) {
+        ArtLeaf<K,V>* leaf = (ArtLeaf<K,V>*) node;
+
+        if (!(leaf->key < lowKey) && !(highKey < leaf->key)) {
+            callback(leaf->key, leaf->value);
+        }
+        return;
+    }
+
+    if (maxLeaf(node)->key < lowKey || highKey < minLeaf(node)->key) {
+        return;
+    }
+
+    forEachChild(node, [&](ArtNode* child) { rangeScan(child, lowKey, highKey, callback); });
+}
+
+/* Function: remove
+ * Description: Removes the key from below the link, returning whether it was found. Prefixes are checked only
+ *              up to MAX_PREFIX bytes, since the leaf's key is compared in full before it is removed.
+ *
+ * Param: ArtNode** nodeLink, const RadixKeyBytes& keyBytes, int depth, const K& searchKey
+*/
+template <typename K, typename V>
+bool AdaptiveRadixTree<K,V>::remove(ArtNode** nodeLink, const RadixKeyBytes& keyBytes, int depth, const K& searchKey) {
+    ArtNode* node = *nodeLink;
+
+    if (node->type == ART_LEAF) {
+
+        //Only reached when the root is a leaf
+        if (((ArtLeaf<K,V>*) node)->key == searchKey) {
+            delete (ArtLeaf<K,V>*) node;
+            *nodeLink = NULL;
+            return true;
+        }
+        return false;
+    }
+
+    int numChecked = std::min(std::min((int) node->prefixLength, MAX_PREFIX), keyBytes.length - depth);
+
+    if (numChecked > 0 && memcmp(node->prefix, keyBytes.bytes + depth, numChecked) != 0) {
+        return false;
+    }
+
+    depth += node->prefixLength;
+
+    if (depth >= keyBytes.length) {
+        return false;
+    }
+
+    ArtNode** childLink = findChild(node, keyBytes.bytes[depth]);
+
+    if (childLink == NULL) {
+        return false;
+    }
+
+    if ((*childLink)->type == ART_LEAF) {
+        ArtLeaf<K,V>* leaf = (ArtLeaf<K,V>*) *childLink;
+
+        if (!(leaf->key == searchKey)) {
+            return false;
+        }
+
+        removeChild(nodeLink, keyBytes.bytes[depth]);
+        delete leaf;
+        return true;
+    }
+
+    return remove(childLink, keyBytes, depth + 1, searchKey);
+}
+
+//PUBLIC FUNCTIONS
+
+//Removes every key from the tree
+template <typename K, typename V>
+void AdaptiveRadixTree<K,V>::clear() {
+    if (root != NULL) {
+        destroy(root);
+    }
+
+    root = NULL;
+    numKeys = 0;
+}
+
+//Returns whether or not the key appears in the tree
+template <typename K, typename V>
+bool AdaptiveRadixTree<K,V>::contains(K searchKey) {
+    return find(searchKey) != NULL;
+}
+
+/* Function: get
+ * Description: Searches for the key and returns its associated value if found within the tree, or V() if not.
+ *
+ * Param: K searchKey
+*/
+template <typename K, typename V>
+V AdaptiveRadixTree<K,V>::get(K searchKey) {
+    ArtLeaf<K,V>* leaf = find(searchKey);
+    return leaf != NULL ? leaf->value : V();
+}
+
+//Returns the value of the maximum key in the tree
+template <typename K, typename V>
+V AdaptiveRadixTree<K,V>::max() {
+    return maxLeaf(root)->value;
+}
+
+//Returns the value of the minimum key in the tree
+template <typename K, typename V>
+V AdaptiveRadixTree<K,V>::min() {
+    return minLeaf(root)->value;
+}
+
+//Public in-order
+template <typename K, typename V>
+void AdaptiveRadixTree<K,V>::printInorder() {
+    if (root != NULL) {
+        printInorder(root);
+    }
+}
+
+/* Function: put
+ * Description: Inserts the key and value into the tree, replacing the value if the key is already present.
+ *
+ * Param: K newKey, V newValue
+*/
+template <typename K, typename V>
+void AdaptiveRadixTree<K,V>::put(K newKey, V newValue) {
+    RadixKeyBytes keyBytes;
+    encodeKey(newKey, keyBytes);
+
+    if (put(&root, keyBytes, 0, newKey, newValue)) {
+        numKeys++;
+    }
+}
+
+/* Function: rangeScan
+ * Description: Calls the callback with each key and value between lowKey and highKey (inclusive), in key order.
+ *
+ * Param: K lowKey, K highKey, Callback callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void AdaptiveRadixTree<K,V>::rangeScan(K lowKey, K highKey, Callback callback) {
+    if (root != NULL) {
+        rangeScan(root, lowKey, highKey, callback);
+    }
+}
+
+//Removes the key from the tree if it is present
+template <typename K, typename V>
+void AdaptiveRadixTree<K,V>::remove(K searchKey) {
+    RadixKeyBytes keyBytes;
+    encodeKey(searchKey, keyBytes);
+
+    if (root != NULL && remove(&root, keyBytes, 0, searchKey)) {
+        numKeys--;
+    }
+}
+
+//Return number of keys in the tree
+template <typename K, typename V>
+int AdaptiveRadixTree<K,V>::size() {
+    return numKeys;
+}
+
+#endif
@@ -0,0 +1,139 @@
+/* DESCRIPTION OF PROGRAM
+
+    Benchmarks and test driver for the BPlusTree (see bPlusTree.h), compared against the RedBlack tree
+    (see redBlackTree.h) and std::map on random 64-bit keys.
+
+    The benchmark runs 10^5, 10^6, 10^7 and 10^8 keys, stopping at maxKeys. 10^8 keys need several gigabytes of memory.
+    The keys are int64_t, so internal nodes only use the SIMD key search when built with SSE4.2; the benchmark
+    prints which search it is measuring.
+
+    Usage: bPlusTree [--benchmark [maxKeys]]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bPlusTree.h"
+#include "redBlackTree.h"
+
+//BENCHMARKS
+
+/* Function: benchmarkTree
+ * Description: Times inserts of the keys, lookups of each key and a full ordered scan on a tree with the
+ *              BPlusTree and RedBlack interface, and prints ns/op for each. The tree is deleted before returning.
+ *
+ * Param: string name, Tree* tree, std::vector<int64_t>& keys, uint64_t& checksum
+*/
+template <typename Tree>
+void benchmarkTree(string name, Tree* tree, std::vector<int64_t>& keys, uint64_t& checksum) {
+    double numKeys = keys.size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t key : keys) {
+        tree->put(key, key);
+    }
+    auto treePut = std::chrono::steady_clock::now();
+    for (int64_t key : keys) {
+        checksum += tree->get(key);
+    }
+    auto treeGet = std::chrono::steady_clock::now();
+    tree->rangeScan(INT64_MIN, INT64_MAX, [&](int64_t key, int64_t value) { checksum += value; });
+    auto treeScan = std::chrono::steady_clock::now();
+
+    cout << name << "put " << std::chrono::duration<double, std::nano>(treePut - start).count() / numKeys
+         << " ns/op, get " << std::chrono::duration<double, std::nano>(treeGet - treePut).count() / numKeys
+         << " ns/op, scan " << std::chrono::duration<double, std::nano>(treeScan - treeGet).count() / numKeys << " ns/op" << endl;
+
+    delete tree;
+}
+
+/* Function: runBenchmarks
+ * Description: Times random inserts, random lookups and a full ordered scan of a BPlusTree against a RedBlack tree
+ *              and std::map, for numKeys from 10^5 up to maxKeys, ten times more each run. A maxKeys below 10^5
+ *              runs just maxKeys.
+ *
+ * Param: int maxKeys
+*/
+void runBenchmarks(int maxKeys) {
+
+#if defined(__SSE4_2__)
+    cout << "Internal node search: SSE4.2" << endl;
+#else
+    cout << "Internal node search: std::lower_bound (build with -msse4.2 for the SIMD search)" << endl;
+#endif
+
+    for (long long numKeys = std::min(100000, maxKeys); numKeys <= maxKeys; numKeys *= 10) {
+        std::vector<int64_t> keys(numKeys);
+        uint64_t checksum = 0;
+
+        for (int i = 0; i < numKeys; i++) {
+            keys[i] = ((int64_t) rand() << 31) ^ rand();
+        }
+
+        cout << numKeys << " keys" << endl;
+        benchmarkTree("  BPlusTree: ", new BPlusTree<int64_t,int64_t>(), keys, checksum);
+        benchmarkTree("  RedBlack:  ", new RedBlack<int64_t,int64_t>(), keys, checksum);
+
+        std::map<int64_t,int64_t>* stdMap = new std::map<int64_t,int64_t>();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int64_t key : keys) {
+            (*stdMap)[key] = key;
+        }
+        auto mapPut = std::chrono::steady_clock::now();
+        for (int64_t key : keys) {
+            checksum += stdMap->find(key)->second;
+        }
+        auto mapGet = std::chrono::steady_clock::now();
+        for (auto& entry : *stdMap) {
+            checksum += entry.second;
+        }
+        auto mapScan = std::chrono::steady_clock::now();
+
+        cout << "  std::map:  put " << std::chrono::duration<double, std::nano>(mapPut - start).count() / numKeys
+             << " ns/op, get " << std::chrono::duration<double, std::nano>(mapGet - mapPut).count() / numKeys
+             << " ns/op, scan " << std::chrono::duration<double, std::nano>(mapScan - mapGet).count() / numKeys << " ns/op" << endl;
+        cout << "  (checksum " << checksum << ")" << endl;
+
+        delete stdMap;
+    }
+}
+
+//Driver for testing
+int main(int argc, char** argv) {
+
+    //Benchmarks (run with --benchmark [maxKeys])
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "--benchmark") != 0 || argc > 3) {
+            cout << "Usage: " << argv[0] << " [--benchmark [maxKeys]]" << endl;
+            return 1;
+        }
+
+        runBenchmarks(argc == 3 ? std::max(1000, atoi(argv[2])) : 100000000);
+        return 0;
+    }
+
+    // BPlusTree<int,string>* testTree = new BPlusTree<int,string>();
+
+    // testTree->put(1,"Alpha");
+    // testTree->put(3,"Charlie");
+    // testTree->put(6,"Frank");
+    // testTree->put(5,"Echo");
+    // testTree->put(8,"Hotel");
+    // testTree->put(11,"Kilo");
+    // testTree->put(26,"Zulu");
+
+    // testTree->printInorder();
+    // cout << testTree->min() << " " << testTree->max() << endl;
+
+    // testTree->rangeScan(4, 11, [](int key, string value) { cout << key << " " << value << endl; });
+
+    // testTree->remove(6);
+    // testTree->removeMin();
+    // testTree->removeMax();
+    // delete testTree;
+}
@@ -0,0 +1,781 @@
+/* DESCRIPTION OF FILE
+
+    This file implements a B+tree ordered map with the same interface as the RedBlack tree.
+    Every node holds many keys in a contiguous array sized to a few cache lines (NODE_BYTES), so a
+    lookup touches roughly log(B) n nodes instead of log2 n. All values live in the leaves, which are
+    linked together so that ordered scans never have to walk back up the tree.
+
+    Internal nodes search their keys with SSE when the keys are 32 or 64-bit signed integers. The 64-bit search
+    needs SSE4.2, so it is only compiled when the build targets it (-msse4.2, see BPLUS_SSE42 in CMakeLists.txt);
+    otherwise 64-bit keys fall back to std::lower_bound.
+*/
+
+#ifndef B_PLUS_TREE_H
+#define B_PLUS_TREE_H
+
+#include <algorithm>
+#include <iostream>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+using namespace std;
+
+//KEY SEARCH
+
+/* Function: lowerBound
+ * Description: Returns the index of the first key in the sorted array that is not less than the search key.
+ *
+ * Param: const K* keys, int numKeys, K searchKey
+*/
+template <class K>
+int lowerBound(const K* keys, int numKeys, const K& searchKey) {
+    return std::lower_bound(keys, keys + numKeys, searchKey) - keys;
+}
+
+/* Function: upperBound
+ * Description: Returns the index of the first key in the sorted array that is greater than the search key.
+ *
+ * Param: const K* keys, int numKeys, K searchKey
+*/
+template <class K>
+int upperBound(const K* keys, int numKeys, const K& searchKey) {
+    return std::upper_bound(keys, keys + numKeys, searchKey) - keys;
+}
+
+#if defined(__SSE2__)
+
+//32-bit integer keys are compared four at a time. The keys are sorted, so counting the keys less than
+//(or not greater than) the search key gives the bound directly without any branches on the comparisons.
+inline int lowerBound(const int32_t* keys, int numKeys, const int32_t& searchKey) {
+    __m128i searchVec = _mm_set1_epi32(searchKey);
+    int index = 0;
+    int numLess = 0;
+
+    for (; index + 4 <= numKeys; index += 4) {
+        __m128i keyVec = _mm_loadu_si128((const __m128i*) (keys + index));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(searchVec, keyVec)));
+        numLess += __builtin_popcount(mask);
+    }
+
+    for (; index < numKeys; index++) {
+        numLess += keys[index] < searchKey;
+    }
+
+    return numLess;
+}
+
+inline int upperBound(const int32_t* keys, int numKeys, const int32_t& searchKey) {
+    __m128i searchVec = _mm_set1_epi32(searchKey);
+    int index = 0;
+    int numGreater = 0;
+
+    for (; index + 4 <= numKeys; index += 4) {
+        __m128i keyVec = _mm_loadu_si128((const __m128i*) (keys + index));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(keyVec, searchVec)));
+        numGreater += __builtin_popcount(mask);
+    }
+
+    for (; index < numKeys; index++) {
+        numGreater += keys[index] > searchKey;
+    }
+
+    return numKeys - numGreater;
+}
+
+#endif
+
+#if defined(__SSE4_2__)
+
+//64-bit integer keys are compared two at a time (_mm_cmpgt_epi64 needs SSE4.2)
+inline int lowerBound(const int64_t* keys, int numKeys, const int64_t& searchKey) {
+    __m128i searchVec = _mm_set1_epi64x(searchKey);
+    int index = 0;
+    int numLess = 0;
+
+    for (; index + 2 <= numKeys; index += 2) {
+        __m128i keyVec = _mm_loadu_si128((const __m128i*) (keys + index));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(searchVec, keyVec)));
+        numLess += __builtin_popcount(mask);
+    }
+
+    for (; index < numKeys; index++) {
+        numLess += keys[index] < searchKey;
+    }
+
+    return numLess;
+}
+
+inline int upperBound(const int64_t* keys, int numKeys, const int64_t& searchKey) {
+    __m128i searchVec = _mm_set1_epi64x(searchKey);
+    int index = 0;
+    int numGreater = 0;
+
+    for (; index + 2 <= numKeys; index += 2) {
+        __m128i keyVec = _mm_loadu_si128((const __m128i*) (keys + index));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(keyVec, searchVec)));
+        numGreater += __builtin_popcount(mask);
+    }
+
+    for (; index < numKeys; index++) {
+        numGreater += keys[index] > searchKey;
+    }
+
+    return numKeys - numGreater;
+}
+
+#endif
+
+//NODES
+
+//Base node class, the leaf flag decides whether the node is an InternalNode or a LeafNode
+class BPlusNode {
+
+    public:
+        bool isLeaf;
+        int numKeys;
+
+        BPlusNode(bool isLeaf) {
+            this->isLeaf = isLeaf;
+            numKeys = 0;
+        }
+};
+
+//Internal node, children[i] holds keys less than keys[i] and children[i+1] holds keys greater or equal
+//One extra key and child slot is kept so a node may overflow briefly before it is split
+template <class K, int MAX_KEYS>
+class InternalNode : public BPlusNode {
+
+    public:
+        K keys[MAX_KEYS + 1];
+        BPlusNode* children[MAX_KEYS + 2];
+
+        InternalNode() : BPlusNode(false) {}
+};
+
+//Leaf node holding the key-value pairs, linked to its neighbouring leaves in key order
+template <class K, class V, int MAX_KEYS>
+class LeafNode : public BPlusNode {
+
+    public:
+        K keys[MAX_KEYS + 1];
+        V values[MAX_KEYS + 1];
+        LeafNode<K,V,MAX_KEYS>* prev;
+        LeafNode<K,V,MAX_KEYS>* next;
+
+        LeafNode() : BPlusNode(true) {
+            prev = NULL;
+            next = NULL;
+        }
+};
+
+//BPlusTree class to store key-value pairs in a B+tree with nodes of roughly NODE_BYTES bytes
+template <typename K, typename V, int NODE_BYTES = 256>
+class BPlusTree {
+    private:
+        static const int LEAF_KEYS = std::max<int>(4, (NODE_BYTES - 32) / (sizeof(K) + sizeof(V)));
+        static const int INTERNAL_KEYS = std::max<int>(4, (NODE_BYTES - 16) / (sizeof(K) + sizeof(void*)));
+
+        typedef InternalNode<K,INTERNAL_KEYS> Internal;
+        typedef LeafNode<K,V,LEAF_KEYS> Leaf;
+
+        BPlusNode* root = NULL;
+        Leaf* firstLeaf = NULL;
+        Leaf* lastLeaf = NULL;
+        int numEntries = 0;
+
+        //Internal nodes and child indices walked from the root by the last call to findLeaf
+        std::vector<Internal*> pathNodes;
+        std::vector<int> pathIndices;
+
+        void destroy(BPlusNode* currNode);
+        Leaf* findLeaf(const K& searchKey, bool recordPath);
+        void fixLeafUnderflow(Leaf* currLeaf);
+        void fixInternalUnderflow(Internal* currNode);
+        void insertIntoParent(BPlusNode* leftNode, K separator, BPlusNode* rightNode);
+        void splitInternal(Internal* currNode);
+        void splitLeaf(Leaf* currLeaf);
+
+    public:
+        bool contains(K searchKey);
+        V get(K searchKey);
+        V min();
+        V max();
+        void printInorder();
+        void put(K newKey, V newValue);
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        void remove(K searchKey);
+        void removeMin();
+        void removeMax();
+        int size();
+
+        BPlusTree() {}
+        BPlusTree(const BPlusTree&) = delete;
+        BPlusTree& operator=(const BPlusTree&) = delete;
+
+        ~BPlusTree() {
+            destroy(root);
+        }
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: destroy
+ * Description: Deletes every node in the passed subtree.
+ *
+ * Param: BPlusNode* currNode
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::destroy(BPlusNode* currNode) {
+
+    if (currNode == NULL) {
+        return;
+    }
+
+    if (currNode->isLeaf) {
+        delete (Leaf*) currNode;
+        return;
+    }
+
+    Internal* internalNode = (Internal*) currNode;
+
+    for (int i = 0; i <= internalNode->numKeys; i++) {
+        destroy(internalNode->children[i]);
+    }
+
+    delete internalNode;
+}
+
+/* Function: findLeaf
+ * Description: Descends from the root to the leaf that would hold the search key.
+ *              When recordPath is set, the internal nodes and child indices taken are kept for splitting and merging.
+ *
+ * Param: K searchKey, bool recordPath
+*/
+template <typename K, typename V, int NODE_BYTES>
+typename BPlusTree<K,V,NODE_BYTES>::Leaf* BPlusTree<K,V,NODE_BYTES>::findLeaf(const K& searchKey, bool recordPath) {
+    BPlusNode* iterNode = root;
+
+    if (recordPath) {
+        pathNodes.clear();
+        pathIndices.clear();
+    }
+
+    while (iterNode != NULL && !iterNode->isLeaf) {
+        Internal* internalNode = (Internal*) iterNode;
+        int childIndex = upperBound(internalNode->keys, internalNode->numKeys, searchKey);
+
+        if (recordPath) {
+            pathNodes.push_back(internalNode);
+            pathIndices.push_back(childIndex);
+        }
+
+        iterNode = internalNode->children[childIndex];
+    }
+
+    return (Leaf*) iterNode;
+}
+
+/* Function: fixInternalUnderflow
+ * Description: Restores the minimum fill of an internal node by borrowing a child through the parent
+ *              from a sibling, or merging with a sibling and pulling the separator down from the parent.
+ *              The path recorded by findLeaf must still lead to this node.
+ *
+ * Param: Internal* currNode
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::fixInternalUnderflow(Internal* currNode) {
+    int minKeys = INTERNAL_KEYS / 2;
+
+    //The root may hold any number of keys, but is replaced by its only child once it has none
+    if (pathNodes.empty()) {
+        if (currNode->numKeys == 0) {
+            root = currNode->children[0];
+            delete currNode;
+        }
+        return;
+    }
+
+    if (currNode->numKeys >= minKeys) {
+        return;
+    }
+
+    Internal* parentNode = pathNodes.back();
+    int childIndex = pathIndices.back();
+    pathNodes.pop_back();
+    pathIndices.pop_back();
+
+    Internal* leftSibling = childIndex > 0 ? (Internal*) parentNode->children[childIndex - 1] : NULL;
+    Internal* rightSibling = childIndex < parentNode->numKeys ? (Internal*) parentNode->children[childIndex + 1] : NULL;
+
+    //Borrow the left sibling's last child, rotating the separator through the parent
+    if (leftSibling != NULL && leftSibling->numKeys > minKeys) {
+        for (int i = currNode->numKeys; i > 0; i--) {
+            currNode->keys[i] = currNode->keys[i - 1];
+        }
+
+        for (int i = currNode->numKeys + 1; i > 0; i--) {
+            currNode->children[i] = currNode->children[i - 1];
+        }
+
+        currNode->keys[0] = parentNode->keys[childIndex - 1];
+        currNode->children[0] = leftSibling->children[leftSibling->numKeys];
+        parentNode->keys[childIndex - 1] = leftSibling->keys[leftSibling->numKeys - 1];
+        leftSibling->numKeys--;
+        currNode->numKeys++;
+        return;
+    }
+
+    //Borrow the right sibling's first child, rotating the separator through the parent
+    if (rightSibling != NULL && rightSibling->numKeys > minKeys) {
+        currNode->keys[currNode->numKeys] = parentNode->keys[childIndex];
+        currNode->children[currNode->numKeys + 1] = rightSibling->children[0];
+        currNode->numKeys++;
+        parentNode->keys[childIndex] = rightSibling->keys[0];
+
+        for (int i = 0; i < rightSibling->numKeys - 1; i++) {
+            rightSibling->keys[i] = rightSibling->keys[i + 1];
+        }
+
+        for (int i = 0; i < rightSibling->numKeys; i++) {
+            rightSibling->children[i] = rightSibling->children[i + 1];
+        }
+
+        rightSibling->numKeys--;
+        return;
+    }
+
+    //Merge the right node of the pair into the left one, pulling the separator down between them
+    int separatorIndex = leftSibling != NULL ? childIndex - 1 : childIndex;
+    Internal* leftNode = leftSibling != NULL ? leftSibling : currNode;
+    Internal* rightNode = leftSibling != NULL ? currNode : rightSibling;
+
+    leftNode->keys[leftNode->numKeys] = parentNode->keys[separatorIndex];
+
+    for (int i = 0; i < rightNode->numKeys; i++) {
+        leftNode->keys[leftNode->numKeys + 1 + i] = rightNode->keys[i];
+    }
+
+    for (int i = 0; i <= rightNode->numKeys; i++) {
+        leftNode->children[leftNode->numKeys + 1 + i] = rightNode->children[i];
+    }
+
+    leftNode->numKeys += rightNode->numKeys + 1;
+    delete rightNode;
+
+    for (int i = separatorIndex; i < parentNode->numKeys - 1; i++) {
+        parentNode->keys[i] = parentNode->keys[i + 1];
+        parentNode->children[i + 1] = parentNode->children[i + 2];
+    }
+
+    parentNode->numKeys--;
+    fixInternalUnderflow(parentNode);
+}
+
+/* Function: fixLeafUnderflow
+ * Description: Restores the minimum fill of a leaf by borrowing an entry from a sibling leaf,
+ *              or merging with a sibling and removing the separator from the parent.
+ *              The path recorded by findLeaf must still lead to this leaf.
+ *
+ * Param: Leaf* currLeaf
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::fixLeafUnderflow(Leaf* currLeaf) {
+    int minKeys = LEAF_KEYS / 2;
+
+    //A root leaf may hold any number of keys, and is deleted once empty
+    if (pathNodes.empty()) {
+        if (currLeaf->numKeys == 0) {
+            delete currLeaf;
+            root = NULL;
+            firstLeaf = NULL;
+            lastLeaf = NULL;
+        }
+        return;
+    }
+
+    if (currLeaf->numKeys >= minKeys) {
+        return;
+    }
+
+    Internal* parentNode = pathNodes.back();
+    int childIndex = pathIndices.back();
+    pathNodes.pop_back();
+    pathIndices.pop_back();
+
+    Leaf* leftSibling = childIndex > 0 ? (Leaf*) parentNode->children[childIndex - 1] : NULL;
+    Leaf* rightSibling = childIndex < parentNode->numKeys ? (Leaf*) parentNode->children[childIndex + 1] : NULL;
+
+    //Borrow the left sibling's largest entry
+    if (leftSibling != NULL && leftSibling->numKeys > minKeys) {
+        for (int i = currLeaf->numKeys; i > 0; i--) {
+            currLeaf->keys[i] = currLeaf->keys[i - 1];
+            currLeaf->values[i] = currLeaf->values[i - 1];
+        }
+
+        leftSibling->numKeys--;
+        currLeaf->keys[0] = leftSibling->keys[leftSibling->numKeys];
+        currLeaf->values[0] = leftSibling->values[leftSibling->numKeys];
+        currLeaf->numKeys++;
+        parentNode->keys[childIndex - 1] = currLeaf->keys[0];
+        return;
+    }
+
+    //Borrow the right sibling's smallest entry
+    if (rightSibling != NULL && rightSibling->numKeys > minKeys) {
+        currLeaf->keys[currLeaf->numKeys] = rightSibling->keys[0];
+        currLeaf->values[currLeaf->numKeys] = rightSibling->values[0];
+        currLeaf->numKeys++;
+
+        for (int i = 0; i < rightSibling->numKeys - 1; i++) {
+            rightSibling->keys[i] = rightSibling->keys[i + 1];
+            rightSibling->values[i] = rightSibling->values[i + 1];
+        }
+
+        rightSibling->numKeys--;
+        parentNode->keys[childIndex] = rightSibling->keys[0];
+        return;
+    }
+
+    //Merge the right leaf of the pair into the left one and unlink it
+    int separatorIndex = leftSibling != NULL ? childIndex - 1 : childIndex;
+    Leaf* leftLeaf = leftSibling != NULL ? leftSibling : currLeaf;
+    Leaf* rightLeaf = leftSibling != NULL ? currLeaf : rightSibling;
+
+    for (int i = 0; i < rightLeaf->numKeys; i++) {
+        leftLeaf->keys[leftLeaf->numKeys + i] = rightLeaf->keys[i];
+        leftLeaf->values[leftLeaf->numKeys + i] = rightLeaf->values[i];
+    }
+
+    leftLeaf->numKeys += rightLeaf->numKeys;
+    leftLeaf->next = rightLeaf->next;
+
+    if (rightLeaf->next != NULL) {
+        rightLeaf->next->prev = leftLeaf;
+    }
+
+    else {
+        lastLeaf = leftLeaf;
+    }
+
+    delete rightLeaf;
+
+    for (int i = separatorIndex; i < parentNode->numKeys - 1; i++) {
+        parentNode->keys[i] = parentNode->keys[i + 1];
+        parentNode->children[i + 1] = parentNode->children[i + 2];
+    }
+
+    parentNode->numKeys--;
+    fixInternalUnderflow(parentNode);
+}
+
+/* Function: insertIntoParent
+ * Description: Adds the separator and new right node to the parent of the left node, creating a new root
+ *              if the left node was the root. Splits the parent if it overflows.
+ *
+ * Param: BPlusNode* leftNode, K separator, BPlusNode* rightNode
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::insertIntoParent(BPlusNode* leftNode, K separator, BPlusNode* rightNode) {
+
+    if (pathNodes.empty()) {
+        Internal* newRoot = new Internal();
+        newRoot->keys[0] = separator;
+        newRoot->children[0] = leftNode;
+        newRoot->children[1] = rightNode;
+        newRoot->numKeys = 1;
+        root = newRoot;
+        return;
+    }
+
+    Internal* parentNode = pathNodes.back();
+    int childIndex = pathIndices.back();
+    pathNodes.pop_back();
+    pathIndices.pop_back();
+
+    for (int i = parentNode->numKeys; i > childIndex; i--) {
+        parentNode->keys[i] = parentNode->keys[i - 1];
+        parentNode->children[i + 1] = parentNode->children[i];
+    }
+
+    parentNode->keys[childIndex] = separator;
+    parentNode->children[childIndex + 1] = rightNode;
+    parentNode->numKeys++;
+
+    if (parentNode->numKeys > INTERNAL_KEYS) {
+        splitInternal(parentNode);
+    }
+}
+
+/* Function: splitInternal
+ * Description: Splits an overflowing internal node in half and moves the middle key up to the parent.
+ *
+ * Param: Internal* currNode
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::splitInternal(Internal* currNode) {
+    Internal* rightNode = new Internal();
+    int middle = currNode->numKeys / 2;
+    K separator = currNode->keys[middle];
+
+    rightNode->numKeys = currNode->numKeys - middle - 1;
+
+    for (int i = 0; i < rightNode->numKeys; i++) {
+        rightNode->keys[i] = currNode->keys[middle + 1 + i];
+    }
+
+    for (int i = 0; i <= rightNode->numKeys; i++) {
+        rightNode->children[i] = currNode->children[middle + 1 + i];
+    }
+
+    currNode->numKeys = middle;
+    insertIntoParent(currNode, separator, rightNode);
+}
+
+/* Function: splitLeaf
+ * Description: Splits an overflowing leaf in half, links the new leaf after it, and copies the first key
+ *              of the new leaf up to the parent as a separator.
+ *
+ * Param: Leaf* currLeaf
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::splitLeaf(Leaf* currLeaf) {
+    Leaf* rightLeaf = new Leaf();
+    int middle = currLeaf->numKeys / 2;
+
+    rightLeaf->numKeys = currLeaf->numKeys - middle;
+
+    for (int i = 0; i < rightLeaf->numKeys; i++) {
+        rightLeaf->keys[i] = currLeaf->keys[middle + i];
+        rightLeaf->values[i] = currLeaf->values[middle + i];
+    }
+
+    currLeaf->numKeys = middle;
+
+    rightLeaf->prev = currLeaf;
+    rightLeaf->next = currLeaf->next;
+
+    if (currLeaf->next != NULL) {
+        currLeaf->next->prev = rightLeaf;
+    }
+
+    else {
+        lastLeaf = rightLeaf;
+    }
+
+    currLeaf->next = rightLeaf;
+    insertIntoParent(currLeaf, rightLeaf->keys[0], rightLeaf);
+}
+
+//PUBLIC FUNCTIONS
+
+/* Function: contains
+ * Description: Searches for the given key and returns whether or not it appears in the tree.
+ *
+ * Param: K searchKey
+*/
+template <typename K, typename V, int NODE_BYTES>
+bool BPlusTree<K,V,NODE_BYTES>::contains(K searchKey) {
+    Leaf* leaf = findLeaf(searchKey, false);
+
+    if (leaf == NULL) {
+        return false;
+    }
+
+    int index = lowerBound(leaf->keys, leaf->numKeys, searchKey);
+    return index < leaf->numKeys && leaf->keys[index] == searchKey;
+}
+
+/* Function: get
+ * Description: Searches for the given key and returns its associated value, or V() if it is not in the tree.
+ *
+ * Param: K searchKey
+*/
+template <typename K, typename V, int NODE_BYTES>
+V BPlusTree<K,V,NODE_BYTES>::get(K searchKey) {
+    Leaf* leaf = findLeaf(searchKey, false);
+
+    if (leaf != NULL) {
+        int index = lowerBound(leaf->keys, leaf->numKeys, searchKey);
+
+        if (index < leaf->numKeys && leaf->keys[index] == searchKey) {
+            return leaf->values[index];
+        }
+    }
+
+    return V();
+}
+
+/* Function: max
+ * Description: Returns the value of the maximum key in the tree, or V() if the tree is empty.
+*/
+template <typename K, typename V, int NODE_BYTES>
+V BPlusTree<K,V,NODE_BYTES>::max() {
+    if (lastLeaf == NULL) {
+        return V();
+    }
+
+    return lastLeaf->values[lastLeaf->numKeys - 1];
+}
+
+/* Function: min
+ * Description: Returns the value of the minimum key in the tree, or V() if the tree is empty.
+*/
+template <typename K, typename V, int NODE_BYTES>
+V BPlusTree<K,V,NODE_BYTES>::min() {
+    if (firstLeaf == NULL) {
+        return V();
+    }
+
+    return firstLeaf->values[0];
+}
+
+/* Function: printInorder
+ * Description: Walks the linked leaves and prints the keys in order.
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::printInorder() {
+    for (Leaf* leaf = firstLeaf; leaf != NULL; leaf = leaf->next) {
+        for (int i = 0; i < leaf->numKeys; i++) {
+            cout << "K: " << leaf->keys[i] << endl;
+        }
+    }
+}
+
+/* Function: put
+ * Description: Inserts the key and value into the tree, or replaces the value if the key already exists.
+ *              Leaves and internal nodes that overflow are split on the way back up.
+ *
+ * Param: K newKey, V newValue
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::put(K newKey, V newValue) {
+
+    if (root == NULL) {
+        Leaf* newLeaf = new Leaf();
+        newLeaf->keys[0] = newKey;
+        newLeaf->values[0] = newValue;
+        newLeaf->numKeys = 1;
+        root = newLeaf;
+        firstLeaf = newLeaf;
+        lastLeaf = newLeaf;
+        numEntries = 1;
+        return;
+    }
+
+    Leaf* leaf = findLeaf(newKey, true);
+    int index = lowerBound(leaf->keys, leaf->numKeys, newKey);
+
+    if (index < leaf->numKeys && leaf->keys[index] == newKey) {
+        leaf->values[index] = newValue;
+        return;
+    }
+
+    for (int i = leaf->numKeys; i > index; i--) {
+        leaf->keys[i] = leaf->keys[i - 1];
+        leaf->values[i] = leaf->values[i - 1];
+    }
+
+    leaf->keys[index] = newKey;
+    leaf->values[index] = newValue;
+    leaf->numKeys++;
+    numEntries++;
+
+    if (leaf->numKeys > LEAF_KEYS) {
+        splitLeaf(leaf);
+    }
+}
+
+/* Function: rangeScan
+ * Description: Calls the callback with each key and value between lowKey and highKey (inclusive), in key order.
+ *
+ * Param: K lowKey, K highKey, Callback callback
+*/
+template <typename K, typename V, int NODE_BYTES>
+template <typename Callback>
+void BPlusTree<K,V,NODE_BYTES>::rangeScan(K lowKey, K highKey, Callback callback) {
+    Leaf* leaf = findLeaf(lowKey, false);
+
+    if (leaf == NULL) {
+        return;
+    }
+
+    int index = lowerBound(leaf->keys, leaf->numKeys, lowKey);
+
+    while (leaf != NULL) {
+        for (; index < leaf->numKeys; index++) {
+            if (highKey < leaf->keys[index]) {
+                return;
+            }
+
+            callback(leaf->keys[index], leaf->values[index]);
+        }
+
+        leaf = leaf->next;
+        index = 0;
+    }
+}
+
+/* Function: remove
+ * Description: Removes the key from the tree if found. Leaves and internal nodes that fall below half full
+ *              borrow from or merge with a sibling on the way back up.
+ *
+ * Param: K searchKey
+*/
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::remove(K searchKey) {
+    Leaf* leaf = findLeaf(searchKey, true);
+
+    if (leaf == NULL) {
+        return;
+    }
+
+    int index = lowerBound(leaf->keys, leaf->numKeys, searchKey);
+
+    if (index == leaf->numKeys || !(leaf->keys[index] == searchKey)) {
+        return;
+    }
+
+    for (int i = index; i < leaf->numKeys - 1; i++) {
+        leaf->keys[i] = leaf->keys[i + 1];
+        leaf->values[i] = leaf->values[i + 1];
+    }
+
+    leaf->numKeys--;
+    numEntries--;
+    fixLeafUnderflow(leaf);
+}
+
+//Public removeMax function
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::removeMax() {
+    if (lastLeaf != NULL) {
+        remove(lastLeaf->keys[lastLeaf->numKeys - 1]);
+    }
+}
+
+//Public removeMin function
+template <typename K, typename V, int NODE_BYTES>
+void BPlusTree<K,V,NODE_BYTES>::removeMin() {
+    if (firstLeaf != NULL) {
+        remove(firstLeaf->keys[0]);
+    }
+}
+
+//Return number of key-value pairs in the tree
+template <typename K, typename V, int NODE_BYTES>
+int BPlusTree<K,V,NODE_BYTES>::size() {
+    return numEntries;
+}
+
+#endif
@@ -1,227 +1,207 @@
-#include <iostream>
-#include <string.h>
-using namespace std;
-
-//Node class for all key-value pairs in the BST
-template <class K, class V>
-class Node {
-
-    public:
-        K key;
-        V value;
-        Node<K,V>* left;
-        Node<K,V>* right;
-        
-        Node(K newVey, V newValue) {
-            key = newVey;
-            value = newValue;
-            left = NULL;
-            right = NULL;
-        }
-};
-
-//BST class to store nodes in a binary-search tree format
-template <typename K, typename V>
-class BST {
-    private:
-        Node<K,V> *root = NULL;
-        Node<K,V>* put(Node<K,V>* root, K newVey, V newValue);
-        Node<K,V>* remove(Node<K,V>* currNode, K searchKey);
-        Node<K,V>* getSuccessor(Node<K,V>* currNode);
-        Node<K,V>* getMax(Node<K,V>* currNode);
-
-    public:
-        void put(K newVey, V newValue);
-        V get(K searchKey);
-        void remove(K searchKey);
-        V min();
-        V max();
-};
-
-//PRIVATE FUNCTIONS
-
-/* Function: getSuccessor
- * Description: Used in node deletion to get the right subtree node for the node replacing the node being deleted.
- * 
- * Param: Node<K,V>* searchNode, K newKey, V newValue
-*/ 
-template <typename K, typename V>
-Node<K,V>* BST<K,V>::getSuccessor(Node<K,V>* currNode) {
-    if (currNode->left == NULL) {
-        return currNode->right;
-    }
+/* DESCRIPTION OF PROGRAM
 
-    currNode->left = getSuccessor(currNode->left);
-    return currNode;
-}
+    Benchmarks and test driver for the BST and its balancing policies (see bst.h). The skew benchmarks also run
+    the RedBlack tree (see redBlackTree.h) as a balanced baseline.
 
-/* Function: put
- * Description: Inserts a new node with the passed key and value into the BST, organized by key.
- *              This function searches the tree recursively.
- * 
- * Param: Node<K,V>* searchNode, K newKey, V newValue
-*/ 
-template <typename K, typename V>
-Node<K,V>* BST<K,V>::put(Node<K,V>* searchNode, K newVey, V newValue) {
-    if (searchNode == NULL) {
-        return new Node<K,V>(newVey, newValue);
-    }
+    Usage: bst [--benchmark [numKeys]]
+*/
 
-    if (newVey < searchNode->key) {
-        searchNode->left = put(searchNode->left, newVey, newValue);
-    }
 
-    else if (newVey > searchNode->key) {
-        searchNode->right = put(searchNode->right, newVey, newValue);
-    }
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
 
-    else {
-        searchNode->value = newValue;
-    }
+#include "bst.h"
+#include "redBlackTree.h"
 
-    return searchNode;
-}
+//BENCHMARKS
 
-
-/* Function: remove
- * Description: Searches for the given key in the BST and removes it if found. Searching is recursive.
+/* Function: makeKeys
+ * Description: Builds a sequence of keys for the benchmarks following the named access pattern.
+ *              "sorted" is 0..n-1 in order, "random" is a shuffle of 0..n-1, and "zipf" draws n keys
+ *              from 0..n-1 with Zipf(1) skew, so low keys are drawn far more often than high keys.
  * 
- * Param: Node<K,V>* searchNode, K newKey, V newValue
+ * Param: string pattern, int numKeys
 */ 
-template <typename K, typename V>
-Node<K,V>* BST<K,V>::remove(Node<K,V>* currNode, K searchKey) {
+std::vector<int> makeKeys(string pattern, int numKeys) {
+    std::vector<int> keys(numKeys);
 
-    if (currNode == NULL) {
-        return NULL;
+    for (int i = 0; i < numKeys; i++) {
+        keys[i] = i;
     }
 
-    //Current key > search key
-    if (searchKey < currNode->key) {
-        if (currNode->left != NULL) {
-            currNode->left = remove(currNode->left, searchKey);
+    if (pattern == "random") {
+        for (int i = numKeys - 1; i > 0; i--) {
+            std::swap(keys[i], keys[rand() % (i + 1)]);
         }
     }
 
-    //Current key < search key
-    else if (searchKey > currNode->key) {
-        if (currNode->right != NULL) {
-            currNode->right = remove(currNode->right, searchKey);
+    else if (pattern == "zipf") {
+        std::vector<double> weights(numKeys);
+        double totalWeight = 0;
+
+        for (int i = 0; i < numKeys; i++) {
+            totalWeight += 1.0 / (i + 1);
+            weights[i] = totalWeight;
+        }
+
+        for (int i = 0; i < numKeys; i++) {
+            double draw = totalWeight * rand() / RAND_MAX;
+            keys[i] = std::lower_bound(weights.begin(), weights.end() - 1, draw) - weights.begin();
         }
     }
 
-    //Current key == search key
-    else {
+    return keys;
+}
 
-        Node<K,V>* tempNode;
+/* Function: benchmarkBalance
+ * Description: Times puts followed by gets of the passed keys on a BST using the given balancing policy.
+ * 
+ * Param: string name, std::vector<int>& keys
+*/ 
+template <typename Balance>
+void benchmarkBalance(string name, std::vector<int>& keys) {
+    BST<int,int,Balance>* tree = new BST<int,int,Balance>();
+    long long checksum = 0;
 
-        if (currNode->left == NULL) {
-            tempNode = currNode->right;
-            delete currNode;
-            currNode = NULL;
-            return tempNode;
-        }
+    auto start = std::chrono::steady_clock::now();
 
-        if (currNode->right == NULL) {
-            tempNode = currNode->left;
-            delete currNode;
-            currNode = NULL;
-            return tempNode;
-        }
+    for (int key : keys) {
+        tree->put(key, key);
+    }
 
-        tempNode = currNode;
-     
-        //Set currNode to the min node in the node to remove's subtree
-        currNode = currNode->right;
+    auto middle = std::chrono::steady_clock::now();
 
-        while (currNode->left != NULL) {
-            currNode = currNode->left;
-        }
+    for (int key : keys) {
+        checksum += tree->get(key);
+    }
 
-        //Get the successor node to replace the one being removed
-        currNode->right = getSuccessor(tempNode->right);
-        currNode->left = tempNode->left;
+    auto end = std::chrono::steady_clock::now();
 
-        //Remove the node
-        delete tempNode;
-    }
+    double putNs = std::chrono::duration<double, std::nano>(middle - start).count() / keys.size();
+    double getNs = std::chrono::duration<double, std::nano>(end - middle).count() / keys.size();
 
-    return currNode;
+    cout << name << ": put " << putNs << " ns/op, get " << getNs << " ns/op (checksum " << checksum << ")" << endl;
+    delete tree;
 }
 
-//PUBLIC FUNCTIONS
-
-/* Function: get
- * Description: Searches for a node with the given key and returns its associated value if found within the tree.
- *              This function searches the tree iteratively.
+/* Function: runBenchmarks
+ * Description: Runs every balancing policy against sorted, random and Zipf-skewed key sequences.
  * 
- * Param: K searchKey
+ * Param: int numKeys
 */ 
-template <typename K, typename V>
-V BST<K,V>::get(K searchKey) {
-    Node<K,V>* iter = root;
-
-    while (iter != NULL) {
-        if (searchKey < iter->key && iter->left != NULL) {
-            iter = iter->left;
-        }
+void runBenchmarks(int numKeys) {
+    string patterns[] = {"sorted", "random", "zipf"};
 
-        else if (searchKey > iter->key && iter->right != NULL) {
-            iter = iter->right;
-        }
+    for (string pattern : patterns) {
+        std::vector<int> keys = makeKeys(pattern, numKeys);
 
-        else {
-            return iter->value;
-        }
+        cout << "Pattern: " << pattern << " (" << numKeys << " keys)" << endl;
+        benchmarkBalance<Unbalanced>("  Unbalanced", keys);
+        benchmarkBalance<Treap>("  Treap", keys);
+        benchmarkBalance<Scapegoat>("  Scapegoat", keys);
     }
-    return NULL;
 }
 
-
-/* Function: max
- * Description: Returns the value of the maximum key node in the tree.
+/* Function: makeZipfLookups
+ * Description: Draws lookups from the keys 0..n-1 with Zipf popularity, the key of rank r (from 1) being drawn with
+ *              probability proportional to 1 / r^skew. Ranks are given to the keys in a random order, so the hot keys
+ *              are spread across the key range. A skew of 0 is uniform. Sets hotShare to the fraction of lookups
+ *              expected to hit the hottest 1% of keys.
  * 
- * Param: K newKey, V newValue
+ * Param: int numKeys, int numLookups, double skew, double& hotShare
 */ 
-template <typename K, typename V>
-V BST<K,V>::max() {
-    Node<K,V>* iterNode = root;
+std::vector<int> makeZipfLookups(int numKeys, int numLookups, double skew, double& hotShare) {
+    std::vector<int> keysByRank = makeKeys("random", numKeys);
+    std::vector<double> weights(numKeys);
+    std::vector<int> lookups(numLookups);
+    double totalWeight = 0;
+
+    for (int i = 0; i < numKeys; i++) {
+        totalWeight += 1.0 / pow(i + 1, skew);
+        weights[i] = totalWeight;
+    }
 
-   while (iterNode->right != NULL) {
-       iterNode = iterNode->right;
-   }
+    hotShare = weights[std::max(numKeys / 100, 1) - 1] / totalWeight;
 
-   return iterNode->value;
+    for (int i = 0; i < numLookups; i++) {
+        double draw = totalWeight * rand() / RAND_MAX;
+        lookups[i] = keysByRank[std::lower_bound(weights.begin(), weights.end() - 1, draw) - weights.begin()];
+    }
+
+    return lookups;
 }
 
-/* Function: min
- * Description: Returns the value of the minimum key node in the tree.
+/* Function: benchmarkLookups
+ * Description: Builds a tree of the given type (a BST with some balancing policy, or a RedBlack) from the keys,
+ *              then times gets of the lookups.
  * 
- * Param: K newKey, V newValue
+ * Param: string name, std::vector<int>& keys, std::vector<int>& lookups
 */ 
-template <typename K, typename V>
-V BST<K,V>::min() {
-    Node<K,V>* iterNode = root;
+template <typename Tree>
+void benchmarkLookups(string name, std::vector<int>& keys, std::vector<int>& lookups) {
+    Tree* tree = new Tree();
+    long long checksum = 0;
 
-    while (iterNode->left != NULL) {
-       iterNode = iterNode->left;
+    for (int key : keys) {
+        tree->put(key, key);
     }
 
-   return iterNode->value;
-}
+    auto start = std::chrono::steady_clock::now();
+
+    for (int key : lookups) {
+        checksum += tree->get(key);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double getNs = std::chrono::duration<double, std::nano>(end - start).count() / lookups.size();
 
-//Public put function
-template <typename K, typename V>
-void BST<K,V>::put(K newVey, V newValue) {
-    root = put(root, newVey, newValue);
+    cout << name << ": get " << getNs << " ns/op (checksum " << checksum << ")" << endl;
+    delete tree;
 }
 
-//Public remove function
-template <typename K, typename V>
-void BST<K,V>::remove(K searchKey) {
-    root = remove(root, searchKey);
+/* Function: runSkewBenchmarks
+ * Description: Compares the self-adjusting policies against the balanced ones and the RedBlack tree for lookups of
+ *              increasing Zipf skew, on trees built from randomly ordered keys.
+ * 
+ * Param: int numKeys, int numLookups
+*/ 
+void runSkewBenchmarks(int numKeys, int numLookups) {
+    double skews[] = {0.0, 0.5, 0.8, 0.99, 1.2, 1.5};
+    std::vector<int> keys = makeKeys("random", numKeys);
+
+    for (double skew : skews) {
+        double hotShare;
+        std::vector<int> lookups = makeZipfLookups(numKeys, numLookups, skew, hotShare);
+
+        cout << "Zipf skew " << skew << " (" << numKeys << " keys, top 1% get " << 100 * hotShare << "% of lookups)" << endl;
+        benchmarkLookups<BST<int,int,Treap> >("  Treap", keys, lookups);
+        benchmarkLookups<BST<int,int,Scapegoat> >("  Scapegoat", keys, lookups);
+        benchmarkLookups<BST<int,int,Splay> >("  Splay", keys, lookups);
+        benchmarkLookups<BST<int,int,SemiSplay> >("  SemiSplay", keys, lookups);
+        benchmarkLookups<RedBlack<int,int> >("  RedBlack", keys, lookups);
+    }
 }
 
-int main() {
+//Driver for testing
+int main(int argc, char** argv) {
+
+    //Benchmarks (run with --benchmark [numKeys]), the balance benchmarks on a fiftieth of the keys since an
+    //unbalanced tree takes quadratic time on sorted keys
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "--benchmark") != 0 || argc > 3) {
+            cout << "Usage: " << argv[0] << " [--benchmark [numKeys]]" << endl;
+            return 1;
+        }
+
+        int numKeys = argc == 3 ? std::max(1000, atoi(argv[2])) : 1000000;
+        runBenchmarks(numKeys / 50);
+        runSkewBenchmarks(numKeys, numKeys * 5);
+        return 0;
+    }
+
     BST<int,string> *customers = new BST<int,string>;
     customers->put(11, "Kilo");
     customers->put(5, "Echo");
@@ -242,4 +222,19 @@ int main() {
 
     delete customers;
     customers = NULL;
-}
\ No newline at end of file
+
+    // BST<int,double,Treap> numberTree;
+    // numberTree.put(1, 1.5);
+    // numberTree.put(2, 2.5);
+    // numberTree.save("numbers.snap");
+    // numberTree.load("numbers.snap");
+
+    //Instrumentation (compile with -DTREE_STATS for the stats, validate is always available)
+
+    // BST<int,int,Treap> statsTree;
+    // for (int i = 0; i < 100000; i++) {
+    //     statsTree.put(rand(), i);
+    // }
+    // cout << "Valid: " << statsTree.validate() << endl;
+    // statsTree.getStats().print();
+}
@@ -0,0 +1,1041 @@
+#ifndef BST_H
+#define BST_H
+
+#include <algorithm>
+#include <iostream>
+#include <math.h>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../nodeAllocators.h"
+#include "treeSnapshot.h"
+#include "treeStats.h"
+using namespace std;
+
+//BSTNode class for all key-value pairs in the BST
+template <class K, class V>
+class BSTNode {
+
+    public:
+        K key;
+        V value;
+        BSTNode<K,V>* left;
+        BSTNode<K,V>* right;
+        unsigned int priority;
+        
+        BSTNode(const K& newKey, const V& newValue) : key(newKey), value(newValue) {
+            left = NULL;
+            right = NULL;
+            priority = 0;
+        }
+
+        //Builds the key and value in place from the passed arguments, so neither is copied
+        template <typename Key, typename... Args>
+        BSTNode(std::piecewise_construct_t, Key&& newKey, Args&&... args)
+            : key(std::forward<Key>(newKey)), value(std::forward<Args>(args)...) {
+            left = NULL;
+            right = NULL;
+            priority = 0;
+        }
+};
+
+/* Function: rotateLeft
+ * Description: Rotates the passed node's right child up into its place and returns the new subtree root.
+ * 
+ * Param: BSTNode<K,V>* currNode
+*/ 
+template <class K, class V>
+BSTNode<K,V>* rotateLeft(BSTNode<K,V>* currNode) {
+    TREE_STAT(if (activeTreeStats != NULL) { activeTreeStats->rotations++; })
+    BSTNode<K,V>* tempNode = currNode->right;
+    currNode->right = tempNode->left;
+    tempNode->left = currNode;
+    return tempNode;
+}
+
+/* Function: rotateRight
+ * Description: Rotates the passed node's left child up into its place and returns the new subtree root.
+ * 
+ * Param: BSTNode<K,V>* currNode
+*/ 
+template <class K, class V>
+BSTNode<K,V>* rotateRight(BSTNode<K,V>* currNode) {
+    TREE_STAT(if (activeTreeStats != NULL) { activeTreeStats->rotations++; })
+    BSTNode<K,V>* tempNode = currNode->left;
+    currNode->left = tempNode->right;
+    tempNode->right = currNode;
+    return tempNode;
+}
+
+//BALANCING POLICIES
+
+//Each policy is given the links (parent child pointers) walked from the root during an operation.
+//afterPut runs once a new node has been linked in, prepareRemove may move the node being removed
+//before it is unlinked, and afterRemove runs once the node has been deleted. validChild checks any
+//ordering the policy keeps between a parent and its child, for BST::validate. afterAccess runs when
+//a lookup or a put of an existing key reaches the last node on the path; lookups only record their
+//path for it when the policy sets ADJUSTS_ON_ACCESS.
+
+//No balancing, matches the original BST behaviour
+struct Unbalanced {
+
+    static const bool ADJUSTS_ON_ACCESS = false;
+
+    template <class K, class V>
+    static void afterAccess(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path) {}
+
+    template <class K, class V>
+    static void afterPut(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path, int numNodes, int& maxNodes) {}
+
+    template <class K, class V>
+    static BSTNode<K,V>** prepareRemove(BSTNode<K,V>** removeLink) {
+        return removeLink;
+    }
+
+    template <class K, class V>
+    static void afterRemove(BSTNode<K,V>** rootLink, int numNodes, int& maxNodes) {}
+
+    template <class K, class V>
+    static bool validChild(BSTNode<K,V>* parentNode, BSTNode<K,V>* childNode) {
+        return true;
+    }
+};
+
+//Treap balancing, nodes are given a random priority and kept in max-heap order by priority
+struct Treap {
+
+    static const bool ADJUSTS_ON_ACCESS = false;
+
+    template <class K, class V>
+    static void afterAccess(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path) {}
+
+    /* Function: afterPut
+     * Description: Gives the new node a random priority and rotates it up until its parent has a higher priority.
+    */ 
+    template <class K, class V>
+    static void afterPut(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path, int numNodes, int& maxNodes) {
+        BSTNode<K,V>* newNode = *path.back();
+        newNode->priority = rand();
+
+        while (path.size() > 1) {
+            BSTNode<K,V>** parentLink = path[path.size() - 2];
+            BSTNode<K,V>* parentNode = *parentLink;
+
+            if (parentNode->priority >= newNode->priority) {
+                break;
+            }
+
+            if (parentNode->left == newNode) {
+                *parentLink = rotateRight(parentNode);
+            }
+
+            else {
+                *parentLink = rotateLeft(parentNode);
+            }
+
+            path.pop_back();
+        }
+    }
+
+    /* Function: prepareRemove
+     * Description: Rotates the node to remove down, past its higher-priority child, until it has at most one child.
+     *              Returns the link to the node at its new position.
+    */ 
+    template <class K, class V>
+    static BSTNode<K,V>** prepareRemove(BSTNode<K,V>** removeLink) {
+        BSTNode<K,V>* removeNode = *removeLink;
+
+        while (removeNode->left != NULL && removeNode->right != NULL) {
+
+            if (removeNode->left->priority > removeNode->right->priority) {
+                *removeLink = rotateRight(removeNode);
+                removeLink = &(*removeLink)->right;
+            }
+
+            else {
+                *removeLink = rotateLeft(removeNode);
+                removeLink = &(*removeLink)->left;
+            }
+        }
+
+        return removeLink;
+    }
+
+    template <class K, class V>
+    static void afterRemove(BSTNode<K,V>** rootLink, int numNodes, int& maxNodes) {}
+
+    //A child may not have a higher priority than its parent
+    template <class K, class V>
+    static bool validChild(BSTNode<K,V>* parentNode, BSTNode<K,V>* childNode) {
+        return parentNode->priority >= childNode->priority;
+    }
+};
+
+//Scapegoat balancing, subtrees that grow too deep are rebuilt into perfectly balanced subtrees
+struct Scapegoat {
+
+    //Weight-balance factor (alpha = 2/3), a child may hold at most ALPHA_NUM/ALPHA_DEN of its parent's nodes
+    static const int ALPHA_NUM = 2;
+    static const int ALPHA_DEN = 3;
+
+    static const bool ADJUSTS_ON_ACCESS = false;
+
+    template <class K, class V>
+    static void afterAccess(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path) {}
+
+    /* Function: afterPut
+     * Description: If the new node is deeper than log(3/2) of the tree size, walks back up the path to find
+     *              the first ancestor that is not alpha-weight-balanced and rebuilds its subtree.
+    */ 
+    template <class K, class V>
+    static void afterPut(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path, int numNodes, int& maxNodes) {
+        int depth = path.size() - 1;
+
+        if (numNodes > maxNodes) {
+            maxNodes = numNodes;
+        }
+
+        if (depth <= depthLimit(numNodes)) {
+            return;
+        }
+
+        int childSize = 1;
+
+        for (int i = path.size() - 2; i >= 0; i--) {
+            BSTNode<K,V>* parentNode = *path[i];
+            BSTNode<K,V>* siblingNode = parentNode->left == *path[i + 1] ? parentNode->right : parentNode->left;
+            int parentSize = childSize + 1 + subtreeSize(siblingNode);
+
+            if (ALPHA_DEN * childSize > ALPHA_NUM * parentSize) {
+                rebuild(path[i]);
+                return;
+            }
+
+            childSize = parentSize;
+        }
+    }
+
+    template <class K, class V>
+    static BSTNode<K,V>** prepareRemove(BSTNode<K,V>** removeLink) {
+        return removeLink;
+    }
+
+    /* Function: afterRemove
+     * Description: Rebuilds the whole tree once enough nodes have been removed since the last rebuild.
+    */ 
+    template <class K, class V>
+    static void afterRemove(BSTNode<K,V>** rootLink, int numNodes, int& maxNodes) {
+        if (ALPHA_DEN * numNodes < ALPHA_NUM * maxNodes) {
+            rebuild(rootLink);
+            maxNodes = numNodes;
+        }
+    }
+
+    template <class K, class V>
+    static bool validChild(BSTNode<K,V>* parentNode, BSTNode<K,V>* childNode) {
+        return true;
+    }
+
+    //Returns floor(log(3/2) n), the deepest a node may sit in an alpha-balanced tree
+    static int depthLimit(int numNodes) {
+        return (int) floor(log((double) numNodes) / log((double) ALPHA_DEN / ALPHA_NUM));
+    }
+
+    /* Function: buildBalanced
+     * Description: Links the sorted nodes between the two indices into a perfectly balanced subtree.
+    */ 
+    template <class K, class V>
+    static BSTNode<K,V>* buildBalanced(std::vector<BSTNode<K,V>*>& nodes, int low, int high) {
+        if (low > high) {
+            return NULL;
+        }
+
+        int mid = low + (high - low) / 2;
+        nodes[mid]->left = buildBalanced(nodes, low, mid - 1);
+        nodes[mid]->right = buildBalanced(nodes, mid + 1, high);
+        return nodes[mid];
+    }
+
+    /* Function: rebuild
+     * Description: Flattens the subtree at the passed link in-order and relinks it as a balanced subtree.
+    */ 
+    template <class K, class V>
+    static void rebuild(BSTNode<K,V>** subtreeLink) {
+        std::vector<BSTNode<K,V>*> nodes;
+        std::vector<BSTNode<K,V>*> stack;
+        BSTNode<K,V>* iterNode = *subtreeLink;
+
+        while (iterNode != NULL || !stack.empty()) {
+            while (iterNode != NULL) {
+                stack.push_back(iterNode);
+                iterNode = iterNode->left;
+            }
+
+            iterNode = stack.back();
+            stack.pop_back();
+            nodes.push_back(iterNode);
+            iterNode = iterNode->right;
+        }
+
+        *subtreeLink = buildBalanced(nodes, 0, nodes.size() - 1);
+    }
+
+    /* Function: subtreeSize
+     * Description: Counts the nodes in the passed subtree iteratively.
+    */ 
+    template <class K, class V>
+    static int subtreeSize(BSTNode<K,V>* currNode) {
+        int numNodes = 0;
+        std::vector<BSTNode<K,V>*> stack;
+
+        if (currNode != NULL) {
+            stack.push_back(currNode);
+        }
+
+        while (!stack.empty()) {
+            BSTNode<K,V>* iterNode = stack.back();
+            stack.pop_back();
+            numNodes++;
+
+            if (iterNode->left != NULL) {
+                stack.push_back(iterNode->left);
+            }
+
+            if (iterNode->right != NULL) {
+                stack.push_back(iterNode->right);
+            }
+        }
+
+        return numNodes;
+    }
+};
+
+//Splay balancing, every node reached by a lookup or put is rotated up to the root, so frequently used keys
+//gather near the top and their lookups touch only a few nodes. Operations take O(log n) amortized time.
+struct Splay {
+
+    static const bool ADJUSTS_ON_ACCESS = true;
+
+    template <class K, class V>
+    static void afterAccess(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path) {
+        splay(path, false);
+    }
+
+    template <class K, class V>
+    static void afterPut(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path, int numNodes, int& maxNodes) {
+        splay(path, false);
+    }
+
+    template <class K, class V>
+    static BSTNode<K,V>** prepareRemove(BSTNode<K,V>** removeLink) {
+        return removeLink;
+    }
+
+    template <class K, class V>
+    static void afterRemove(BSTNode<K,V>** rootLink, int numNodes, int& maxNodes) {}
+
+    template <class K, class V>
+    static bool validChild(BSTNode<K,V>* parentNode, BSTNode<K,V>* childNode) {
+        return true;
+    }
+
+    /* Function: splay
+     * Description: Moves the node at the end of the path up the tree with zig-zig and zig-zag steps, each of which
+     *              lifts it two levels. A full splay finishes with a single rotation to bring it to the root.
+     *              A semi-splay makes only the first rotation of each zig-zig step, lifting the parent instead of
+     *              the node and carrying on from the parent, which halves the path with about half the rotations.
+    */
+    template <class K, class V>
+    static void splay(std::vector<BSTNode<K,V>**>& path, bool semiSplay) {
+
+        while (path.size() > 2) {
+            BSTNode<K,V>** grandLink = path[path.size() - 3];
+            BSTNode<K,V>* grandNode = *grandLink;
+            BSTNode<K,V>* parentNode = *path[path.size() - 2];
+            BSTNode<K,V>* currNode = *path.back();
+            bool currIsLeft = parentNode->left == currNode;
+            bool parentIsLeft = grandNode->left == parentNode;
+
+            //Zig-zig, rotate the parent over the grandparent, then the node over the parent
+            if (currIsLeft == parentIsLeft) {
+                *grandLink = parentIsLeft ? rotateRight(grandNode) : rotateLeft(grandNode);
+
+                if (!semiSplay) {
+                    *grandLink = currIsLeft ? rotateRight(parentNode) : rotateLeft(parentNode);
+                }
+            }
+
+            //Zig-zag, rotate the node over the parent, then over the grandparent
+            else {
+                BSTNode<K,V>** parentLink = parentIsLeft ? &grandNode->left : &grandNode->right;
+                *parentLink = currIsLeft ? rotateRight(parentNode) : rotateLeft(parentNode);
+                *grandLink = parentIsLeft ? rotateRight(grandNode) : rotateLeft(grandNode);
+            }
+
+            path.pop_back();
+            path.pop_back();
+        }
+
+        //Zig, the node is a child of the root
+        if (path.size() == 2 && !semiSplay) {
+            BSTNode<K,V>* rootNode = *path[0];
+            *path[0] = rootNode->left == *path[1] ? rotateRight(rootNode) : rotateLeft(rootNode);
+        }
+    }
+};
+
+//Semi-splay balancing, a cheaper splay that halves the path to each node reached instead of moving it to the root.
+//Hot keys still rise towards the root over repeated accesses, with fewer rotations (and writes) per lookup.
+struct SemiSplay : Splay {
+
+    template <class K, class V>
+    static void afterAccess(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path) {
+        splay(path, true);
+    }
+
+    template <class K, class V>
+    static void afterPut(BSTNode<K,V>** rootLink, std::vector<BSTNode<K,V>**>& path, int numNodes, int& maxNodes) {
+        splay(path, true);
+    }
+};
+
+//BST class to store nodes in a binary-search tree format
+//The Balance policy (Unbalanced, Treap, Scapegoat, Splay or SemiSplay) decides how the tree is kept balanced
+//Nodes are created through the Allocator (NodeArena, HeapAllocator or PmrAllocator) and all released when the tree is destroyed
+template <typename K, typename V, typename Balance = Unbalanced, template <class> class Allocator = NodeArena>
+class BST {
+    private:
+        BSTNode<K,V> *root = NULL;
+        int numNodes = 0;
+        int maxNodes = 0;
+        std::vector<BSTNode<K,V>**> path;
+        Allocator<BSTNode<K,V> > nodes;
+        TREE_STAT(TreeStats stats;)
+
+        template <typename Key>
+        BSTNode<K,V>* accessNode(const Key& searchKey);
+        template <typename Key, typename Value>
+        void assignOrInsert(Key&& newKey, Value&& newValue);
+        template <typename Iterator>
+        BSTNode<K,V>* buildBalanced(Iterator& iter, int numKeys, unsigned int maxPriority);
+        template <typename Key>
+        BSTNode<K,V>* findNode(const Key& searchKey);
+        BSTNode<K,V>* getMax(BSTNode<K,V>* currNode);
+        template <typename Key, typename... Args>
+        bool insertIfMissing(Key&& newKey, Args&&... args);
+        template <typename Create, typename Found>
+        void put(const K& newKey, Create& create, Found& found);
+
+    public:
+        void clear();
+        template <typename Value>
+        void put(const K& newKey, Value&& newValue);
+        template <typename Value>
+        void put(K&& newKey, Value&& newValue);
+        template <typename Key, typename Value>
+        bool emplace(Key&& newKey, Value&& newValue);
+        template <typename... Args>
+        bool tryEmplace(const K& newKey, Args&&... args);
+        template <typename... Args>
+        bool tryEmplace(K&& newKey, Args&&... args);
+        template <typename Key>
+        V get(const Key& searchKey);
+        template <typename Key>
+        V* find(const Key& searchKey);
+        template <typename Key>
+        bool contains(const Key& searchKey);
+        template <typename Key>
+        void remove(const Key& searchKey);
+        V min();
+        V max();
+        bool load(const char* path);
+        bool save(const char* path);
+        int size();
+        bool validate();
+
+        //Counters and latency histograms, compiled in with -DTREE_STATS (see treeStats.h)
+        TREE_STAT(const TreeStats& getStats() { return stats; })
+        TREE_STAT(void resetStats() { stats.reset(); })
+
+        BST() {}
+
+        //Takes every node from the resource, for a tree using PmrAllocator (see nodeAllocators.h)
+        BST(std::pmr::memory_resource* resource) : nodes(resource) {}
+
+        BST(const BST&) = delete;
+        BST& operator=(const BST&) = delete;
+
+        ~BST() {
+            clear();
+        }
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: accessNode
+ * Description: Returns the node holding the search key, or NULL if there is none, for the public lookups.
+ *              When the balancing policy adjusts on access, the path is recorded and handed to it afterwards,
+ *              ending at the found node or, on a miss, at the last node reached (as a splay tree requires).
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key>
+BSTNode<K,V>* BST<K,V,Balance,Allocator>::accessNode(const Key& searchKey) {
+    if (!Balance::ADJUSTS_ON_ACCESS) {
+        return findNode(searchKey);
+    }
+
+    BSTNode<K,V>** link = &root;
+    BSTNode<K,V>* foundNode = NULL;
+    path.clear();
+
+    while (*link != NULL) {
+        path.push_back(link);
+        TREE_STAT(treeOpDepth++;)
+
+        if (searchKey < (*link)->key) {
+            TREE_STAT(stats.comparisons++;)
+            link = &(*link)->left;
+        }
+
+        else if (searchKey > (*link)->key) {
+            TREE_STAT(stats.comparisons += 2;)
+            link = &(*link)->right;
+        }
+
+        else {
+            TREE_STAT(stats.comparisons += 2;)
+            foundNode = *link;
+            break;
+        }
+    }
+
+    if (!path.empty()) {
+        Balance::afterAccess(&root, path);
+    }
+
+    return foundNode;
+}
+
+/* Function: assignOrInsert
+ * Description: Replaces the value under the key, or inserts a new node for it. The key is only compared by reference
+ *              on the way down, and is forwarded (copied or moved) into a node only when one has to be created.
+ * 
+ * Param: Key&& newKey, Value&& newValue
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key, typename Value>
+void BST<K,V,Balance,Allocator>::assignOrInsert(Key&& newKey, Value&& newValue) {
+    TREE_STAT(OpTimer timer(stats, TREE_PUT);)
+
+    //Only one of create and assign runs, so the value is forwarded once
+    auto create = [&]() {
+        TREE_STAT(stats.allocations++;)
+        return nodes.create(std::piecewise_construct, std::forward<Key>(newKey), std::forward<Value>(newValue));
+    };
+
+    auto assign = [&](BSTNode<K,V>* foundNode) {
+        foundNode->value = std::forward<Value>(newValue);
+    };
+
+    put(newKey, create, assign);
+}
+
+/* Function: buildBalanced
+ * Description: Builds a perfectly balanced subtree from the next numKeys sorted pairs, in order, and returns its root.
+ *              Each node is given the priority a random treap of the same size would give its root (the largest of
+ *              numKeys random draws below the parent's priority), so the tree stays a valid treap for later puts.
+ * 
+ * Param: Iterator& iter, int numKeys, unsigned int maxPriority
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Iterator>
+BSTNode<K,V>* BST<K,V,Balance,Allocator>::buildBalanced(Iterator& iter, int numKeys, unsigned int maxPriority) {
+    if (numKeys == 0) {
+        return NULL;
+    }
+
+    double draw = (rand() + 1.0) / ((double) RAND_MAX + 1.0);
+    unsigned int priority = (unsigned int) (maxPriority * pow(draw, 1.0 / numKeys));
+    int leftKeys = (numKeys - 1) / 2;
+
+    BSTNode<K,V>* leftNode = buildBalanced(iter, leftKeys, priority);
+    BSTNode<K,V>* currNode = nodes.create(iter->first, iter->second);
+    TREE_STAT(stats.allocations++;)
+    ++iter;
+
+    currNode->priority = priority;
+    currNode->left = leftNode;
+    currNode->right = buildBalanced(iter, numKeys - 1 - leftKeys, priority);
+    return currNode;
+}
+
+/* Function: findNode
+ * Description: Returns the node holding the search key, or NULL if there is none. The search key may be of any type
+ *              that compares with K (e.g. a const char* against string keys), so no K has to be built to look it up.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key>
+BSTNode<K,V>* BST<K,V,Balance,Allocator>::findNode(const Key& searchKey) {
+    BSTNode<K,V>* iter = root;
+
+    while (iter != NULL) {
+        TREE_STAT(treeOpDepth++;)
+
+        if (searchKey < iter->key) {
+            TREE_STAT(stats.comparisons++;)
+            iter = iter->left;
+        }
+
+        else if (searchKey > iter->key) {
+            TREE_STAT(stats.comparisons += 2;)
+            iter = iter->right;
+        }
+
+        else {
+            TREE_STAT(stats.comparisons += 2;)
+            return iter;
+        }
+    }
+
+    return NULL;
+}
+
+/* Function: insertIfMissing
+ * Description: Inserts a node for the key, building its value in place from the arguments, unless the key is
+ *              already in the tree. Returns whether a node was inserted. Nothing is built when the key is present.
+ * 
+ * Param: Key&& newKey, Args&&... args
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key, typename... Args>
+bool BST<K,V,Balance,Allocator>::insertIfMissing(Key&& newKey, Args&&... args) {
+    TREE_STAT(OpTimer timer(stats, TREE_PUT);)
+    bool inserted = true;
+
+    auto create = [&]() {
+        TREE_STAT(stats.allocations++;)
+        return nodes.create(std::piecewise_construct, std::forward<Key>(newKey), std::forward<Args>(args)...);
+    };
+
+    auto skip = [&](BSTNode<K,V>* foundNode) {
+        inserted = false;
+    };
+
+    put(newKey, create, skip);
+    return inserted;
+}
+
+/* Function: put
+ * Description: Links a node for the key into the BST, organized by key. This function searches the tree iteratively,
+ *              comparing the key by reference and recording the path for the balancing policy. At the bottom the
+ *              node is made by create; if the key is already present, found is called on its node instead
+ *              and the policy is given the path through afterAccess.
+ * 
+ * Param: const K& newKey, Create& create, Found& found
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Create, typename Found>
+void BST<K,V,Balance,Allocator>::put(const K& newKey, Create& create, Found& found) {
+    BSTNode<K,V>** link = &root;
+    path.clear();
+
+    while (*link != NULL) {
+        path.push_back(link);
+        TREE_STAT(treeOpDepth++;)
+
+        if (newKey < (*link)->key) {
+            TREE_STAT(stats.comparisons++;)
+            link = &(*link)->left;
+        }
+
+        else if (newKey > (*link)->key) {
+            TREE_STAT(stats.comparisons += 2;)
+            link = &(*link)->right;
+        }
+
+        else {
+            TREE_STAT(stats.comparisons += 2;)
+            found(*link);
+            Balance::afterAccess(&root, path);
+            return;
+        }
+    }
+
+    *link = create();
+    path.push_back(link);
+    numNodes++;
+
+    Balance::afterPut(&root, path, numNodes, maxNodes);
+}
+
+//PUBLIC FUNCTIONS
+
+/* Function: clear
+ * Description: Removes every node from the tree. When the allocator can release all of its memory at once
+ *              and the nodes need no destructor, the nodes are never visited. Otherwise the nodes are
+ *              destroyed iteratively, since an unbalanced tree may be too deep to recurse through.
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+void BST<K,V,Balance,Allocator>::clear() {
+
+    if (!Allocator<BSTNode<K,V> >::RELEASES_ALL || !std::is_trivially_destructible<BSTNode<K,V> >::value) {
+        std::vector<BSTNode<K,V>*> stack;
+
+        if (root != NULL) {
+            stack.push_back(root);
+        }
+
+        while (!stack.empty()) {
+            BSTNode<K,V>* currNode = stack.back();
+            stack.pop_back();
+
+            if (currNode->left != NULL) {
+                stack.push_back(currNode->left);
+            }
+
+            if (currNode->right != NULL) {
+                stack.push_back(currNode->right);
+            }
+
+            nodes.destroy(currNode);
+            TREE_STAT(stats.frees++;)
+        }
+    }
+
+    nodes.releaseAll();
+    root = NULL;
+    numNodes = 0;
+    maxNodes = 0;
+}
+
+/* Function: contains
+ * Description: Searches for a node with the given key and returns whether or not it appears in the tree.
+ *              The key may be of any type that compares with K.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key>
+bool BST<K,V,Balance,Allocator>::contains(const Key& searchKey) {
+    return accessNode(searchKey) != NULL;
+}
+
+/* Function: emplace
+ * Description: Inserts a node built from the forwarded key and value unless the key is already in the tree, and
+ *              returns whether it was inserted. Like std::map::emplace the node is built before the search, so it
+ *              is built and thrown away if the key is present; tryEmplace builds nothing in that case.
+ * 
+ * Param: Key&& newKey, Value&& newValue
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key, typename Value>
+bool BST<K,V,Balance,Allocator>::emplace(Key&& newKey, Value&& newValue) {
+    TREE_STAT(OpTimer timer(stats, TREE_PUT);)
+    BSTNode<K,V>* newNode = nodes.create(std::piecewise_construct, std::forward<Key>(newKey), std::forward<Value>(newValue));
+    bool inserted = true;
+    TREE_STAT(stats.allocations++;)
+
+    auto create = [newNode]() {
+        return newNode;
+    };
+
+    auto skip = [&](BSTNode<K,V>* foundNode) {
+        inserted = false;
+    };
+
+    put(newNode->key, create, skip);
+
+    if (!inserted) {
+        nodes.destroy(newNode);
+        TREE_STAT(stats.frees++;)
+    }
+
+    return inserted;
+}
+
+/* Function: find
+ * Description: Returns a pointer to the value stored under the key, or NULL if it is missing, without copying the
+ *              value. The key may be of any type that compares with K. The pointer is valid until the key is removed.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key>
+V* BST<K,V,Balance,Allocator>::find(const Key& searchKey) {
+    TREE_STAT(OpTimer timer(stats, TREE_GET);)
+    BSTNode<K,V>* foundNode = accessNode(searchKey);
+
+    if (foundNode == NULL) {
+        return NULL;
+    }
+
+    return &foundNode->value;
+}
+
+/* Function: get
+ * Description: Searches for a node with the given key and returns a copy of its value, or V() if it is missing.
+ *              The key may be of any type that compares with K. Use find to read the value without a copy.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key>
+V BST<K,V,Balance,Allocator>::get(const Key& searchKey) {
+    TREE_STAT(OpTimer timer(stats, TREE_GET);)
+    BSTNode<K,V>* foundNode = accessNode(searchKey);
+
+    if (foundNode == NULL) {
+        return V();
+    }
+
+    return foundNode->value;
+}
+
+/* Function: load
+ * Description: Replaces the contents of the tree with a snapshot written by save (from a BST or a RedBlack).
+ *              The file is mapped and its sorted pairs are linked into a balanced tree in O(n), whatever the policy.
+ *              Returns false, leaving the tree unchanged, if the file is missing, corrupt or of another key/value type.
+ * 
+ * Param: const char* path
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+bool BST<K,V,Balance,Allocator>::load(const char* path) {
+    MappedSnapshot<K,V> snapshot(path);
+
+    if (!snapshot.isValid()) {
+        return false;
+    }
+
+    clear();
+
+    MappedPairIterator<K,V> iter = snapshot.begin();
+    root = buildBalanced(iter, snapshot.size(), RAND_MAX);
+    numNodes = snapshot.size();
+    maxNodes = numNodes;
+    return true;
+}
+
+/* Function: max
+ * Description: Returns the value of the maximum key node in the tree.
+ * 
+ * Param: K newKey, V newValue
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+V BST<K,V,Balance,Allocator>::max() {
+    BSTNode<K,V>* iterNode = root;
+
+   while (iterNode->right != NULL) {
+       iterNode = iterNode->right;
+   }
+
+   return iterNode->value;
+}
+
+/* Function: min
+ * Description: Returns the value of the minimum key node in the tree.
+ * 
+ * Param: K newKey, V newValue
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+V BST<K,V,Balance,Allocator>::min() {
+    BSTNode<K,V>* iterNode = root;
+
+    while (iterNode->left != NULL) {
+       iterNode = iterNode->left;
+    }
+
+   return iterNode->value;
+}
+
+/* Function: put
+ * Description: Inserts the key and value into the BST, or replaces the value if the key is already present.
+ *              The key is copied into the tree only if a node is created; the value is copied or moved once.
+ * 
+ * Param: const K& newKey, Value&& newValue
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Value>
+void BST<K,V,Balance,Allocator>::put(const K& newKey, Value&& newValue) {
+    assignOrInsert(newKey, std::forward<Value>(newValue));
+}
+
+//Public put, moving the key into a new node
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Value>
+void BST<K,V,Balance,Allocator>::put(K&& newKey, Value&& newValue) {
+    assignOrInsert(std::move(newKey), std::forward<Value>(newValue));
+}
+
+/* Function: remove
+ * Description: Searches for the given key in the BST and removes it if found. Searching is iterative, and the key
+ *              may be of any type that compares with K. A node with two children is replaced by relinking its
+ *              in-order successor into its place.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename Key>
+void BST<K,V,Balance,Allocator>::remove(const Key& searchKey) {
+    TREE_STAT(OpTimer timer(stats, TREE_REMOVE);)
+    BSTNode<K,V>** link = &root;
+
+    while (*link != NULL && !(searchKey == (*link)->key)) {
+        TREE_STAT(treeOpDepth++;)
+        TREE_STAT(stats.comparisons += 2;)
+
+        if (searchKey < (*link)->key) {
+            link = &(*link)->left;
+        }
+
+        else {
+            link = &(*link)->right;
+        }
+    }
+
+    //Key not found
+    if (*link == NULL) {
+        return;
+    }
+
+    link = Balance::prepareRemove(link);
+    BSTNode<K,V>* removeNode = *link;
+
+    if (removeNode->left == NULL) {
+        *link = removeNode->right;
+    }
+
+    else if (removeNode->right == NULL) {
+        *link = removeNode->left;
+    }
+
+    else {
+
+        //Find the min node in the node to remove's right subtree
+        BSTNode<K,V>** successorLink = &removeNode->right;
+
+        while ((*successorLink)->left != NULL) {
+            successorLink = &(*successorLink)->left;
+        }
+
+        //Unlink the successor and move it into the removed node's place
+        BSTNode<K,V>* successorNode = *successorLink;
+        *successorLink = successorNode->right;
+        successorNode->left = removeNode->left;
+        successorNode->right = removeNode->right;
+        *link = successorNode;
+    }
+
+    nodes.destroy(removeNode);
+    TREE_STAT(stats.frees++;)
+    numNodes--;
+
+    Balance::afterRemove(&root, numNodes, maxNodes);
+}
+
+/* Function: save
+ * Description: Writes the tree's pairs in key order to a compact, pointer-free snapshot file (see treeSnapshot.h).
+ *              The tree is walked iteratively, since an unbalanced tree may be too deep to recurse through.
+ *              Only available for trivially copyable keys and values. Returns false if the file could not be written.
+ * 
+ * Param: const char* path
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+bool BST<K,V,Balance,Allocator>::save(const char* path) {
+    return writeSnapshot<K,V>(path, numNodes, [this](auto callback) {
+        std::vector<BSTNode<K,V>*> stack;
+        BSTNode<K,V>* iterNode = root;
+
+        while (iterNode != NULL || !stack.empty()) {
+            while (iterNode != NULL) {
+                stack.push_back(iterNode);
+                iterNode = iterNode->left;
+            }
+
+            iterNode = stack.back();
+            stack.pop_back();
+            callback(iterNode->key, iterNode->value);
+            iterNode = iterNode->right;
+        }
+    });
+}
+
+//Return number of nodes in the tree
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+int BST<K,V,Balance,Allocator>::size() {
+    return numNodes;
+}
+
+/* Function: tryEmplace
+ * Description: Inserts the key with a value built in place from the arguments, unless the key is already in the
+ *              tree, and returns whether it was inserted. Neither the key nor the value is built if it is present.
+ * 
+ * Param: const K& newKey, Args&&... args
+*/ 
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename... Args>
+bool BST<K,V,Balance,Allocator>::tryEmplace(const K& newKey, Args&&... args) {
+    return insertIfMissing(newKey, std::forward<Args>(args)...);
+}
+
+//Public tryEmplace, moving the key into the new node
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+template <typename... Args>
+bool BST<K,V,Balance,Allocator>::tryEmplace(K&& newKey, Args&&... args) {
+    return insertIfMissing(std::move(newKey), std::forward<Args>(args)...);
+}
+
+/* Function: validate
+ * Description: Checks that the keys are in BST order, that every link keeps the balancing policy's ordering
+ *              (heap order by priority for a Treap) and that the node count is right, for canary builds and tests.
+ *              The tree is walked iteratively, since an unbalanced tree may be too deep to recurse through.
+ *              Prints the first broken invariant and returns false. Takes O(n) time.
+*/
+template <typename K, typename V, typename Balance, template <class> class Allocator>
+bool BST<K,V,Balance,Allocator>::validate() {
+    std::vector<BSTNode<K,V>*> stack;
+    BSTNode<K,V>* iterNode = root;
+    BSTNode<K,V>* prevNode = NULL;
+    int numSeen = 0;
+
+    while (iterNode != NULL || !stack.empty()) {
+        while (iterNode != NULL) {
+            stack.push_back(iterNode);
+            iterNode = iterNode->left;
+        }
+
+        iterNode = stack.back();
+        stack.pop_back();
+        numSeen++;
+
+        if (prevNode != NULL && !(prevNode->key < iterNode->key)) {
+            cout << "Error: Keys are out of order." << endl;
+            return false;
+        }
+
+        if ((iterNode->left != NULL && !Balance::validChild(iterNode, iterNode->left)) ||
+            (iterNode->right != NULL && !Balance::validChild(iterNode, iterNode->right))) {
+            cout << "Error: A link breaks the balancing policy's ordering." << endl;
+            return false;
+        }
+
+        prevNode = iterNode;
+        iterNode = iterNode->right;
+    }
+
+    if (numSeen != numNodes) {
+        cout << "Error: BSTNode count is " << numNodes << " but the tree holds " << numSeen << " nodes." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,126 @@
+/* DESCRIPTION OF PROGRAM
+
+    Benchmarks and test driver for the PersistentRedBlack tree (see persistentRedBlackTree.h).
+
+    Usage: persistentRedBlackTree [--benchmark [numKeys]]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+
+#include "persistentRedBlackTree.h"
+
+//BENCHMARKS
+
+/* Function: benchmarkReaders
+ * Description: Runs the passed number of reader threads doing random lookups for one second while a single writer
+ *              keeps replacing random keys, and prints the total reader and writer throughput. Readers either take
+ *              a snapshot per 1000 lookups, or call the tree's get, which takes a snapshot (and a reader slot) on
+ *              every call.
+ *
+ * Param: int numReaders, int numKeys, bool perCallSnapshots
+*/
+void benchmarkReaders(int numReaders, int numKeys, bool perCallSnapshots) {
+    PersistentRedBlack<int,int>* tree = new PersistentRedBlack<int,int>();
+    std::atomic<bool> running(true);
+    std::atomic<long long> numReads(0);
+    std::atomic<long long> checksum(0);
+    long long numWrites = 0;
+
+    for (int i = 0; i < numKeys; i++) {
+        tree->put(i, i);
+    }
+
+    std::vector<std::thread> readerThreads;
+
+    for (int i = 0; i < numReaders; i++) {
+        readerThreads.push_back(std::thread([&, i]() {
+            unsigned int seed = i + 1;
+            long long localReads = 0;
+            long long localChecksum = 0;
+
+            while (running.load(std::memory_order_relaxed)) {
+                if (perCallSnapshots) {
+                    for (int j = 0; j < 1000; j++) {
+                        seed = seed * 1103515245 + 12345;
+                        localChecksum += tree->get((seed >> 8) % numKeys);
+                    }
+                }
+
+                else {
+                    Snapshot<int,int> view = tree->snapshot();
+
+                    for (int j = 0; j < 1000; j++) {
+                        seed = seed * 1103515245 + 12345;
+                        localChecksum += view.get((seed >> 8) % numKeys);
+                    }
+                }
+
+                localReads += 1000;
+            }
+
+            numReads += localReads;
+            checksum += localChecksum;
+        }));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) {
+        int key = rand() % numKeys;
+        tree->put(key, key + 1);
+        numWrites++;
+    }
+
+    running.store(false);
+
+    for (std::thread& readerThread : readerThreads) {
+        readerThread.join();
+    }
+
+    cout << numReaders << " readers" << (perCallSnapshots ? ", snapshot per get: " : ", snapshot per 1000 gets: ")
+         << numReads.load() << " reads/s, " << numWrites << " writes/s (checksum " << checksum.load() << ")" << endl;
+    delete tree;
+}
+
+//Runs the reader benchmark on doubling numbers of readers, up to 32, with both kinds of reader
+void runBenchmarks(int numKeys) {
+    for (int numReaders = 1; numReaders <= 32; numReaders *= 2) {
+        benchmarkReaders(numReaders, numKeys, false);
+        benchmarkReaders(numReaders, numKeys, true);
+    }
+}
+
+//Driver for testing
+int main(int argc, char** argv) {
+
+    //Benchmarks (run with --benchmark [numKeys])
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "--benchmark") != 0 || argc > 3) {
+            cout << "Usage: " << argv[0] << " [--benchmark [numKeys]]" << endl;
+            return 1;
+        }
+
+        runBenchmarks(argc == 3 ? std::max(1000, atoi(argv[2])) : 1000000);
+        return 0;
+    }
+
+    // PersistentRedBlack<int,string>* testTree = new PersistentRedBlack<int,string>();
+
+    // testTree->put(1,"Alpha");
+    // testTree->put(3,"Charlie");
+    // testTree->put(6,"Frank");
+
+    // {
+    //     Snapshot<int,string> view = testTree->snapshot();
+    //     testTree->put(8,"Hotel");
+    //     testTree->remove(1);
+    //     cout << view.size() << " " << view.get(1) << " " << view.contains(8) << endl;
+    // }
+
+    // cout << testTree->get(8) << " " << testTree->contains(1) << endl;
+    // delete testTree;
+}
@@ -0,0 +1,739 @@
+/* DESCRIPTION OF FILE
+
+    This file implements a persistent (path-copying) left-leaning red-black tree for one writer and
+    many concurrent readers. The balancing follows the RedBlack tree in redBlackTree.h, except that a
+    node is never changed once it has been published: put and remove copy each node on the root-to-leaf
+    path before changing it, and publish the new root atomically.
+
+    Readers take a Snapshot, which pins the version they read without any locking. Nodes replaced by a
+    write are retired with the version that replaced them, and are freed once every active snapshot was
+    taken at or after that version.
+*/
+
+#ifndef PERSISTENT_RED_BLACK_TREE_H
+#define PERSISTENT_RED_BLACK_TREE_H
+
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+using namespace std;
+
+//Link colours, also defined by redBlackTree.h so the two headers can be included together
+#ifndef RED_BLACK_COLOURS
+#define RED_BLACK_COLOURS
+const bool RED = true;
+const bool BLACK = false;
+#endif
+
+//PersistentNode class for all key-value pairs in the PersistentRedBlack
+//version is the write that created the node, only that write may change it
+template <class K, class V>
+class PersistentNode {
+
+    public:
+        K key;
+        V value;
+        PersistentNode<K,V>* left;
+        PersistentNode<K,V>* right;
+        bool colour;
+        int size;
+        uint64_t version;
+
+        PersistentNode(K newKey, V newValue, bool nodeColour, uint64_t newVersion) {
+            key = newKey;
+            value = newValue;
+            left = NULL;
+            right = NULL;
+            colour = nodeColour;
+            size = 1;
+            version = newVersion;
+        }
+};
+
+//Reader slot holding the version a snapshot was taken at, padded to a cache line so readers never share one
+struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> version;
+};
+
+const uint64_t FREE_SLOT = UINT64_MAX;
+
+//Read-only view of one version of a PersistentRedBlack tree. Holding a snapshot keeps that version's nodes alive.
+template <class K, class V>
+class Snapshot {
+
+    private:
+        PersistentNode<K,V>* root;
+        ReaderSlot* slot;
+
+        template <typename Callback>
+        void rangeScan(PersistentNode<K,V>* currNode, K lowKey, K highKey, Callback& callback);
+
+    public:
+        bool contains(K searchKey);
+        V get(K searchKey);
+        V min();
+        V max();
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        int size();
+
+        Snapshot(PersistentNode<K,V>* root, ReaderSlot* slot) {
+            this->root = root;
+            this->slot = slot;
+        }
+
+        Snapshot(Snapshot&& other) {
+            root = other.root;
+            slot = other.slot;
+            other.slot = NULL;
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        ~Snapshot() {
+            if (slot != NULL) {
+                slot->version.store(FREE_SLOT);
+            }
+        }
+};
+
+//PersistentRedBlack class, a red-black tree with one writer at a time and lock-free snapshot readers
+template <typename K, typename V>
+class PersistentRedBlack {
+    private:
+        static const int MAX_READERS = 64;
+
+        std::atomic<PersistentNode<K,V>*> root;
+        std::atomic<uint64_t> version;
+        ReaderSlot readers[MAX_READERS];
+        std::mutex writeLock;
+
+        //Version of the write in progress and the nodes it has replaced so far
+        uint64_t writeVersion;
+        std::deque<std::pair<PersistentNode<K,V>*, uint64_t> > retired;
+
+        void beginWrite();
+        void endWrite(PersistentNode<K,V>* newRoot);
+        PersistentNode<K,V>* fixImbalances(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* flipColours(PersistentNode<K,V>* currNode);
+        bool isRed(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* moveRedLeft(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* moveRedRight(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* own(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* put(PersistentNode<K,V>* currNode, K newKey, V newValue);
+        void reclaim();
+        PersistentNode<K,V>* remove(PersistentNode<K,V>* currNode, K searchKey);
+        PersistentNode<K,V>* removeMin(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* removeMax(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* rotateLeft(PersistentNode<K,V>* currNode);
+        PersistentNode<K,V>* rotateRight(PersistentNode<K,V>* currNode);
+        int subtreeSize(PersistentNode<K,V>* currNode);
+        void updateSize(PersistentNode<K,V>* currNode);
+
+    public:
+        bool contains(K searchKey);
+        V get(K searchKey);
+        void put(K newKey, V newValue);
+        void remove(K searchKey);
+        void removeMin();
+        void removeMax();
+        Snapshot<K,V> snapshot();
+
+        PersistentRedBlack() {
+            root.store(NULL);
+            version.store(0);
+            writeVersion = 0;
+
+            for (int i = 0; i < MAX_READERS; i++) {
+                readers[i].version.store(FREE_SLOT);
+            }
+        }
+
+        PersistentRedBlack(const PersistentRedBlack&) = delete;
+        PersistentRedBlack& operator=(const PersistentRedBlack&) = delete;
+
+        ~PersistentRedBlack();
+};
+
+//SNAPSHOT FUNCTIONS
+
+/* Function: rangeScan
+ * Description: Calls the callback on each node of the subtree with a key between lowKey and highKey, in order.
+ *
+ * Param: PersistentNode<K,V>* currNode, K lowKey, K highKey, Callback& callback
+*/
+template <class K, class V>
+template <typename Callback>
+void Snapshot<K,V>::rangeScan(PersistentNode<K,V>* currNode, K lowKey, K highKey, Callback& callback) {
+
+    if (currNode == NULL) {
+        return;
+    }
+
+    if (lowKey < currNode->key) {
+        rangeScan(currNode->left, lowKey, highKey, callback);
+    }
+
+    if (!(currNode->key < lowKey) && !(currNode->key > highKey)) {
+        callback(currNode->key, currNode->value);
+    }
+
+    if (highKey > currNode->key) {
+        rangeScan(currNode->right, lowKey, highKey, callback);
+    }
+}
+
+//Returns whether the key appears in this version of the tree
+template <class K, class V>
+bool Snapshot<K,V>::contains(K searchKey) {
+    PersistentNode<K,V>* iter = root;
+
+    while (iter != NULL) {
+        if (searchKey < iter->key) {
+            iter = iter->left;
+        }
+
+        else if (searchKey > iter->key) {
+            iter = iter->right;
+        }
+
+        else {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//Returns the value for the key in this version of the tree, or V() if it is not found
+template <class K, class V>
+V Snapshot<K,V>::get(K searchKey) {
+    PersistentNode<K,V>* iter = root;
+
+    while (iter != NULL) {
+        if (searchKey < iter->key) {
+            iter = iter->left;
+        }
+
+        else if (searchKey > iter->key) {
+            iter = iter->right;
+        }
+
+        else {
+            return iter->value;
+        }
+    }
+
+    return V();
+}
+
+//Returns the value of the maximum key in this version of the tree, or V() if it is empty
+template <class K, class V>
+V Snapshot<K,V>::max() {
+    PersistentNode<K,V>* iterNode = root;
+
+    if (iterNode == NULL) {
+        return V();
+    }
+
+    while (iterNode->right != NULL) {
+        iterNode = iterNode->right;
+    }
+
+    return iterNode->value;
+}
+
+//Returns the value of the minimum key in this version of the tree, or V() if it is empty
+template <class K, class V>
+V Snapshot<K,V>::min() {
+    PersistentNode<K,V>* iterNode = root;
+
+    if (iterNode == NULL) {
+        return V();
+    }
+
+    while (iterNode->left != NULL) {
+        iterNode = iterNode->left;
+    }
+
+    return iterNode->value;
+}
+
+//Calls the callback with each key and value between lowKey and highKey (inclusive), in key order
+template <class K, class V>
+template <typename Callback>
+void Snapshot<K,V>::rangeScan(K lowKey, K highKey, Callback callback) {
+    rangeScan(root, lowKey, highKey, callback);
+}
+
+//Return number of nodes in this version of the tree
+template <class K, class V>
+int Snapshot<K,V>::size() {
+    return root == NULL ? 0 : root->size;
+}
+
+//PRIVATE FUNCTIONS
+
+/* Function: beginWrite
+ * Description: Starts a new write version. Nodes from earlier versions are copied before they are changed.
+*/
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::beginWrite() {
+    writeVersion = version.load() + 1;
+}
+
+/* Function: endWrite
+ * Description: Publishes the new root, then the new version, and frees any retired nodes no snapshot can reach.
+ *              The root is stored before the version, so a reader that sees the new version also sees the new root.
+ *              The old root was copied (and retired) by the write, so every node it replaced is already retired.
+ *
+ * Param: PersistentNode<K,V>* newRoot
+*/
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::endWrite(PersistentNode<K,V>* newRoot) {
+
+    if (newRoot != NULL && newRoot->colour != BLACK) {
+        newRoot = own(newRoot);
+        newRoot->colour = BLACK;
+    }
+
+    root.store(newRoot);
+    version.store(writeVersion);
+    reclaim();
+}
+
+/* Function: fixImbalances
+ * Description: Restores the left-leaning red-black shape at a node owned by the current write.
+ *
+ * Param: PersistentNode<K,V>* currNode
+*/
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::fixImbalances(PersistentNode<K,V>* currNode) {
+
+    if (isRed(currNode->right)) {
+        currNode = rotateLeft(currNode);
+    }
+
+    if (isRed(currNode->left) && isRed(currNode->left->left)) {
+        currNode = rotateRight(currNode);
+    }
+
+    if (isRed(currNode->left) && isRed(currNode->right)) {
+        currNode = flipColours(currNode);
+    }
+
+    updateSize(currNode);
+    return currNode;
+}
+
+/* Function: flipColours
+ * Description: Flips the colour of an owned node and its two children, copying the children first.
+ *
+ * Param: currNode (The current node to flip)
+*/
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::flipColours(PersistentNode<K,V>* currNode) {
+    currNode->left = own(currNode->left);
+    currNode->right = own(currNode->right);
+
+    currNode->colour = !currNode->colour;
+    currNode->left->colour = !currNode->left->colour;
+    currNode->right->colour = !currNode->right->colour;
+    return currNode;
+}
+
+//Returns whether or not the passed node is RED. (NULL == BLACK).
+template <typename K, typename V>
+bool PersistentRedBlack<K,V>::isRed(PersistentNode<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return false;
+    }
+
+    return currNode->colour == RED;
+}
+
+//Borrows a red node from the right sibling during deletion (see RedBlack::moveRedLeft)
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::moveRedLeft(PersistentNode<K,V>* currNode) {
+    currNode = flipColours(currNode);
+
+    if (isRed(currNode->right->left)) {
+        currNode->right = rotateRight(currNode->right);
+        currNode = rotateLeft(currNode);
+        currNode = flipColours(currNode);
+    }
+
+    return currNode;
+}
+
+//Borrows a red node from the left sibling during deletion (see RedBlack::moveRedRight)
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::moveRedRight(PersistentNode<K,V>* currNode) {
+    currNode = flipColours(currNode);
+
+    if (isRed(currNode->left->left)) {
+        currNode = rotateRight(currNode);
+        currNode = flipColours(currNode);
+    }
+
+    return currNode;
+}
+
+/* Function: own
+ * Description: Returns a node the current write may change. Nodes published by earlier versions are copied,
+ *              and the original is retired with the current write's version.
+ *
+ * Param: PersistentNode<K,V>* currNode
+*/
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::own(PersistentNode<K,V>* currNode) {
+
+    if (currNode == NULL || currNode->version == writeVersion) {
+        return currNode;
+    }
+
+    PersistentNode<K,V>* copyNode = new PersistentNode<K,V>(*currNode);
+    copyNode->version = writeVersion;
+    retired.push_back(std::make_pair(currNode, writeVersion));
+
+    return copyNode;
+}
+
+/* Function: put
+ * Description: Inserts the key and value below the passed node, copying each node on the path.
+ *
+ * Param: PersistentNode<K,V>* currNode, K newKey, V newValue
+*/
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::put(PersistentNode<K,V>* currNode, K newKey, V newValue) {
+    if (currNode == NULL) {
+        return new PersistentNode<K,V>(newKey, newValue, RED, writeVersion);
+    }
+
+    currNode = own(currNode);
+
+    if (newKey < currNode->key) {
+        currNode->left = put(currNode->left, newKey, newValue);
+    }
+
+    else if (newKey > currNode->key) {
+        currNode->right = put(currNode->right, newKey, newValue);
+    }
+
+    else {
+        currNode->value = newValue;
+    }
+
+    return fixImbalances(currNode);
+}
+
+/* Function: reclaim
+ * Description: Frees retired nodes once every active snapshot was taken at or after the version that retired them.
+ *              Nodes are retired in version order, so freeing stops at the first node still reachable.
+*/
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::reclaim() {
+    uint64_t oldestReader = FREE_SLOT;
+
+    for (int i = 0; i < MAX_READERS; i++) {
+        uint64_t readerVersion = readers[i].version.load();
+
+        if (readerVersion < oldestReader) {
+            oldestReader = readerVersion;
+        }
+    }
+
+    while (!retired.empty() && retired.front().second <= oldestReader) {
+        delete retired.front().first;
+        retired.pop_front();
+    }
+}
+
+/* Function: remove
+ * Description: Removes the key below the passed node (which must contain it), copying each node on the path.
+ *
+ * Param: PersistentNode<K,V>* currNode, K searchKey
+*/
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::remove(PersistentNode<K,V>* currNode, K searchKey) {
+    currNode = own(currNode);
+
+    if (searchKey < currNode->key) {
+        if (!isRed(currNode->left) && !isRed(currNode->left->left)) {
+            currNode = moveRedLeft(currNode);
+        }
+        currNode->left = remove(currNode->left, searchKey);
+    }
+
+    else {
+
+        if (isRed(currNode->left)) {
+            currNode = rotateRight(currNode);
+        }
+
+        //PersistentNode was found at the bottom of the tree, unlink it
+        if (searchKey == currNode->key && currNode->right == NULL) {
+            retired.push_back(std::make_pair(currNode, writeVersion));
+            return NULL;
+        }
+
+        if (!isRed(currNode->right) && !isRed(currNode->right->left)) {
+            currNode = moveRedRight(currNode);
+        }
+
+        if (currNode->key == searchKey) {
+            PersistentNode<K,V>* tempNode = currNode->right;
+
+            while (tempNode->left != NULL) {
+                tempNode = tempNode->left;
+            }
+
+            //Copy the successor's key and value into the (owned) node
+            currNode->key = tempNode->key;
+            currNode->value = tempNode->value;
+
+            currNode->right = removeMin(currNode->right);
+        }
+
+        else {
+            currNode->right = remove(currNode->right, searchKey);
+        }
+    }
+
+    return fixImbalances(currNode);
+}
+
+//Removes the maximum node below the passed node, copying each node on the path
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::removeMax(PersistentNode<K,V>* currNode) {
+    currNode = own(currNode);
+
+    if (isRed(currNode->left)) {
+        currNode = rotateRight(currNode);
+    }
+
+    if (currNode->right == NULL) {
+        retired.push_back(std::make_pair(currNode, writeVersion));
+        return NULL;
+    }
+
+    if (!isRed(currNode->right) && !isRed(currNode->right->left)) {
+        currNode = moveRedRight(currNode);
+    }
+
+    currNode->right = removeMax(currNode->right);
+    return fixImbalances(currNode);
+}
+
+//Removes the minimum node below the passed node, copying each node on the path
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::removeMin(PersistentNode<K,V>* currNode) {
+    currNode = own(currNode);
+
+    if (currNode->left == NULL) {
+        retired.push_back(std::make_pair(currNode, writeVersion));
+        return NULL;
+    }
+
+    if (!isRed(currNode->left) && !isRed(currNode->left->left)) {
+        currNode = moveRedLeft(currNode);
+    }
+
+    currNode->left = removeMin(currNode->left);
+    return fixImbalances(currNode);
+}
+
+//Left rotation of an owned node, copying the right child that moves up
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::rotateLeft(PersistentNode<K,V>* currNode) {
+    PersistentNode<K,V>* tempNode = own(currNode->right);
+    currNode->right = tempNode->left;
+    tempNode->left = currNode;
+    tempNode->colour = currNode->colour;
+    currNode->colour = RED;
+    tempNode->size = currNode->size;
+    updateSize(currNode);
+
+    return tempNode;
+}
+
+//Right rotation of an owned node, copying the left child that moves up
+template <typename K, typename V>
+PersistentNode<K,V>* PersistentRedBlack<K,V>::rotateRight(PersistentNode<K,V>* currNode) {
+    PersistentNode<K,V>* tempNode = own(currNode->left);
+    currNode->left = tempNode->right;
+    tempNode->right = currNode;
+    tempNode->colour = currNode->colour;
+    currNode->colour = RED;
+    tempNode->size = currNode->size;
+    updateSize(currNode);
+
+    return tempNode;
+}
+
+//Returns the number of nodes in the subtree (NULL == 0)
+template <typename K, typename V>
+int PersistentRedBlack<K,V>::subtreeSize(PersistentNode<K,V>* currNode) {
+    return currNode == NULL ? 0 : currNode->size;
+}
+
+//Recomputes the node's subtree size from its children
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::updateSize(PersistentNode<K,V>* currNode) {
+    currNode->size = 1 + subtreeSize(currNode->left) + subtreeSize(currNode->right);
+}
+
+//PUBLIC FUNCTIONS
+
+//Returns whether the key appears in the latest version of the tree
+template <typename K, typename V>
+bool PersistentRedBlack<K,V>::contains(K searchKey) {
+    return snapshot().contains(searchKey);
+}
+
+//Returns the value for the key in the latest version of the tree, or V() if it is not found
+template <typename K, typename V>
+V PersistentRedBlack<K,V>::get(K searchKey) {
+    return snapshot().get(searchKey);
+}
+
+/* Function: put
+ * Description: Publishes a new version of the tree with the key and value inserted.
+ *
+ * Param: K newKey, V newValue
+*/
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::put(K newKey, V newValue) {
+    std::lock_guard<std::mutex> guard(writeLock);
+
+    beginWrite();
+    endWrite(put(root.load(), newKey, newValue));
+}
+
+/* Function: remove
+ * Description: Publishes a new version of the tree with the key removed, if it was found.
+ *
+ * Param: K searchKey
+*/
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::remove(K searchKey) {
+    std::lock_guard<std::mutex> guard(writeLock);
+
+    if (!snapshot().contains(searchKey)) {
+        return;
+    }
+
+    beginWrite();
+    PersistentNode<K,V>* newRoot = own(root.load());
+
+    if (!isRed(newRoot->left) && !isRed(newRoot->right)) {
+        newRoot->colour = RED;
+    }
+
+    endWrite(remove(newRoot, searchKey));
+}
+
+//Publishes a new version of the tree without its maximum key
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::removeMax() {
+    std::lock_guard<std::mutex> guard(writeLock);
+
+    if (root.load() == NULL) {
+        return;
+    }
+
+    beginWrite();
+    PersistentNode<K,V>* newRoot = own(root.load());
+
+    if (!isRed(newRoot->left) && !isRed(newRoot->right)) {
+        newRoot->colour = RED;
+    }
+
+    endWrite(removeMax(newRoot));
+}
+
+//Publishes a new version of the tree without its minimum key
+template <typename K, typename V>
+void PersistentRedBlack<K,V>::removeMin() {
+    std::lock_guard<std::mutex> guard(writeLock);
+
+    if (root.load() == NULL) {
+        return;
+    }
+
+    beginWrite();
+    PersistentNode<K,V>* newRoot = own(root.load());
+
+    if (!isRed(newRoot->left) && !isRed(newRoot->right)) {
+        newRoot->colour = RED;
+    }
+
+    endWrite(removeMin(newRoot));
+}
+
+/* Function: snapshot
+ * Description: Returns a read-only snapshot of the latest version without locking. The reader's slot is set to the
+ *              current version before the root is loaded, so the writer cannot free any node the snapshot can reach.
+ *              Each thread starts looking at the slot it last used, first handed out round robin, so concurrent
+ *              readers keep to their own cache lines. Spins while all MAX_READERS slots are in use.
+*/
+template <typename K, typename V>
+Snapshot<K,V> PersistentRedBlack<K,V>::snapshot() {
+    static std::atomic<int> numReaderThreads{0};
+    thread_local int startSlot = numReaderThreads.fetch_add(1, std::memory_order_relaxed) % MAX_READERS;
+
+    for (int tried = 1, i = startSlot; ; tried++, i = (i + 1) % MAX_READERS) {
+        uint64_t freeSlot = FREE_SLOT;
+
+        if (readers[i].version.load(std::memory_order_relaxed) == FREE_SLOT &&
+            readers[i].version.compare_exchange_strong(freeSlot, version.load())) {
+            startSlot = i;
+            return Snapshot<K,V>(root.load(), &readers[i]);
+        }
+
+        if (tried % MAX_READERS == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/* Function: ~PersistentRedBlack
+ * Description: Frees the latest version and every retired node. No snapshots may still be held.
+*/
+template <typename K, typename V>
+PersistentRedBlack<K,V>::~PersistentRedBlack() {
+    std::vector<PersistentNode<K,V>*> stack;
+
+    if (root.load() != NULL) {
+        stack.push_back(root.load());
+    }
+
+    while (!stack.empty()) {
+        PersistentNode<K,V>* currNode = stack.back();
+        stack.pop_back();
+
+        if (currNode->left != NULL) {
+            stack.push_back(currNode->left);
+        }
+
+        if (currNode->right != NULL) {
+            stack.push_back(currNode->right);
+        }
+
+        delete currNode;
+    }
+
+    for (std::pair<PersistentNode<K,V>*, uint64_t>& retiredNode : retired) {
+        delete retiredNode.first;
+    }
+}
+
+#endif
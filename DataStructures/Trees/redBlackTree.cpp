@@ -1,580 +1,598 @@
 /* DESCRIPTION OF PROGRAM
 
-    This program implements a left-leaning red-black binary search tree.
-    Code was written by myself, but follows the code found here: 
-    https://algs4.cs.princeton.edu/33balanced/RedBlackBST.java.html
-    
-    Further understanding of the code was achieved through these lecture slides: 
-    https://algs4.cs.princeton.edu/lectures/keynote/33BalancedSearchTrees.pdf
+    Benchmarks and test driver for the RedBlack tree and the maps built on it (see redBlackTree.h).
+
+    Usage: redBlackTree [--benchmark [numKeys]]
 */
 
-#include <iostream>
+
+#include <algorithm>
+#include <chrono>
+#include <memory_resource>
+#include <stdlib.h>
 #include <string.h>
-using namespace std;
-
-const bool RED = true;
-const bool BLACK = false;
-
-//Node class for all key-value pairs in the RedBlack
-template <class K, class V>
-class Node {
-
-    public:
-        K key;
-        V value;
-        Node<K,V>* left;
-        Node<K,V>* right;
-        bool colour;
-        
-        Node(K newKey, V newValue, bool nodeColour) {
-            key = newKey;
-            value = newValue;
-            left = NULL;
-            right = NULL;
-            colour = nodeColour;
-        }
-};
-
-//RedBlack class to store nodes in a binary-search tree format
-template <typename K, typename V>
-class RedBlack {
-    private:
-        Node<K,V> *root = NULL;
-        
-        Node<K,V>* fixImbalances(Node<K,V>* currNode);  
-        Node<K,V>* flipColours(Node<K,V>* currNode);  
-        Node<K,V>* getMax(Node<K,V>* currNode);
-        Node<K,V>* getSuccessor(Node<K,V>* currNode);    
-        bool isRed(Node<K,V>* currNode);
-        void printInorder(Node<K,V>* currNode);
-        Node<K,V>* moveRedLeft(Node<K,V>* currNode);
-        Node<K,V>* moveRedRight(Node<K,V>* currNode);
-        void printPostorder(Node<K,V>* currNode);
-        void printPreorder(Node<K,V>* currNode);
-        Node<K,V>* put(Node<K,V>* root, K newKey, V newValue);
-        Node<K,V>* remove(Node<K,V>* currNode, K searchKey);
-        Node<K,V>* removeMin(Node<K,V>* currNode);
-        Node<K,V>* removeMax(Node<K,V>* currNode);
-        Node<K,V>* rotateLeft(Node<K,V>* currNode);
-        Node<K,V>* rotateRight(Node<K,V>* currNode);
-
-    public:
-        bool contains(K searchKey);
-        V get(K searchKey);
-        V min();
-        V max();
-        void printPreorder();
-        void printPostorder();
-        void printInorder();
-        void put(K newKey, V newValue);
-        void remove(K searchKey);
-        void removeMin();
-        void removeMax();
-};
-
-//PRIVATE FUNCTIONS
-
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::fixImbalances(Node<K,V>* currNode) {
-
-    if (isRed(currNode->right)) {
-        currNode = rotateLeft(currNode);
-    }
+#include <thread>
 
-    if (isRed(currNode->left) && isRed(currNode->left->left)) {
-        currNode = rotateRight(currNode);
-    }
+#include "redBlackTree.h"
 
-    if (isRed(currNode->left) && isRed(currNode->right)) {
-        currNode = flipColours(currNode);
-    }
+//REDBLACK BENCHMARKS
 
-    return currNode;
-}
-
-/* Function: flipColours
- * Description: Flips the colour of the passed node and its two child nodes to be the opposite colour.
+/* Function: benchmarkFrozen
+ * Description: Times random point lookups on a RedBlack tree against the EytzingerIndex frozen from it.
  *
- * Param: currNode (The current node to flip)
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::flipColours(Node<K,V>* currNode) {
-    currNode->colour = !currNode->colour;
-    currNode->left->colour = !currNode->left->colour;
-    currNode->right->colour = !currNode->right->colour;
-    return currNode;
-}
-
-/* Function: getSuccessor
- * Description: Used in node deletion to get the right subtree node for the node replacing the node being deleted.
- * 
- * Param: Node<K,V>* searchNode, K newKey, V newValue
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::getSuccessor(Node<K,V>* currNode) {
-    if (currNode->left == NULL) {
-        return currNode->right;
+ * Param: int numKeys, int numLookups
+*/
+void benchmarkFrozen(int numKeys, int numLookups) {
+    RedBlack<int,int>* tree = new RedBlack<int,int>();
+    std::vector<std::pair<int,int> > pairs;
+    std::vector<int> lookups(numLookups);
+    long long checksum = 0;
+
+    for (int i = 0; i < numKeys; i++) {
+        pairs.push_back(std::make_pair(2 * i, i));
     }
 
-    currNode->left = getSuccessor(currNode->left);
-    return currNode;
-}
+    for (int i = 0; i < numLookups; i++) {
+        lookups[i] = rand() % (2 * numKeys);
+    }
 
+    tree->buildFromSorted(pairs.begin(), pairs.end());
+    EytzingerIndex<int,int> index = tree->freeze();
 
-/* Function: isRed
- * Description: Returns whether or not the passed node is RED. (NULL == BLACK).
- * 
- * Param: Node<K,V>* currNode
-*/ 
-template <typename K, typename V>
-bool RedBlack<K,V>::isRed(Node<K,V>* currNode) {
-
-    if (currNode == NULL) {
-        return false;
+    auto start = std::chrono::steady_clock::now();
+    for (int key : lookups) {
+        checksum += tree->get(key);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int key : lookups) {
+        checksum -= index.get(key);
     }
+    auto end = std::chrono::steady_clock::now();
 
-    return currNode->colour == RED;
+    cout << numKeys << " keys (checksum " << checksum << "): RedBlack get "
+         << std::chrono::duration<double, std::nano>(middle - start).count() / numLookups << " ns/op, EytzingerIndex get "
+         << std::chrono::duration<double, std::nano>(end - middle).count() / numLookups << " ns/op" << endl;
+
+    delete tree;
 }
 
-/* Function: moveRedLeft
- * Description: Used in minimum node deletion when a red sibling is needed to be borrowed from another node.
- * This results in the node's left child or grand-child becoming red.
+/* Function: benchmarkBatched
+ * Description: Times random point lookups on a RedBlack tree one at a time with get against one batch with getMany.
  *
- * Param: currNode (The current node being viewed)
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::moveRedLeft(Node<K,V>* currNode) {
-    currNode = flipColours(currNode);
-
-    if (isRed(currNode->right->left)) {
-        currNode->right = rotateRight(currNode->right);
-        currNode = rotateLeft(currNode);
-        currNode = flipColours(currNode);
+ * Param: int numKeys, int numLookups
+*/
+void benchmarkBatched(int numKeys, int numLookups) {
+    RedBlack<int,int>* tree = new RedBlack<int,int>();
+    std::vector<int> lookups(numLookups);
+    std::vector<int> values;
+    long long checksum = 0;
+
+    for (int i = 0; i < numKeys; i++) {
+        tree->put(rand(), i);
     }
 
-    return currNode;
-}
+    for (int i = 0; i < numLookups; i++) {
+        lookups[i] = rand();
+    }
 
-/* Function: moveRedRight
- * Description: Used in maximum node deletion when a red sibling is needed to be borrowed from another node.
- * This results in the node's right child or grand-child becoming red.
- *
- * Param: currNode (The current node being viewed)
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::moveRedRight(Node<K,V>* currNode) {
-    currNode = flipColours(currNode);
-
-    //If the left->left grandchild is red, move it to the right
-    if (isRed(currNode->left->left)) {
-        currNode = rotateRight(currNode);
-        currNode = flipColours(currNode);
+    auto start = std::chrono::steady_clock::now();
+    for (int key : lookups) {
+        checksum += tree->get(key);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    tree->getMany(lookups, values);
+    for (int value : values) {
+        checksum -= value;
     }
+    auto end = std::chrono::steady_clock::now();
 
-    return currNode;
+    cout << numKeys << " keys (checksum " << checksum << "): get "
+         << std::chrono::duration<double, std::nano>(middle - start).count() / numLookups << " ns/op, getMany "
+         << std::chrono::duration<double, std::nano>(end - middle).count() / numLookups << " ns/op" << endl;
+
+    delete tree;
 }
 
-/* Function: put
- * Description: Inserts a new node with the passed key and value into the RedBlack, organized by key.
- *              This function searches the tree recursively.
+/* Function: benchmarkSetOps
+ * Description: Times unionWith, intersectWith and difference on two trees of numKeys keys (multiples of 2 and of 3),
+ *              against the same operation done one key at a time with put, contains and remove.
  * 
- * Param: Node<K,V>* searchNode, K newKey, V newValue
+ * Param: int numKeys
 */ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::put(Node<K,V>* searchNode, K newKey, V newValue) {
-    if (searchNode == NULL) {
-        return new Node<K,V>(newKey, newValue, RED);
+void benchmarkSetOps(int numKeys) {
+    std::vector<std::pair<int,int> > evenPairs;
+    std::vector<std::pair<int,int> > thirdPairs;
+    string operations[] = {"union", "intersect", "difference"};
+
+    for (int i = 0; i < numKeys; i++) {
+        evenPairs.push_back(std::make_pair(2 * i, i));
+        thirdPairs.push_back(std::make_pair(3 * i, i));
     }
 
-    if (newKey < searchNode->key) {
-        searchNode->left = put(searchNode->left, newKey, newValue);
-    }
+    for (string operation : operations) {
+        for (int useJoin = 1; useJoin >= 0; useJoin--) {
+            RedBlack<int,int>* evenTree = new RedBlack<int,int>();
+            RedBlack<int,int>* thirdTree = new RedBlack<int,int>();
+            evenTree->buildFromSorted(evenPairs.begin(), evenPairs.end());
+            thirdTree->buildFromSorted(thirdPairs.begin(), thirdPairs.end());
 
-    else if (newKey > searchNode->key) {
-        searchNode->right = put(searchNode->right, newKey, newValue);
-    }
+            auto start = std::chrono::steady_clock::now();
 
-    else {
-        searchNode->value = newValue;
-    }
+            if (useJoin && operation == "union") {
+                evenTree->unionWith(*thirdTree);
+            }
 
-    return fixImbalances(searchNode);
+            else if (useJoin && operation == "intersect") {
+                evenTree->intersectWith(*thirdTree);
+            }
 
-    return searchNode;
-}
+            else if (useJoin) {
+                evenTree->difference(*thirdTree);
+            }
 
-/* Function: printInorder
- * Description: Navigates the tree and prints the values in in-order.
- * 
- * Param: currNode (The current node being viewed)
-*/ 
-template <typename K, typename V>
-void RedBlack<K,V>::printInorder(Node<K,V>* currNode) {
+            else if (operation == "union") {
+                for (std::pair<int,int>& pair : thirdPairs) {
+                    evenTree->put(pair.first, pair.second);
+                }
+            }
 
-    if (currNode == NULL) {
-        return;
-    }
+            else if (operation == "intersect") {
+                for (std::pair<int,int>& pair : evenPairs) {
+                    if (!thirdTree->contains(pair.first)) {
+                        evenTree->remove(pair.first);
+                    }
+                }
+            }
 
-    printInorder(currNode->left);
-    cout << "K: " << currNode->key << " Colour: " << currNode->colour << endl;
-    printInorder(currNode->right);
-}
+            else {
+                for (std::pair<int,int>& pair : thirdPairs) {
+                    evenTree->remove(pair.first);
+                }
+            }
 
-/* Function: printPostorder
- * Description: Navigates the tree and prints the values in post-order.
- * 
- * Param: currNode (The current node being viewed)
-*/ 
-template <typename K, typename V>
-void RedBlack<K,V>::printPostorder(Node<K,V>* currNode) {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
-    if (currNode == NULL) {
-        return;
-    }
+            cout << numKeys << " keys, " << operation << (useJoin ? " (join-based): " : " (key at a time): ") << ms
+                 << " ms, " << evenTree->size() << " keys left" << endl;
 
-    printPostorder(currNode->left);
-    printPostorder(currNode->right);
-    cout << "K: " << currNode->key << " Colour: " << currNode->colour << endl;
+            delete evenTree;
+            delete thirdTree;
+        }
+    }
 }
 
-/* Function: printPreorder
- * Description: Navigates the tree and prints the values in pre-order.
- * 
- * Param: currNode (The current node being viewed)
-*/ 
-template <typename K, typename V>
-void RedBlack<K,V>::printPreorder(Node<K,V>* currNode) {
+//SHARDED REDBLACK BENCHMARKS
 
-    if (currNode == NULL) {
-        return;
+/* Function: benchmarkSharded
+ * Description: Runs the passed number of threads doing an even mix of random puts and gets against a ShardedRedBlack
+ *              and against a single RedBlack behind one mutex, and prints the throughput of each. When skewed, nine
+ *              in ten keys fall in the first of the 16 shards, so the sharded map has to rebalance; the number of
+ *              shards the hot range ends up split across is printed.
+ *
+ * Param: int numThreads, int numKeys, int opsPerThread, bool skewed
+*/
+void benchmarkSharded(int numThreads, int numKeys, int opsPerThread, bool skewed) {
+    std::vector<int> splitKeys;
+
+    for (int i = 1; i < 16; i++) {
+        splitKeys.push_back(i * (numKeys / 16));
     }
 
-    cout << "K: " << currNode->key << " Colour: " << currNode->colour << endl;
+    ShardedRedBlack<int,int>* shardedTree = new ShardedRedBlack<int,int>(splitKeys);
+    RedBlack<int,int>* lockedTree = new RedBlack<int,int>();
+    std::mutex treeLock;
 
-    printPreorder(currNode->left);
-    printPreorder(currNode->right);
-}
+    for (int i = 0; i < numKeys; i++) {
+        shardedTree->put(i, i);
+        lockedTree->put(i, i);
+    }
 
-/* Function: remove
- * Description: Searches for the given key in the RedBlack and removes it if found. Searching is recursive.
- * 
- * Param: Node<K,V>* searchNode, K newKey, V newValue
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::remove(Node<K,V>* currNode, K searchKey) {
+    for (int useShards = 1; useShards >= 0; useShards--) {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
 
-    if (currNode == NULL) {
-        return NULL;
-    }
+        for (int i = 0; i < numThreads; i++) {
+            threads.push_back(std::thread([&, i]() {
+                unsigned int seed = i + 1;
 
-    //Current key < search key
-    if (searchKey < currNode->key) {
-        if (!isRed(currNode->left) && !isRed(currNode->left->left)) {
-            currNode = moveRedLeft(currNode);
-        }
-        currNode->left = remove(currNode->left, searchKey);
-    }
+                for (int j = 0; j < opsPerThread; j++) {
+                    seed = seed * 1103515245 + 12345;
+                    int key = (seed >> 8) % numKeys;
 
-    else {
+                    if (skewed && j % 10 != 0) {
+                        key %= numKeys / 16;
+                    }
 
-        //Temporarily make left-leaning red links lean right
-        if (isRed(currNode->left)) {
-            currNode = rotateRight(currNode);
-        }
+                    if (useShards && j % 2 == 0) {
+                        shardedTree->put(key, j);
+                    }
 
-        //Node was found at the bottom of the tree, delete it
-        if (searchKey == currNode->key && currNode->right == NULL) {
-            delete currNode;
-            currNode = NULL;
-            return NULL;
+                    else if (useShards) {
+                        shardedTree->get(key);
+                    }
+
+                    else {
+                        std::lock_guard<std::mutex> guard(treeLock);
+
+                        if (j % 2 == 0) {
+                            lockedTree->put(key, j);
+                        }
+
+                        else {
+                            lockedTree->get(key);
+                        }
+                    }
+                }
+            }));
         }
 
-        if (!isRed(currNode->right) && !isRed(currNode->right->left)) {
-            currNode = moveRedRight(currNode);
+        for (std::thread& thread : threads) {
+            thread.join();
         }
 
-        if (currNode->key == searchKey) {
-            Node<K,V>* tempNode = currNode->right;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        cout << numThreads << " threads, " << (skewed ? "skewed, " : "") << (useShards ? "ShardedRedBlack: " : "mutex RedBlack: ")
+             << (long long) (numThreads * (double) opsPerThread / seconds) << " ops/s";
 
-            while (tempNode->left != NULL) {
-                tempNode = tempNode->left;
-            }
+        if (useShards && skewed) {
+            int hotShards = 1;
 
-            //Copy the successor's key and value
-            currNode->key = tempNode->key;
-            currNode->value = tempNode->value;
+            for (int splitKey : shardedTree->splitKeys()) {
+                hotShards += splitKey < numKeys / 16;
+            }
 
-            //Remove the successor node from the tree
-            currNode->right = removeMin(currNode->right);
-        }
-        
-        else {
-            currNode->right = remove(currNode->right, searchKey);
+            cout << " (hot range across " << hotShards << " shards)";
         }
+
+        cout << endl;
     }
 
-    return fixImbalances(currNode);
+    delete shardedTree;
+    delete lockedTree;
 }
 
-/* Function: removeMax
- * Description: Searches through a tree and deletes the maximum node, handling imbalances along the way.
- * A red link is passed down through the tree to accomplish this.
- * 
- * Param: Node<K,V> currNode
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::removeMax(Node<K,V>* currNode) {
+//WRITE-BUFFERED REDBLACK BENCHMARKS
 
-    //Have left-leaning red links temporarily lean right
-    if (isRed(currNode->left)) {
-        currNode = rotateRight(currNode);
-    }
+/* Function: benchmarkBuffered
+ * Description: Times random puts followed by random gets on a RedBlack and on a BufferedRedBlack, and prints ns/op.
+ *              The gets run with whatever the last flush left in the staging area.
+ *
+ * Param: int numKeys, int numLookups
+*/
+void benchmarkBuffered(int numKeys, int numLookups) {
+    std::vector<int> keys(numKeys);
+    unsigned int seed = 1;
 
-    //Delete the maximum node
-    if (currNode->right == NULL) {
-        delete currNode;
-        currNode = NULL;
-        return NULL;
+    for (int& key : keys) {
+        seed = seed * 1103515245 + 12345;
+        key = seed >> 1;
     }
 
-    else {
+    for (int useBuffer = 0; useBuffer <= 1; useBuffer++) {
+        RedBlack<int,int>* tree = new RedBlack<int,int>();
+        BufferedRedBlack<int,int>* bufferedTree = new BufferedRedBlack<int,int>();
+        long long checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
 
-        //Borrow a node from a sibling node if necessary
-        if (!isRed(currNode->right) && !isRed(currNode->right->left)) {
-            currNode = moveRedRight(currNode);
+        for (int key : keys) {
+            if (useBuffer) {
+                bufferedTree->put(key, key & 1023);
+            }
+
+            else {
+                tree->put(key, key & 1023);
+            }
         }
 
-        currNode->right = removeMax(currNode->right);
-    }
+        auto middle = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < numLookups; i++) {
+            int key = keys[(i * 7919LL) % numKeys];
+            checksum += useBuffer ? bufferedTree->get(key) : tree->get(key);
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        double putNs = std::chrono::duration<double, std::nano>(middle - start).count() / numKeys;
+        double getNs = std::chrono::duration<double, std::nano>(end - middle).count() / numLookups;
 
-    //Fix imbalances when traversing back up the tree
-    return fixImbalances(currNode);
+        cout << numKeys << " keys, " << (useBuffer ? "BufferedRedBlack: " : "RedBlack: ") << "put " << putNs
+             << " ns/op, get " << getNs << " ns/op (checksum " << checksum << ")" << endl;
+
+        delete tree;
+        delete bufferedTree;
+    }
 }
 
-/* Function: removeMin
- * Description: Searches through a tree and deletes the minimum node, handling imbalances along the way.
- * 
- * Param: Node<K,V> currNode
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::removeMin(Node<K,V>* currNode) {
-
-    //Delete the minimum node
-    if (currNode->left == NULL) {
-        delete currNode;
-        currNode = NULL;
-        return NULL;
+//HASH-INDEXED REDBLACK BENCHMARKS
+
+/* Function: benchmarkIndexed
+ * Description: Times a RedBlack against an IndexedRedBlack on random inserts, updates of present keys, and
+ *              workloads mixing point lookups with puts and removes at several read shares, and prints ns/op.
+ *              The write amplification of the index is shown as the slot writes per insert or remove (one, plus
+ *              the slots moved by growing or closing gaps) and the index's bytes per key.
+ *
+ * Param: int numKeys, int numOps
+*/
+void benchmarkIndexed(int numKeys, int numOps) {
+    std::vector<int> keys(numKeys);
+    double readShares[] = {1.0, 0.95, 0.5};
+    unsigned int seed = 1;
+
+    for (int& key : keys) {
+        seed = seed * 1103515245 + 12345;
+        key = seed >> 1;
     }
 
-    else {
+    for (int useIndex = 0; useIndex <= 1; useIndex++) {
+        RedBlack<int,int>* tree = new RedBlack<int,int>();
+        IndexedRedBlack<int,int>* indexedTree = new IndexedRedBlack<int,int>();
+        string name = useIndex ? "IndexedRedBlack: " : "RedBlack: ";
+        long long checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
 
-        //Borrow from a sibling if necessary
-        if (!isRed(currNode->left) && !isRed(currNode->left->left)) {
-            currNode = moveRedLeft(currNode);
+        for (int key : keys) {
+            if (useIndex) {
+                indexedTree->put(key, key & 1023);
+            }
+
+            else {
+                tree->put(key, key & 1023);
+            }
         }
 
-        currNode->left = removeMin(currNode->left);
-    }
+        auto middle = std::chrono::steady_clock::now();
+        long long buildMoves = indexedTree->numSlotMoves();
+        long long numRemoves = 0;
 
-    //Fix imbalances when traversing back up the tree
-    return fixImbalances(currNode);
-}
+        for (int i = 0; i < numOps; i++) {
+            int key = keys[(i * 7919LL) % numKeys];
 
-/* Function: rotateLeft
- * Description: Performs a left rotation on the current node to fix right-leaning links.
- * 
- * Param: Node<K,V> currNode
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::rotateLeft(Node<K,V>* currNode) {
-    Node<K,V>* tempNode = currNode->right;
-    currNode->right = tempNode->left;
-    tempNode->left = currNode;
-    tempNode->colour = currNode->colour;
-    currNode->colour = RED;
-
-    return tempNode;
-}
+            if (useIndex) {
+                indexedTree->put(key, i & 1023);
+            }
 
-/* Function: rotateRight
- * Description: Makes a left-leaning red node temporarily lean right.
- * 
- * Param: Node<K,V> currNode
-*/ 
-template <typename K, typename V>
-Node<K,V>* RedBlack<K,V>::rotateRight(Node<K,V>* currNode) {
-    Node<K,V>* tempNode = currNode->left;
-    currNode->left = tempNode->right;
-    tempNode->right = currNode;
-    tempNode->colour = currNode->colour;
-    currNode->colour = RED;
-
-    return tempNode;
-}
+            else {
+                tree->put(key, i & 1023);
+            }
+        }
 
+        auto end = std::chrono::steady_clock::now();
 
+        cout << numKeys << " keys, " << name << "insert " << std::chrono::duration<double, std::nano>(middle - start).count() / numKeys
+             << " ns/op, update " << std::chrono::duration<double, std::nano>(end - middle).count() / numOps << " ns/op" << endl;
 
-//PUBLIC FUNCTIONS
+        //Writes remove a key and put it back, so the map keeps its size
+        for (double readShare : readShares) {
+            unsigned int opSeed = 7;
+            start = std::chrono::steady_clock::now();
 
+            for (int i = 0; i < numOps; i++) {
+                opSeed = opSeed * 1103515245 + 12345;
+                int key = keys[(opSeed >> 8) % numKeys];
 
+                if ((opSeed & 1023) < readShare * 1024) {
+                    checksum += useIndex ? indexedTree->get(key) : tree->get(key);
+                }
 
-/* Function: contains
- * Description: Searches for a node with the given key and returns whether or not it appears in the tree.
- * 
- * Param: K searchKey
-*/ 
-template <typename K, typename V>
-bool RedBlack<K,V>::contains(K searchKey) {
-    Node<K,V>* iter = root;
-    bool containsKey = false;
-
-    while (iter != NULL) {
-        if (searchKey < iter->key) {
-            iter = iter->left;
-        }
+                else if (useIndex) {
+                    indexedTree->remove(key);
+                    indexedTree->put(key, key & 1023);
+                    numRemoves++;
+                }
+
+                else {
+                    tree->remove(key);
+                    tree->put(key, key & 1023);
+                }
+            }
 
-        else if (searchKey > iter->key) {
-            iter = iter->right;
+            end = std::chrono::steady_clock::now();
+
+            cout << "  " << name << 100 * readShare << "% reads " << std::chrono::duration<double, std::nano>(end - start).count() / numOps
+                 << " ns/op (checksum " << checksum << ")" << endl;
         }
 
-        else if (searchKey == iter->key) {
-            containsKey = true;
-            break;
+        if (useIndex) {
+            cout << "  Index: " << (double) indexedTree->indexBytes() / numKeys << " bytes/key, "
+                 << 1 + (double) buildMoves / numKeys << " slot writes/insert, "
+                 << 1 + (double) (indexedTree->numSlotMoves() - buildMoves) / std::max(numRemoves, 1LL) << " slot writes/remove" << endl;
         }
-    }
 
-    return containsKey;
+        delete tree;
+        delete indexedTree;
+    }
 }
 
-/* Function: get
- * Description: Searches for a node with the given key and returns its associated value if found within the tree.
- *              This function searches the tree iteratively.
- * 
- * Param: K searchKey
-*/ 
-template <typename K, typename V>
-V RedBlack<K,V>::get(K searchKey) {
-    Node<K,V>* iter = root;
+//COMPACT REDBLACK BENCHMARKS
+
+/* Function: benchmarkCompact
+ * Description: Builds a RedBlack<uint32_t,uint32_t> and a CompactRedBlack from the same random keys, and prints the
+ *              bytes per node, the bytes held per key and the time per insert and per random lookup of each.
+ *
+ * Param: int numKeys, int numLookups
+*/
+void benchmarkCompact(int numKeys, int numLookups) {
+    std::vector<uint32_t> keys(numKeys);
+    unsigned int seed = 1;
+
+    for (uint32_t& key : keys) {
+        seed = seed * 1103515245 + 12345;
+        key = seed;
+    }
+
+    for (int useCompact = 0; useCompact <= 1; useCompact++) {
+        RedBlack<uint32_t,uint32_t>* tree = new RedBlack<uint32_t,uint32_t>();
+        CompactRedBlack<uint32_t,uint32_t>* compactTree = new CompactRedBlack<uint32_t,uint32_t>();
+        long long checksum = 0;
 
-    while (iter != NULL) {
-        if (searchKey < iter->key) {
-            iter = iter->left;
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t key : keys) {
+            if (useCompact) {
+                compactTree->put(key, key & 1023);
+            }
+
+            else {
+                tree->put(key, key & 1023);
+            }
         }
 
-        else if (searchKey > iter->key) {
-            iter = iter->right;
+        auto middle = std::chrono::steady_clock::now();
+        unsigned int lookupSeed = 7;
+
+        for (int i = 0; i < numLookups; i++) {
+            lookupSeed = lookupSeed * 1103515245 + 12345;
+            uint32_t key = keys[(lookupSeed >> 8) % numKeys];
+            checksum += useCompact ? compactTree->get(key) : tree->get(key);
         }
 
-        else {
-            return iter->value;
+        auto end = std::chrono::steady_clock::now();
+
+        //RedBlack's arena holds its nodes back to back, so its bytes per key are close to its node size
+        size_t numBytes = useCompact ? sizeof(CompactNode<uint32_t,uint32_t>) : sizeof(Node<uint32_t,uint32_t>);
+
+        cout << numKeys << " keys, " << (useCompact ? "CompactRedBlack: " : "RedBlack: ") << numBytes << " bytes/node, ";
+
+        if (useCompact) {
+            cout << (double) compactTree->nodeBytes() / numKeys << " bytes/key held, ";
         }
+
+        cout << "insert " << std::chrono::duration<double, std::nano>(middle - start).count() / numKeys
+             << " ns/op, get " << std::chrono::duration<double, std::nano>(end - middle).count() / numLookups
+             << " ns/op (checksum " << checksum << ")" << endl;
+
+        delete tree;
+        delete compactTree;
     }
-    return NULL;
 }
 
-/* Function: max
- * Description: Returns the value of the maximum key node in the tree.
- * 
- * Param: K newKey, V newValue
-*/ 
-template <typename K, typename V>
-V RedBlack<K,V>::max() {
-    Node<K,V>* iterNode = root;
+//ALLOCATOR BENCHMARKS
 
-   while (iterNode->right != NULL) {
-       iterNode = iterNode->right;
-   }
+/* Function: runRequests
+ * Description: Serves numRequests requests, each building a tree of keysPerRequest random keys with makeTree, looking
+ *              every key up and destroying the tree, then calling afterRequest. Prints the time per request.
+ *
+ * Param: string name, int numRequests, int keysPerRequest, MakeTree makeTree, AfterRequest afterRequest
+*/
+template <typename Tree, typename MakeTree, typename AfterRequest>
+void runRequests(string name, int numRequests, int keysPerRequest, MakeTree makeTree, AfterRequest afterRequest) {
+    unsigned int seed = 1;
+    long long checksum = 0;
 
-   return iterNode->value;
-}
+    auto start = std::chrono::steady_clock::now();
 
-/* Function: min
- * Description: Returns the value of the minimum key node in the tree.
- * 
- * Param: K newKey, V newValue
-*/ 
-template <typename K, typename V>
-V RedBlack<K,V>::min() {
-    Node<K,V>* iterNode = root;
+    for (int i = 0; i < numRequests; i++) {
+        Tree* tree = makeTree();
+        unsigned int requestSeed = seed;
+
+        for (int j = 0; j < keysPerRequest; j++) {
+            seed = seed * 1103515245 + 12345;
+            tree->put(seed >> 8, j);
+        }
+
+        //Replays the same keys for the lookups
+        for (int j = 0; j < keysPerRequest; j++) {
+            requestSeed = requestSeed * 1103515245 + 12345;
+            checksum += tree->get((int) (requestSeed >> 8));
+        }
 
-    while (iterNode->left != NULL) {
-       iterNode = iterNode->left;
+        delete tree;
+        afterRequest();
     }
 
-   return iterNode->value;
-}
+    auto end = std::chrono::steady_clock::now();
+    double requestNs = std::chrono::duration<double, std::nano>(end - start).count() / numRequests;
 
-//Public in-order
-template <typename K, typename V>
-void RedBlack<K,V>::printInorder() {
-    printInorder(root);
+    cout << name << ": " << requestNs << " ns/request (checksum " << checksum << ")" << endl;
 }
 
-//Public post-order
-template <typename K, typename V>
-void RedBlack<K,V>::printPostorder() {
-    printPostorder(root);
-}
+/* Function: benchmarkAllocators
+ * Description: Serves short requests that each build and drop a small tree, with the nodes taken from the heap, a
+ *              NodeArena, and through PmrAllocator from a pool resource and from a monotonic buffer released in one
+ *              shot after every request. Then shows the memory one request's tree used through a TrackingResource.
+ *
+ * Param: int numRequests, int keysPerRequest
+*/
+void benchmarkAllocators(int numRequests, int keysPerRequest) {
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::monotonic_buffer_resource buffer;
+    TrackingResource tracker;
 
-//Public pre-order
-template <typename K, typename V>
-void RedBlack<K,V>::printPreorder() {
-    printPreorder(root);
-}
+    auto noRelease = []() {};
 
-//Public put
-template <typename K, typename V>
-void RedBlack<K,V>::put(K newKey, V newValue) {
-    if (root == NULL) {
-        root = new Node<K,V>(newKey, newValue, BLACK);
-    }
+    cout << numRequests << " requests of " << keysPerRequest << " keys" << endl;
 
-    else {
-        root = put(root, newKey, newValue);
-        root->colour = BLACK;
-    }
-}
+    runRequests<RedBlack<int,int,HeapAllocator> >("  HeapAllocator", numRequests, keysPerRequest, []() {
+        return new RedBlack<int,int,HeapAllocator>();
+    }, noRelease);
 
-//Public remove
-template <typename K, typename V>
-void RedBlack<K,V>::remove(K searchKey) {
+    runRequests<RedBlack<int,int,NodeArena> >("  NodeArena", numRequests, keysPerRequest, []() {
+        return new RedBlack<int,int,NodeArena>();
+    }, noRelease);
 
-    if (contains(searchKey)) {
-        root = remove(root, searchKey);
+    runRequests<RedBlack<int,int,PmrAllocator> >("  PmrAllocator (pool)", numRequests, keysPerRequest, [&]() {
+        return new RedBlack<int,int,PmrAllocator>(&pool);
+    }, noRelease);
 
-        if (root != NULL) {
-            root->colour = BLACK;
-        }
-    }
-}
+    runRequests<RedBlack<int,int,PmrAllocator> >("  PmrAllocator (monotonic)", numRequests, keysPerRequest, [&]() {
+        return new RedBlack<int,int,PmrAllocator>(&buffer);
+    }, [&]() {
+        buffer.release();
+    });
 
-//Public removeMax function
-template <typename K, typename V>
-void RedBlack<K,V>::removeMax() {
-    root = removeMax(root);
+    RedBlack<int,int,PmrAllocator>* trackedTree = new RedBlack<int,int,PmrAllocator>(&tracker);
 
-    if (root != NULL) {
-        root->colour = BLACK;
+    for (int i = 0; i < keysPerRequest; i++) {
+        trackedTree->put(i, i);
     }
+
+    cout << "  One request's tree: ";
+    tracker.print();
+    delete trackedTree;
 }
 
-//Public removeMin function
-template <typename K, typename V>
-void RedBlack<K,V>::removeMin() {
+//RUNNING BENCHMARKS
 
-    if (!isRed(root->left) && !(isRed(root->right))) {
-        root->colour = RED;
+/* Function: runBenchmarks
+ * Description: Runs every benchmark above on numKeys keys, with numKeys lookups or operations where they take a
+ *              count, and the sharded benchmark on uniform and skewed keys with 1 to 32 threads, doubling.
+ *              The allocator benchmark serves numKeys / 10 requests of 100 keys.
+ *
+ * Param: int numKeys
+*/
+void runBenchmarks(int numKeys) {
+    benchmarkFrozen(numKeys, numKeys);
+    benchmarkBatched(numKeys, numKeys);
+    benchmarkSetOps(numKeys);
+
+    for (int numThreads = 1; numThreads <= 32; numThreads *= 2) {
+        benchmarkSharded(numThreads, numKeys, numKeys / 5, false);
+        benchmarkSharded(numThreads, numKeys, numKeys / 5, true);
     }
 
-    root = removeMin(root);
-
-    if (root != NULL) {
-        root->colour = BLACK;
-    }
+    benchmarkBuffered(numKeys, numKeys);
+    benchmarkIndexed(numKeys, numKeys);
+    benchmarkCompact(numKeys, numKeys);
+    benchmarkAllocators(std::max(1, numKeys / 10), 100);
 }
 
 //Driver for testing
-int main() {
+int main(int argc, char** argv) {
+
+    //Benchmarks (run with --benchmark [numKeys])
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "--benchmark") != 0 || argc > 3) {
+            cout << "Usage: " << argv[0] << " [--benchmark [numKeys]]" << endl;
+            return 1;
+        }
+
+        runBenchmarks(argc == 3 ? std::max(1000, atoi(argv[2])) : 1000000);
+        return 0;
+    }
 
     //Allocations
 
@@ -601,6 +619,22 @@ int main() {
     // testTree->printPostorder();
     // cout << endl;
 
+    //Bulk loading
+
+    // std::vector<std::pair<int,string> > sortedPairs = {{1,"Alpha"}, {3,"Charlie"}, {5,"Echo"}, {6,"Frank"}};
+    // testTree->buildFromSorted(sortedPairs.begin(), sortedPairs.end());
+    // testTree->appendSorted(8,"Hotel");
+    // testTree->appendSorted(11,"Kilo");
+
+    //Ordered access
+
+    // for (RedBlack<int,string>::iterator iter = testTree->begin(); iter != testTree->end(); ++iter) {
+    //     cout << iter->key << " " << iter->value << endl;
+    // }
+    // cout << testTree->floor(10)->value << " " << testTree->ceiling(10)->value << endl;
+    // cout << testTree->rank(11) << " " << testTree->select(4)->value << endl;
+    // testTree->rangeScan(5, 13, [](int key, string value) { cout << key << " " << value << endl; });
+
     //Deletions
 
     // testTree->remove(18);
@@ -616,4 +650,115 @@ int main() {
     // testTree->remove(17);
     // testTree->remove(13);
     // delete testTree;
+
+    //Batched lookups
+
+    // std::vector<string> values;
+    // testTree->getMany({1, 4, 11, 26}, values);
+    // cout << values[0] << " " << values[2] << endl;
+
+    //Frozen search index
+
+    // EytzingerIndex<int,string> index = testTree->freeze();
+    // cout << index.get(11) << " " << index.contains(4) << endl;
+
+    //Set operations
+
+    // RedBlack<int,string>* otherTree = new RedBlack<int,string>();
+    // otherTree->put(11, "Kilo");
+    // otherTree->put(30, "Thirty");
+    // testTree->unionWith(*otherTree);
+    // testTree->split(11, *otherTree);
+    // testTree->printInorder();
+    // otherTree->printInorder();
+    // delete otherTree;
+
+    //Binary snapshots
+
+    // RedBlack<int,double> numberTree;
+    // numberTree.put(1, 1.5);
+    // numberTree.put(2, 2.5);
+    // numberTree.save("numbers.snap");
+    // numberTree.load("numbers.snap");
+    // MappedSnapshot<int,double> mappedNumbers("numbers.snap");
+    // cout << mappedNumbers.get(2) << " " << mappedNumbers.contains(3) << endl;
+
+    //Sharded concurrent map
+
+    // ShardedRedBlack<int,string>* shardedTree = new ShardedRedBlack<int,string>({5, 10, 20});
+    // shardedTree->put(1,"Alpha");
+    // shardedTree->put(11,"Kilo");
+    // shardedTree->put(26,"Zulu");
+    // shardedTree->rangeScan(0, 30, [](int key, string value) { cout << key << " " << value << endl; });
+    // delete shardedTree;
+
+    //Interval mode
+
+    // RedBlack<int, Interval<int,string> >* bookings = new RedBlack<int, Interval<int,string> >();
+    // bookings->put(900, Interval<int,string>(1030, "Standup"));
+    // bookings->put(1000, Interval<int,string>(1200, "Review"));
+    // bookings->put(1300, Interval<int,string>(1400, "Lunch"));
+    // bookings->overlapping(1015, 1100, [](int start, Interval<int,string> booking) { cout << start << " " << booking.value << endl; });
+    // bookings->stabbing(1330, [](int start, Interval<int,string> booking) { cout << start << " " << booking.value << endl; });
+    // delete bookings;
+
+    //Write-buffered ingest
+
+    // BufferedRedBlack<int,string>* bufferedTree = new BufferedRedBlack<int,string>();
+    // bufferedTree->put(4, "Delta");
+    // bufferedTree->put(2, "Bravo");
+    // bufferedTree->remove(4);
+    // cout << bufferedTree->get(2) << " " << bufferedTree->contains(4) << " " << bufferedTree->size() << endl;
+    // delete bufferedTree;
+
+    //Hash-indexed lookups
+
+    // IndexedRedBlack<string,int>* indexedTree = new IndexedRedBlack<string,int>();
+    // indexedTree->put("Delta", 4);
+    // indexedTree->put("Bravo", 2);
+    // cout << indexedTree->get("Delta") << " " << indexedTree->contains("Echo") << " " << indexedTree->min() << endl;
+    // delete indexedTree;
+
+    //Compact nodes
+
+    // CompactRedBlack<uint32_t,uint32_t>* compactTree = new CompactRedBlack<uint32_t,uint32_t>();
+    // compactTree->put(4, 40);
+    // compactTree->put(2, 20);
+    // compactTree->put(7, 70);
+    // compactTree->remove(4);
+    // cout << compactTree->get(2) << " " << compactTree->contains(4) << " " << compactTree->min() << " " << compactTree->max() << endl;
+    // delete compactTree;
+
+    //Instrumentation (compile with -DTREE_STATS for the stats, validate is always available)
+
+    // RedBlack<int,int>* statsTree = new RedBlack<int,int>();
+    // for (int i = 0; i < 100000; i++) {
+    //     statsTree->put(rand(), i);
+    //     statsTree->get(rand());
+    // }
+    // cout << "Valid: " << statsTree->validate() << endl;
+    // statsTree->getStats().print();
+    // delete statsTree;
+
+    //Memory resources
+
+    // TrackingResource tracker;
+    // RedBlack<int,int,PmrAllocator>* trackedTree = new RedBlack<int,int,PmrAllocator>(&tracker);
+    // trackedTree->put(1, 10);
+    // trackedTree->put(2, 20);
+    // tracker.print();
+    // delete trackedTree;
+
+    //Trace recording (replay the trace with Benchmarks/traceReplay)
+
+    // TraceRecorder recorder;
+    // recorder.open("redBlack.trace");
+    // RedBlack<int,int>* tracedTree = new RedBlack<int,int>();
+    // tracedTree->setRecorder(&recorder);
+    // for (int i = 0; i < 100000; i++) {
+    //     tracedTree->put(rand() % 10000, i);
+    //     tracedTree->get(rand() % 10000);
+    // }
+    // delete tracedTree;
+    // recorder.close();
 }
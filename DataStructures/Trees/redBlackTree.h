@@ -0,0 +1,3975 @@
+/* DESCRIPTION OF FILE
+
+    This file implements a left-leaning red-black binary search tree.
+    Code was written by myself, but follows the code found here: 
+    https://algs4.cs.princeton.edu/33balanced/RedBlackBST.java.html
+    
+    Further understanding of the code was achieved through these lecture slides: 
+    https://algs4.cs.princeton.edu/lectures/keynote/33BalancedSearchTrees.pdf
+*/
+
+#ifndef RED_BLACK_TREE_H
+#define RED_BLACK_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string.h>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../nodeAllocators.h"
+#include "../traceRecorder.h"
+#include "treeSnapshot.h"
+#include "treeStats.h"
+using namespace std;
+
+//Link colours, also defined by persistentRedBlackTree.h so the two headers can be included together
+#ifndef RED_BLACK_COLOURS
+#define RED_BLACK_COLOURS
+const bool RED = true;
+const bool BLACK = false;
+#endif
+
+//Node class for all key-value pairs in the RedBlack
+template <class K, class V>
+class Node {
+
+    public:
+        K key;
+        V value;
+        Node<K,V>* left;
+        Node<K,V>* right;
+        bool colour;
+        int size;
+        
+        Node(const K& newKey, const V& newValue, bool nodeColour) : key(newKey), value(newValue) {
+            left = NULL;
+            right = NULL;
+            colour = nodeColour;
+            size = 1;
+        }
+
+        //Builds the key and value in place from the passed arguments, so neither is copied
+        template <typename Key, typename... Args>
+        Node(std::piecewise_construct_t, bool nodeColour, Key&& newKey, Args&&... args)
+            : key(std::forward<Key>(newKey)), value(std::forward<Args>(args)...) {
+            left = NULL;
+            right = NULL;
+            colour = nodeColour;
+            size = 1;
+        }
+};
+
+//Value type for interval mode. A RedBlack<K, Interval<K,V> > is keyed by each interval's start, and its nodes
+//also track the largest end in their subtree so that overlap queries can skip whole subtrees.
+template <class K, class V>
+class Interval {
+
+    public:
+        K end;
+        V value;
+
+        Interval() {}
+
+        Interval(K end, V value) {
+            this->end = end;
+            this->value = value;
+        }
+};
+
+//Interval mode node, with the largest interval end found in its subtree
+template <class K, class V>
+class Node<K, Interval<K,V> > {
+
+    public:
+        K key;
+        Interval<K,V> value;
+        Node<K, Interval<K,V> >* left;
+        Node<K, Interval<K,V> >* right;
+        bool colour;
+        int size;
+        K maxEnd;
+
+        Node(const K& newKey, const Interval<K,V>& newValue, bool nodeColour) : key(newKey), value(newValue) {
+            left = NULL;
+            right = NULL;
+            colour = nodeColour;
+            size = 1;
+            maxEnd = value.end;
+        }
+
+        template <typename Key, typename... Args>
+        Node(std::piecewise_construct_t, bool nodeColour, Key&& newKey, Args&&... args)
+            : key(std::forward<Key>(newKey)), value(std::forward<Args>(args)...) {
+            left = NULL;
+            right = NULL;
+            colour = nodeColour;
+            size = 1;
+            maxEnd = value.end;
+        }
+};
+
+//Nodes outside interval mode have no maximum end to maintain
+template <class K, class V>
+void updateMaxEnd(Node<K,V>* currNode) {}
+
+/* Function: updateMaxEnd
+ * Description: Recomputes an interval mode node's maxEnd from its own end and its children's maxEnd.
+ * 
+ * Param: Node<K, Interval<K,V> >* currNode
+*/ 
+template <class K, class V>
+void updateMaxEnd(Node<K, Interval<K,V> >* currNode) {
+    currNode->maxEnd = currNode->value.end;
+
+    if (currNode->left != NULL && currNode->maxEnd < currNode->left->maxEnd) {
+        currNode->maxEnd = currNode->left->maxEnd;
+    }
+
+    if (currNode->right != NULL && currNode->maxEnd < currNode->right->maxEnd) {
+        currNode->maxEnd = currNode->right->maxEnd;
+    }
+}
+
+//Nodes outside interval mode have no maximum end to check
+template <class K, class V>
+bool hasValidMaxEnd(Node<K,V>* currNode) {
+    return true;
+}
+
+//Returns whether an interval mode node's maxEnd is the largest of its own end and its children's maxEnd
+template <class K, class V>
+bool hasValidMaxEnd(Node<K, Interval<K,V> >* currNode) {
+    K maxEnd = currNode->value.end;
+
+    if (currNode->left != NULL && maxEnd < currNode->left->maxEnd) {
+        maxEnd = currNode->left->maxEnd;
+    }
+
+    if (currNode->right != NULL && maxEnd < currNode->right->maxEnd) {
+        maxEnd = currNode->right->maxEnd;
+    }
+
+    return !(maxEnd < currNode->maxEnd) && !(currNode->maxEnd < maxEnd);
+}
+
+//Bidirectional in-order iterator over a RedBlack tree.
+//The iterator keeps the path from the root to its node, and is invalidated by any change to the tree.
+template <class K, class V>
+class RedBlackIterator {
+
+    private:
+        Node<K,V>* root;
+        std::vector<Node<K,V>*> path;
+
+    public:
+        RedBlackIterator& operator++();
+        RedBlackIterator& operator--();
+
+        Node<K,V>& operator*() {
+            return *path.back();
+        }
+
+        Node<K,V>* operator->() {
+            return path.back();
+        }
+
+        bool operator==(const RedBlackIterator& other) const {
+            return (path.empty() && other.path.empty()) || (!path.empty() && !other.path.empty() && path.back() == other.path.back());
+        }
+
+        bool operator!=(const RedBlackIterator& other) const {
+            return !(*this == other);
+        }
+
+        RedBlackIterator(Node<K,V>* root, std::vector<Node<K,V>*> path) {
+            this->root = root;
+            this->path = path;
+        }
+};
+
+/* Function: operator++
+ * Description: Moves to the next key in order. Past the largest key the iterator becomes end().
+*/ 
+template <class K, class V>
+RedBlackIterator<K,V>& RedBlackIterator<K,V>::operator++() {
+    Node<K,V>* iterNode = path.back();
+
+    //The next key is the minimum of the right subtree
+    if (iterNode->right != NULL) {
+        path.push_back(iterNode->right);
+
+        while (path.back()->left != NULL) {
+            path.push_back(path.back()->left);
+        }
+    }
+
+    //Otherwise it is the first ancestor reached from its left subtree
+    else {
+        path.pop_back();
+
+        while (!path.empty() && path.back()->right == iterNode) {
+            iterNode = path.back();
+            path.pop_back();
+        }
+    }
+
+    return *this;
+}
+
+/* Function: operator--
+ * Description: Moves to the previous key in order. Decrementing end() moves to the largest key.
+*/ 
+template <class K, class V>
+RedBlackIterator<K,V>& RedBlackIterator<K,V>::operator--() {
+
+    if (path.empty()) {
+        for (Node<K,V>* iterNode = root; iterNode != NULL; iterNode = iterNode->right) {
+            path.push_back(iterNode);
+        }
+
+        return *this;
+    }
+
+    Node<K,V>* iterNode = path.back();
+
+    //The previous key is the maximum of the left subtree
+    if (iterNode->left != NULL) {
+        path.push_back(iterNode->left);
+
+        while (path.back()->right != NULL) {
+            path.push_back(path.back()->right);
+        }
+    }
+
+    //Otherwise it is the first ancestor reached from its right subtree
+    else {
+        path.pop_back();
+
+        while (!path.empty() && path.back()->left == iterNode) {
+            iterNode = path.back();
+            path.pop_back();
+        }
+    }
+
+    return *this;
+}
+
+//Read-only search index holding the keys of a RedBlack tree in Eytzinger (BFS) order in one contiguous array,
+//with the values in a parallel array. Index 0 is unused so that the children of index i are at 2i and 2i+1.
+template <class K, class V>
+class EytzingerIndex {
+
+    private:
+        std::vector<K> keys;
+        std::vector<V> values;
+        int numKeys;
+
+        void fill(RedBlackIterator<K,V>& iter, int keyIndex);
+        int lowerBound(const K& searchKey);
+
+    public:
+        bool contains(K searchKey);
+        V get(K searchKey);
+        int size();
+
+        EytzingerIndex(RedBlackIterator<K,V> first, int numKeys);
+};
+
+/* Function: EytzingerIndex
+ * Description: Builds the index from the next numKeys keys of an in-order iterator in O(n).
+ *
+ * Param: RedBlackIterator<K,V> first, int numKeys
+*/
+template <class K, class V>
+EytzingerIndex<K,V>::EytzingerIndex(RedBlackIterator<K,V> first, int numKeys) {
+    this->numKeys = numKeys;
+    keys.resize(numKeys + 1);
+    values.resize(numKeys + 1);
+    fill(first, 1);
+}
+
+/* Function: fill
+ * Description: Places the keys in Eytzinger order with an in-order walk of the implicit tree, taking keys
+ *              from the iterator as each position is visited.
+ *
+ * Param: RedBlackIterator<K,V>& iter, int keyIndex
+*/
+template <class K, class V>
+void EytzingerIndex<K,V>::fill(RedBlackIterator<K,V>& iter, int keyIndex) {
+
+    if (keyIndex > numKeys) {
+        return;
+    }
+
+    fill(iter, 2 * keyIndex);
+    keys[keyIndex] = iter->key;
+    values[keyIndex] = iter->value;
+    ++iter;
+    fill(iter, 2 * keyIndex + 1);
+}
+
+/* Function: lowerBound
+ * Description: Returns the index of the first key not less than the search key, or 0 if there is none.
+ *              Each level only chooses the next index from a comparison, so the loop has no data-dependent branches,
+ *              and the 16 descendants four levels down (one cache line of 4-byte keys) are prefetched ahead of time.
+ *              The final index is found by undoing the right turns taken after the last left turn.
+ *
+ * Param: K searchKey
+*/
+template <class K, class V>
+int EytzingerIndex<K,V>::lowerBound(const K& searchKey) {
+    const K* keyArray = keys.data();
+    unsigned int keyIndex = 1;
+
+    while (keyIndex <= (unsigned int) numKeys) {
+        __builtin_prefetch(keyArray + 16 * keyIndex);
+        keyIndex = 2 * keyIndex + (keyArray[keyIndex] < searchKey);
+    }
+
+    return keyIndex >> __builtin_ffs(~keyIndex);
+}
+
+//Returns whether or not the key appears in the index
+template <class K, class V>
+bool EytzingerIndex<K,V>::contains(K searchKey) {
+    int keyIndex = lowerBound(searchKey);
+    return keyIndex != 0 && keys[keyIndex] == searchKey;
+}
+
+//Returns the value associated with the key, or V() if it is not in the index
+template <class K, class V>
+V EytzingerIndex<K,V>::get(K searchKey) {
+    int keyIndex = lowerBound(searchKey);
+
+    if (keyIndex != 0 && keys[keyIndex] == searchKey) {
+        return values[keyIndex];
+    }
+
+    return V();
+}
+
+//Return number of keys in the index
+template <class K, class V>
+int EytzingerIndex<K,V>::size() {
+    return numKeys;
+}
+
+//FORK-JOIN POOL
+
+//Worker pool for divide-and-conquer recursion. invoke(first, second) offers second to the workers and runs first
+//on the calling thread. If no worker has taken second by then the caller runs it too, and while waiting on a taken
+//task the caller runs other queued tasks, so nested invokes cannot deadlock.
+class ForkJoinPool {
+
+    private:
+        static const int PENDING = 0;
+        static const int TAKEN = 1;
+        static const int DONE = 2;
+
+        struct Task {
+            std::function<void()> work;
+            std::atomic<int> state;
+        };
+
+        std::vector<std::thread> workers;
+        std::deque<std::shared_ptr<Task> > tasks;
+        std::mutex tasksLock;
+        std::condition_variable tasksReady;
+        bool stopping;
+
+        /* Function: runQueued
+         * Description: Claims and runs the most recently queued task, skipping tasks their caller already ran.
+         *              Returns false if there was nothing to run.
+        */
+        bool runQueued() {
+            std::shared_ptr<Task> task;
+
+            {
+                std::lock_guard<std::mutex> guard(tasksLock);
+
+                while (!tasks.empty() && task == NULL) {
+                    int expected = PENDING;
+
+                    if (tasks.back()->state.compare_exchange_strong(expected, TAKEN)) {
+                        task = tasks.back();
+                    }
+
+                    tasks.pop_back();
+                }
+            }
+
+            if (task == NULL) {
+                return false;
+            }
+
+            task->work();
+            task->state.store(DONE, std::memory_order_release);
+            return true;
+        }
+
+        //Worker loop, takes the oldest (largest) task first
+        void work() {
+            while (true) {
+                std::shared_ptr<Task> task;
+
+                {
+                    std::unique_lock<std::mutex> guard(tasksLock);
+                    tasksReady.wait(guard, [this]() { return stopping || !tasks.empty(); });
+
+                    if (tasks.empty()) {
+                        return;
+                    }
+
+                    task = tasks.front();
+                    tasks.pop_front();
+                }
+
+                int expected = PENDING;
+
+                if (task->state.compare_exchange_strong(expected, TAKEN)) {
+                    task->work();
+                    task->state.store(DONE, std::memory_order_release);
+                }
+            }
+        }
+
+    public:
+
+        //Shared pool with one worker per hardware thread besides the caller's
+        static ForkJoinPool& instance() {
+            static ForkJoinPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+            return pool;
+        }
+
+        /* Function: invoke
+         * Description: Runs both functions, the second possibly on a worker, and returns once both have finished.
+         *
+         * Param: First first, Second second
+        */
+        template <typename First, typename Second>
+        void invoke(First first, Second second) {
+            if (workers.empty()) {
+                first();
+                second();
+                return;
+            }
+
+            std::shared_ptr<Task> task = std::make_shared<Task>();
+            task->work = second;
+            task->state.store(PENDING);
+
+            {
+                std::lock_guard<std::mutex> guard(tasksLock);
+                tasks.push_back(task);
+            }
+
+            tasksReady.notify_one();
+            first();
+
+            int expected = PENDING;
+
+            if (task->state.compare_exchange_strong(expected, TAKEN)) {
+                second();
+                return;
+            }
+
+            while (task->state.load(std::memory_order_acquire) != DONE) {
+                if (!runQueued()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        ForkJoinPool(int numWorkers) {
+            stopping = false;
+
+            for (int i = 0; i < numWorkers; i++) {
+                workers.push_back(std::thread([this]() { work(); }));
+            }
+        }
+
+        ForkJoinPool(const ForkJoinPool&) = delete;
+        ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+        ~ForkJoinPool() {
+            {
+                std::lock_guard<std::mutex> guard(tasksLock);
+                stopping = true;
+            }
+
+            tasksReady.notify_all();
+
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+};
+
+/* Function: forkJoin
+ * Description: Runs both functions, in parallel on the shared ForkJoinPool if asked to, and returns once both have finished.
+ *
+ * Param: bool parallel, First first, Second second
+*/
+template <typename First, typename Second>
+void forkJoin(bool parallel, First first, Second second) {
+    if (parallel) {
+        ForkJoinPool::instance().invoke(first, second);
+    }
+
+    else {
+        first();
+        second();
+    }
+}
+
+template <typename K, typename V>
+class IndexedRedBlack;
+
+//RedBlack class to store nodes in a binary-search tree format
+//Nodes are created through the Allocator (NodeArena, HeapAllocator or PmrAllocator) and all released when the tree is destroyed
+template <typename K, typename V, template <class> class Allocator = NodeArena>
+class RedBlack {
+    private:
+        //Number of lookups findMany walks in lockstep
+        static const int LOOKUP_GROUP = 16;
+
+        //Combined size of two subtrees above which the set operations fork their recursion onto the ForkJoinPool
+        static const int PARALLEL_CUTOFF = 1 << 14;
+
+        Node<K,V> *root = NULL;
+        Allocator<Node<K,V> > nodes;
+        std::vector<Node<K,V>*> spine;
+        TraceRecorder* recorder = NULL;
+        TREE_STAT(TreeStats stats;)
+        
+        int blackHeight(Node<K,V>* currNode);
+        template <typename Iterator>
+        Node<K,V>* buildFromSorted(Iterator& iter, int numKeys, long long maxChildKeys);
+        template <typename Key, typename Value>
+        Node<K,V>* assignOrInsert(Key&& newKey, Value&& newValue);
+        Node<K,V>* copySubtree(Node<K,V>* currNode);
+        void destroy(Node<K,V>* currNode);
+        Node<K,V>* difference(Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped);
+        void dropSubtree(Node<K,V>* currNode, std::vector<Node<K,V>*>& dropped);
+        template <typename Callback>
+        void findMany(const std::vector<K>& searchKeys, Callback callback);
+        template <typename Key>
+        Node<K,V>* findNode(const Key& searchKey);
+        Node<K,V>* fixImbalances(Node<K,V>* currNode);  
+        Node<K,V>* flipColours(Node<K,V>* currNode);  
+        Node<K,V>* getMax(Node<K,V>* currNode);
+        Node<K,V>* getSuccessor(Node<K,V>* currNode);    
+        template <typename Key, typename... Args>
+        bool insertIfMissing(Key&& newKey, Args&&... args);
+        Node<K,V>* intersectWith(Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped);
+        bool isRed(Node<K,V>* currNode);
+        Node<K,V>* join(Node<K,V>* lowNode, Node<K,V>* midNode, Node<K,V>* highNode);
+        Node<K,V>* join(Node<K,V>* lowNode, Node<K,V>* highNode);
+        Node<K,V>* joinLeft(Node<K,V>* currNode, Node<K,V>* midNode, Node<K,V>* lowNode, int heightDiff);
+        Node<K,V>* joinRight(Node<K,V>* currNode, Node<K,V>* midNode, Node<K,V>* highNode, int heightDiff);
+        void printInorder(Node<K,V>* currNode);
+        Node<K,V>* moveRedLeft(Node<K,V>* currNode);
+        Node<K,V>* moveRedRight(Node<K,V>* currNode);
+        template <typename Callback>
+        void overlapping(Node<K,V>* currNode, const K& lowKey, const K& highKey, Callback& callback);
+        void printPostorder(Node<K,V>* currNode);
+        void printPreorder(Node<K,V>* currNode);
+        template <typename Create, typename Found>
+        Node<K,V>* put(Node<K,V>* searchNode, const K& newKey, Create& create, Found& found);
+        template <typename Key>
+        Node<K,V>* remove(Node<K,V>* currNode, const Key& searchKey);
+        Node<K,V>* removeMin(Node<K,V>* currNode, Node<K,V>*& minNode);
+        Node<K,V>* removeMax(Node<K,V>* currNode);
+        Node<K,V>* rotateLeft(Node<K,V>* currNode);
+        Node<K,V>* rotateRight(Node<K,V>* currNode);
+        template <typename Callback>
+        void rangeScan(Node<K,V>* currNode, K lowKey, K highKey, Callback& callback);
+        Node<K,V>* split(Node<K,V>* currNode, const K& splitKey, Node<K,V>*& lowNode, Node<K,V>*& highNode);
+        Node<K,V>* splitLast(Node<K,V>* currNode, Node<K,V>*& lastNode);
+        int subtreeSize(Node<K,V>* currNode);
+        template <typename Key>
+        void trace(TraceOp op, const Key& key);
+        Node<K,V>* unionWith(Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped);
+        void updateSize(Node<K,V>* currNode);
+        int validate(Node<K,V>* currNode, const K* lowKey, const K* highKey);
+
+    public:
+        typedef RedBlackIterator<K,V> iterator;
+
+        void appendSorted(K newKey, V newValue);
+        iterator begin();
+        template <typename Iterator>
+        void buildFromSorted(Iterator first, Iterator last);
+        iterator ceiling(K searchKey);
+        void clear();
+        template <typename Key>
+        bool contains(const Key& searchKey);
+        void containsMany(const std::vector<K>& searchKeys, std::vector<bool>& found);
+        void difference(RedBlack& other);
+        template <typename Key, typename Value>
+        bool emplace(Key&& newKey, Value&& newValue);
+        iterator end();
+        template <typename Key>
+        V* find(const Key& searchKey);
+        iterator floor(K searchKey);
+        EytzingerIndex<K,V> freeze();
+        template <typename Key>
+        V get(const Key& searchKey);
+        void getMany(const std::vector<K>& searchKeys, std::vector<V>& values);
+        void intersectWith(RedBlack& other);
+        void join(RedBlack& higher);
+        bool load(const char* path);
+        V min();
+        V max();
+        template <typename Callback>
+        void overlapping(K lowKey, K highKey, Callback callback);
+        void printPreorder();
+        void printPostorder();
+        void printInorder();
+        template <typename Value>
+        void put(const K& newKey, Value&& newValue);
+        template <typename Value>
+        void put(K&& newKey, Value&& newValue);
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        int rank(K searchKey);
+        template <typename Key>
+        void remove(const Key& searchKey);
+        void removeMin();
+        void removeMax();
+        bool save(const char* path);
+        iterator select(int rank);
+        void setRecorder(TraceRecorder* newRecorder);
+        int size();
+        void split(K splitKey, RedBlack& higher);
+        template <typename Callback>
+        void stabbing(K point, Callback callback);
+        template <typename... Args>
+        bool tryEmplace(const K& newKey, Args&&... args);
+        template <typename... Args>
+        bool tryEmplace(K&& newKey, Args&&... args);
+        void unionWith(RedBlack& other);
+        bool validate();
+
+        //Counters and latency histograms, compiled in with -DTREE_STATS (see treeStats.h)
+        TREE_STAT(const TreeStats& getStats() { return stats; })
+        TREE_STAT(void resetStats() { stats.reset(); })
+
+        //Indexes the tree's nodes directly, which stay at one address from put until their key is removed
+        template <typename, typename> friend class IndexedRedBlack;
+
+        RedBlack() {}
+
+        //Takes every node from the resource, for a tree using PmrAllocator (see nodeAllocators.h)
+        RedBlack(std::pmr::memory_resource* resource) : nodes(resource) {}
+
+        RedBlack(const RedBlack&) = delete;
+        RedBlack& operator=(const RedBlack&) = delete;
+
+        ~RedBlack() {
+            clear();
+        }
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: blackHeight
+ * Description: Returns the number of black nodes on the path from the node down its left spine (NULL == 0).
+ *              Every path to a leaf has the same count in a valid tree.
+ * 
+ * Param: Node<K,V>* currNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+int RedBlack<K,V,Allocator>::blackHeight(Node<K,V>* currNode) {
+    int height = 0;
+
+    for (; currNode != NULL; currNode = currNode->left) {
+        if (!isRed(currNode)) {
+            height++;
+        }
+    }
+
+    return height;
+}
+
+/* Function: buildFromSorted
+ * Description: Builds a valid left-leaning red-black subtree from the next numKeys sorted pairs, without rotations.
+ *              The subtree is laid out as a 2-3 tree where every leaf sits at the same depth. Each child may hold
+ *              at most maxChildKeys keys (3^h - 1 for a child 2-3 tree of height h), so the root is made a 2-node
+ *              when its keys fit in two children, and a 3-node (a black node with a red left child) otherwise.
+ *              Nodes are created in key order.
+ *
+ * Param: Iterator& iter, int numKeys, long long maxChildKeys
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Iterator>
+Node<K,V>* RedBlack<K,V,Allocator>::buildFromSorted(Iterator& iter, int numKeys, long long maxChildKeys) {
+
+    if (numKeys == 0) {
+        return NULL;
+    }
+
+    long long grandChildKeys = (maxChildKeys + 1) / 3 - 1;
+
+    //2-node, split the remaining keys evenly between the two children
+    if (numKeys - 1 <= 2 * maxChildKeys) {
+        int leftKeys = numKeys / 2;
+
+        Node<K,V>* leftNode = buildFromSorted(iter, leftKeys, grandChildKeys);
+        Node<K,V>* currNode = nodes.create(iter->first, iter->second, BLACK);
+        TREE_STAT(stats.allocations++;)
+        ++iter;
+
+        currNode->left = leftNode;
+        currNode->right = buildFromSorted(iter, numKeys - 1 - leftKeys, grandChildKeys);
+        updateSize(currNode);
+        return currNode;
+    }
+
+    //3-node, split the remaining keys evenly between the three children
+    int childKeys = (numKeys - 2) / 3;
+    int extraKeys = (numKeys - 2) % 3;
+    int firstKeys = childKeys + (extraKeys > 0);
+    int secondKeys = childKeys + (extraKeys > 1);
+
+    Node<K,V>* firstNode = buildFromSorted(iter, firstKeys, grandChildKeys);
+    Node<K,V>* redNode = nodes.create(iter->first, iter->second, RED);
+    TREE_STAT(stats.allocations++;)
+    ++iter;
+
+    redNode->left = firstNode;
+    redNode->right = buildFromSorted(iter, secondKeys, grandChildKeys);
+    updateSize(redNode);
+
+    Node<K,V>* currNode = nodes.create(iter->first, iter->second, BLACK);
+    TREE_STAT(stats.allocations++;)
+    ++iter;
+
+    currNode->left = redNode;
+    currNode->right = buildFromSorted(iter, childKeys, grandChildKeys);
+    updateSize(currNode);
+    return currNode;
+}
+
+/* Function: assignOrInsert
+ * Description: Replaces the value under the key, or inserts a new node for it. The key is only compared by reference
+ *              on the way down, and is forwarded (copied or moved) into a node only when one has to be created.
+ *              Returns the node holding the key.
+ * 
+ * Param: Key&& newKey, Value&& newValue
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key, typename Value>
+Node<K,V>* RedBlack<K,V,Allocator>::assignOrInsert(Key&& newKey, Value&& newValue) {
+    TREE_STAT(OpTimer timer(stats, TREE_PUT);)
+    Node<K,V>* keyNode = NULL;
+
+    //Only one of create and assign runs, so the value is forwarded once
+    auto create = [&]() {
+        TREE_STAT(stats.allocations++;)
+        keyNode = nodes.create(std::piecewise_construct, RED, std::forward<Key>(newKey), std::forward<Value>(newValue));
+        return keyNode;
+    };
+
+    auto assign = [&](Node<K,V>* foundNode) {
+        foundNode->value = std::forward<Value>(newValue);
+        keyNode = foundNode;
+    };
+
+    root = put(root, newKey, create, assign);
+    root->colour = BLACK;
+    return keyNode;
+}
+
+/* Function: copySubtree
+ * Description: Copies the subtree, colours and sizes included, into this tree's allocator and returns the copy's root.
+ * 
+ * Param: Node<K,V>* currNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::copySubtree(Node<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return NULL;
+    }
+
+    Node<K,V>* copyNode = nodes.create(currNode->key, currNode->value, currNode->colour);
+    TREE_STAT(stats.allocations++;)
+    copyNode->left = copySubtree(currNode->left);
+    copyNode->right = copySubtree(currNode->right);
+    updateSize(copyNode);
+    return copyNode;
+}
+
+/* Function: destroy
+ * Description: Destroys every node in the passed subtree through the allocator.
+ *
+ * Param: currNode (The root of the subtree to destroy)
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::destroy(Node<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return;
+    }
+
+    destroy(currNode->left);
+    destroy(currNode->right);
+    nodes.destroy(currNode);
+    TREE_STAT(stats.frees++;)
+}
+
+/* Function: difference
+ * Description: Returns the tree of this subtree's nodes whose keys are not in the other subtree, splitting this
+ *              subtree at the other's root key and recursing on both halves (in parallel above PARALLEL_CUTOFF).
+ *              Nodes left out are added to dropped, to be destroyed once the recursion has finished.
+ * 
+ * Param: Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::difference(Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped) {
+
+    if (thisNode == NULL) {
+        dropSubtree(otherNode, dropped);
+        return NULL;
+    }
+
+    if (otherNode == NULL) {
+        return thisNode;
+    }
+
+    bool parallel = subtreeSize(thisNode) + subtreeSize(otherNode) >= PARALLEL_CUTOFF;
+    Node<K,V>* otherLeft = otherNode->left;
+    Node<K,V>* otherRight = otherNode->right;
+    Node<K,V>* lowNode;
+    Node<K,V>* highNode;
+    Node<K,V>* foundNode = split(thisNode, otherNode->key, lowNode, highNode);
+    std::vector<Node<K,V>*> highDropped;
+
+    forkJoin(parallel, [&]() { lowNode = difference(lowNode, otherLeft, dropped); },
+                       [&]() { highNode = difference(highNode, otherRight, parallel ? highDropped : dropped); });
+
+    dropped.insert(dropped.end(), highDropped.begin(), highDropped.end());
+    dropped.push_back(otherNode);
+
+    if (foundNode != NULL) {
+        dropped.push_back(foundNode);
+    }
+
+    return join(lowNode, highNode);
+}
+
+/* Function: dropSubtree
+ * Description: Adds every node of the subtree to dropped, iteratively.
+ * 
+ * Param: Node<K,V>* currNode, std::vector<Node<K,V>*>& dropped
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::dropSubtree(Node<K,V>* currNode, std::vector<Node<K,V>*>& dropped) {
+    size_t firstDropped = dropped.size();
+
+    if (currNode != NULL) {
+        dropped.push_back(currNode);
+    }
+
+    //The dropped nodes past firstDropped double as the stack of nodes whose children are still to visit
+    for (size_t i = firstDropped; i < dropped.size(); i++) {
+        if (dropped[i]->left != NULL) {
+            dropped.push_back(dropped[i]->left);
+        }
+
+        if (dropped[i]->right != NULL) {
+            dropped.push_back(dropped[i]->right);
+        }
+    }
+}
+
+/* Function: findMany
+ * Description: Looks up the search keys LOOKUP_GROUP at a time, advancing every lookup in the group by one level per
+ *              pass and prefetching the node each one moves to. The cache misses of the whole group then overlap
+ *              instead of each lookup waiting on its own miss at every level. The callback is called once per key
+ *              with the key's index and its node, or NULL if it is not in the tree.
+ *
+ * Param: const std::vector<K>& searchKeys, Callback callback
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Callback>
+void RedBlack<K,V,Allocator>::findMany(const std::vector<K>& searchKeys, Callback callback) {
+    Node<K,V>* cursors[LOOKUP_GROUP];
+    int numKeys = searchKeys.size();
+
+    for (int groupStart = 0; groupStart < numKeys; groupStart += LOOKUP_GROUP) {
+        int groupSize = numKeys - groupStart < LOOKUP_GROUP ? numKeys - groupStart : LOOKUP_GROUP;
+        int numActive = 0;
+
+        for (int i = 0; i < groupSize; i++) {
+            cursors[i] = root;
+
+            if (root == NULL) {
+                callback(groupStart + i, (Node<K,V>*) NULL);
+            }
+
+            else {
+                numActive++;
+            }
+        }
+
+        while (numActive > 0) {
+            for (int i = 0; i < groupSize; i++) {
+                Node<K,V>* iterNode = cursors[i];
+
+                if (iterNode == NULL) {
+                    continue;
+                }
+
+                const K& searchKey = searchKeys[groupStart + i];
+
+                if (searchKey < iterNode->key) {
+                    iterNode = iterNode->left;
+                }
+
+                else if (searchKey > iterNode->key) {
+                    iterNode = iterNode->right;
+                }
+
+                //Found, report the node and retire this lookup
+                else {
+                    callback(groupStart + i, iterNode);
+                    cursors[i] = NULL;
+                    numActive--;
+                    continue;
+                }
+
+                //Fell off the tree, the key is missing
+                if (iterNode == NULL) {
+                    callback(groupStart + i, (Node<K,V>*) NULL);
+                    numActive--;
+                }
+
+                else {
+                    __builtin_prefetch(iterNode);
+                }
+
+                cursors[i] = iterNode;
+            }
+        }
+    }
+}
+
+/* Function: findNode
+ * Description: Returns the node holding the search key, or NULL if there is none. The search key may be of any type
+ *              that compares with K (e.g. a const char* against string keys), so no K has to be built to look it up.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key>
+Node<K,V>* RedBlack<K,V,Allocator>::findNode(const Key& searchKey) {
+    Node<K,V>* iter = root;
+
+    while (iter != NULL) {
+        TREE_STAT(treeOpDepth++;)
+
+        if (searchKey < iter->key) {
+            TREE_STAT(stats.comparisons++;)
+            iter = iter->left;
+        }
+
+        else if (searchKey > iter->key) {
+            TREE_STAT(stats.comparisons += 2;)
+            iter = iter->right;
+        }
+
+        else {
+            TREE_STAT(stats.comparisons += 2;)
+            return iter;
+        }
+    }
+
+    return NULL;
+}
+
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::fixImbalances(Node<K,V>* currNode) {
+
+    if (isRed(currNode->right)) {
+        currNode = rotateLeft(currNode);
+    }
+
+    if (isRed(currNode->left) && isRed(currNode->left->left)) {
+        currNode = rotateRight(currNode);
+    }
+
+    if (isRed(currNode->left) && isRed(currNode->right)) {
+        currNode = flipColours(currNode);
+    }
+
+    updateSize(currNode);
+    return currNode;
+}
+
+/* Function: flipColours
+ * Description: Flips the colour of the passed node and its two child nodes to be the opposite colour.
+ *
+ * Param: currNode (The current node to flip)
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::flipColours(Node<K,V>* currNode) {
+    TREE_STAT(stats.colourFlips++;)
+    currNode->colour = !currNode->colour;
+    currNode->left->colour = !currNode->left->colour;
+    currNode->right->colour = !currNode->right->colour;
+    return currNode;
+}
+
+/* Function: getSuccessor
+ * Description: Used in node deletion to get the right subtree node for the node replacing the node being deleted.
+ * 
+ * Param: Node<K,V>* searchNode, K newKey, V newValue
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::getSuccessor(Node<K,V>* currNode) {
+    if (currNode->left == NULL) {
+        return currNode->right;
+    }
+
+    currNode->left = getSuccessor(currNode->left);
+    return currNode;
+}
+
+
+/* Function: insertIfMissing
+ * Description: Inserts a node for the key, building its value in place from the arguments, unless the key is
+ *              already in the tree. Returns whether a node was inserted. Nothing is built when the key is present.
+ * 
+ * Param: Key&& newKey, Args&&... args
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key, typename... Args>
+bool RedBlack<K,V,Allocator>::insertIfMissing(Key&& newKey, Args&&... args) {
+    TREE_STAT(OpTimer timer(stats, TREE_PUT);)
+    bool inserted = true;
+
+    auto create = [&]() {
+        TREE_STAT(stats.allocations++;)
+        return nodes.create(std::piecewise_construct, RED, std::forward<Key>(newKey), std::forward<Args>(args)...);
+    };
+
+    auto skip = [&](Node<K,V>* foundNode) {
+        inserted = false;
+    };
+
+    root = put(root, newKey, create, skip);
+    root->colour = BLACK;
+    return inserted;
+}
+
+/* Function: intersectWith
+ * Description: Returns the tree of this subtree's nodes whose keys are also in the other subtree, splitting this
+ *              subtree at the other's root key and recursing on both halves (in parallel above PARALLEL_CUTOFF).
+ *              Nodes left out are added to dropped, to be destroyed once the recursion has finished.
+ * 
+ * Param: Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::intersectWith(Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped) {
+
+    if (thisNode == NULL || otherNode == NULL) {
+        dropSubtree(thisNode, dropped);
+        dropSubtree(otherNode, dropped);
+        return NULL;
+    }
+
+    bool parallel = subtreeSize(thisNode) + subtreeSize(otherNode) >= PARALLEL_CUTOFF;
+    Node<K,V>* otherLeft = otherNode->left;
+    Node<K,V>* otherRight = otherNode->right;
+    Node<K,V>* lowNode;
+    Node<K,V>* highNode;
+    Node<K,V>* foundNode = split(thisNode, otherNode->key, lowNode, highNode);
+    std::vector<Node<K,V>*> highDropped;
+
+    forkJoin(parallel, [&]() { lowNode = intersectWith(lowNode, otherLeft, dropped); },
+                       [&]() { highNode = intersectWith(highNode, otherRight, parallel ? highDropped : dropped); });
+
+    dropped.insert(dropped.end(), highDropped.begin(), highDropped.end());
+    dropped.push_back(otherNode);
+
+    if (foundNode != NULL) {
+        return join(lowNode, foundNode, highNode);
+    }
+
+    return join(lowNode, highNode);
+}
+
+/* Function: isRed
+ * Description: Returns whether or not the passed node is RED. (NULL == BLACK).
+ * 
+ * Param: Node<K,V>* currNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+bool RedBlack<K,V,Allocator>::isRed(Node<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return false;
+    }
+
+    return currNode->colour == RED;
+}
+
+/* Function: join
+ * Description: Joins two trees and a middle node whose key lies between them into one valid tree, in time
+ *              proportional to the difference in their black heights. Red roots are made black first. The shorter
+ *              tree is hung, under the middle node coloured red, from the taller tree's spine at a node of equal black
+ *              height, and the usual insertion fix-ups restore the tree on the way back up.
+ * 
+ * Param: Node<K,V>* lowNode, Node<K,V>* midNode, Node<K,V>* highNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::join(Node<K,V>* lowNode, Node<K,V>* midNode, Node<K,V>* highNode) {
+
+    if (isRed(lowNode)) {
+        lowNode->colour = BLACK;
+    }
+
+    if (isRed(highNode)) {
+        highNode->colour = BLACK;
+    }
+
+    int lowHeight = blackHeight(lowNode);
+    int highHeight = blackHeight(highNode);
+    Node<K,V>* joinedNode = midNode;
+
+    if (lowHeight > highHeight) {
+        joinedNode = joinRight(lowNode, midNode, highNode, lowHeight - highHeight);
+    }
+
+    else if (lowHeight < highHeight) {
+        joinedNode = joinLeft(highNode, midNode, lowNode, highHeight - lowHeight);
+    }
+
+    else {
+        midNode->left = lowNode;
+        midNode->right = highNode;
+        updateSize(midNode);
+    }
+
+    joinedNode->colour = BLACK;
+    return joinedNode;
+}
+
+/* Function: join
+ * Description: Joins two trees, every key of the first below every key of the second, by taking the first tree's
+ *              largest node out as the middle node.
+ * 
+ * Param: Node<K,V>* lowNode, Node<K,V>* highNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::join(Node<K,V>* lowNode, Node<K,V>* highNode) {
+
+    if (lowNode == NULL) {
+        return highNode;
+    }
+
+    if (highNode == NULL) {
+        return lowNode;
+    }
+
+    Node<K,V>* lastNode;
+    lowNode = splitLast(lowNode, lastNode);
+    return join(lowNode, lastNode, highNode);
+}
+
+/* Function: joinLeft
+ * Description: Walks down the left spine of the taller (higher) tree to the first black node whose black height is
+ *              heightDiff less than the current node's, and replaces it with the red middle node joining the lower tree
+ *              to it. Red nodes on the spine do not add to the black height.
+ * 
+ * Param: Node<K,V>* currNode, Node<K,V>* midNode, Node<K,V>* lowNode, int heightDiff
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::joinLeft(Node<K,V>* currNode, Node<K,V>* midNode, Node<K,V>* lowNode, int heightDiff) {
+
+    if (heightDiff == 0 && !isRed(currNode)) {
+        midNode->left = lowNode;
+        midNode->right = currNode;
+        midNode->colour = RED;
+        updateSize(midNode);
+        return midNode;
+    }
+
+    currNode->left = joinLeft(currNode->left, midNode, lowNode, isRed(currNode) ? heightDiff : heightDiff - 1);
+    return fixImbalances(currNode);
+}
+
+/* Function: joinRight
+ * Description: Walks down the right spine of the taller (lower) tree, which holds only black nodes, heightDiff levels
+ *              and replaces the node there with the red middle node joining it to the higher tree.
+ * 
+ * Param: Node<K,V>* currNode, Node<K,V>* midNode, Node<K,V>* highNode, int heightDiff
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::joinRight(Node<K,V>* currNode, Node<K,V>* midNode, Node<K,V>* highNode, int heightDiff) {
+
+    if (heightDiff == 0) {
+        midNode->left = currNode;
+        midNode->right = highNode;
+        midNode->colour = RED;
+        updateSize(midNode);
+        return midNode;
+    }
+
+    currNode->right = joinRight(currNode->right, midNode, highNode, heightDiff - 1);
+    return fixImbalances(currNode);
+}
+
+/* Function: moveRedLeft
+ * Description: Used in minimum node deletion when a red sibling is needed to be borrowed from another node.
+ * This results in the node's left child or grand-child becoming red.
+ *
+ * Param: currNode (The current node being viewed)
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::moveRedLeft(Node<K,V>* currNode) {
+    currNode = flipColours(currNode);
+
+    if (isRed(currNode->right->left)) {
+        currNode->right = rotateRight(currNode->right);
+        currNode = rotateLeft(currNode);
+        currNode = flipColours(currNode);
+    }
+
+    return currNode;
+}
+
+/* Function: moveRedRight
+ * Description: Used in maximum node deletion when a red sibling is needed to be borrowed from another node.
+ * This results in the node's right child or grand-child becoming red.
+ *
+ * Param: currNode (The current node being viewed)
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::moveRedRight(Node<K,V>* currNode) {
+    currNode = flipColours(currNode);
+
+    //If the left->left grandchild is red, move it to the right
+    if (isRed(currNode->left->left)) {
+        currNode = rotateRight(currNode);
+        currNode = flipColours(currNode);
+    }
+
+    return currNode;
+}
+
+/* Function: overlapping
+ * Description: Calls the callback on each interval of the subtree that overlaps [lowKey, highKey], in order of start.
+ *              Subtrees whose largest end is below lowKey are skipped, as are right subtrees of nodes starting after highKey.
+ * 
+ * Param: Node<K,V>* currNode, const K& lowKey, const K& highKey, Callback& callback
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Callback>
+void RedBlack<K,V,Allocator>::overlapping(Node<K,V>* currNode, const K& lowKey, const K& highKey, Callback& callback) {
+
+    if (currNode == NULL || currNode->maxEnd < lowKey) {
+        return;
+    }
+
+    overlapping(currNode->left, lowKey, highKey, callback);
+
+    if (highKey < currNode->key) {
+        return;
+    }
+
+    if (!(currNode->value.end < lowKey)) {
+        callback(currNode->key, currNode->value);
+    }
+
+    overlapping(currNode->right, lowKey, highKey, callback);
+}
+
+/* Function: put
+ * Description: Links a node for the key into the subtree, organized by key, and returns the subtree's new root.
+ *              This function searches the tree recursively, comparing the key by reference. At the bottom the
+ *              node is made by create; if the key is already present, found is called on its node instead,
+ *              before the nodes above it are fixed up (so a changed interval end reaches their maxEnd).
+ * 
+ * Param: Node<K,V>* searchNode, const K& newKey, Create& create, Found& found
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Create, typename Found>
+Node<K,V>* RedBlack<K,V,Allocator>::put(Node<K,V>* searchNode, const K& newKey, Create& create, Found& found) {
+    if (searchNode == NULL) {
+        return create();
+    }
+
+    TREE_STAT(treeOpDepth++;)
+
+    if (newKey < searchNode->key) {
+        TREE_STAT(stats.comparisons++;)
+        searchNode->left = put(searchNode->left, newKey, create, found);
+    }
+
+    else if (newKey > searchNode->key) {
+        TREE_STAT(stats.comparisons += 2;)
+        searchNode->right = put(searchNode->right, newKey, create, found);
+    }
+
+    else {
+        TREE_STAT(stats.comparisons += 2;)
+        found(searchNode);
+    }
+
+    return fixImbalances(searchNode);
+}
+
+/* Function: printInorder
+ * Description: Navigates the tree and prints the values in in-order.
+ * 
+ * Param: currNode (The current node being viewed)
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::printInorder(Node<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return;
+    }
+
+    printInorder(currNode->left);
+    cout << "K: " << currNode->key << " Colour: " << currNode->colour << endl;
+    printInorder(currNode->right);
+}
+
+/* Function: printPostorder
+ * Description: Navigates the tree and prints the values in post-order.
+ * 
+ * Param: currNode (The current node being viewed)
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::printPostorder(Node<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return;
+    }
+
+    printPostorder(currNode->left);
+    printPostorder(currNode->right);
+    cout << "K: " << currNode->key << " Colour: " << currNode->colour << endl;
+}
+
+/* Function: printPreorder
+ * Description: Navigates the tree and prints the values in pre-order.
+ * 
+ * Param: currNode (The current node being viewed)
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::printPreorder(Node<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return;
+    }
+
+    cout << "K: " << currNode->key << " Colour: " << currNode->colour << endl;
+
+    printPreorder(currNode->left);
+    printPreorder(currNode->right);
+}
+
+/* Function: remove
+ * Description: Searches for the given key in the RedBlack and removes it if found. Searching is recursive.
+ *              A node with a right subtree is replaced by relinking its in-order successor into its place, so no
+ *              key or value is copied.
+ * 
+ * Param: Node<K,V>* currNode, const Key& searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key>
+Node<K,V>* RedBlack<K,V,Allocator>::remove(Node<K,V>* currNode, const Key& searchKey) {
+
+    if (currNode == NULL) {
+        return NULL;
+    }
+
+    TREE_STAT(treeOpDepth++;)
+    TREE_STAT(stats.comparisons++;)
+
+    //Current key < search key
+    if (searchKey < currNode->key) {
+        if (!isRed(currNode->left) && !isRed(currNode->left->left)) {
+            currNode = moveRedLeft(currNode);
+        }
+        currNode->left = remove(currNode->left, searchKey);
+    }
+
+    else {
+
+        //Temporarily make left-leaning red links lean right
+        if (isRed(currNode->left)) {
+            currNode = rotateRight(currNode);
+        }
+
+        TREE_STAT(stats.comparisons++;)
+
+        //Node was found at the bottom of the tree, delete it
+        if (searchKey == currNode->key && currNode->right == NULL) {
+            nodes.destroy(currNode);
+            TREE_STAT(stats.frees++;)
+            currNode = NULL;
+            return NULL;
+        }
+
+        if (!isRed(currNode->right) && !isRed(currNode->right->left)) {
+            currNode = moveRedRight(currNode);
+        }
+
+        TREE_STAT(stats.comparisons++;)
+
+        if (currNode->key == searchKey) {
+            Node<K,V>* successorNode = NULL;
+
+            //Unlink the successor and move it into the removed node's place
+            Node<K,V>* rightNode = removeMin(currNode->right, successorNode);
+            successorNode->left = currNode->left;
+            successorNode->right = rightNode;
+            successorNode->colour = currNode->colour;
+
+            nodes.destroy(currNode);
+            TREE_STAT(stats.frees++;)
+            currNode = successorNode;
+        }
+        
+        else {
+            currNode->right = remove(currNode->right, searchKey);
+        }
+    }
+
+    return fixImbalances(currNode);
+}
+
+/* Function: removeMax
+ * Description: Searches through a tree and deletes the maximum node, handling imbalances along the way.
+ * A red link is passed down through the tree to accomplish this.
+ * 
+ * Param: Node<K,V> currNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::removeMax(Node<K,V>* currNode) {
+
+    //Have left-leaning red links temporarily lean right
+    if (isRed(currNode->left)) {
+        currNode = rotateRight(currNode);
+    }
+
+    //Delete the maximum node
+    if (currNode->right == NULL) {
+        nodes.destroy(currNode);
+        TREE_STAT(stats.frees++;)
+        currNode = NULL;
+        return NULL;
+    }
+
+    else {
+
+        //Borrow a node from a sibling node if necessary
+        if (!isRed(currNode->right) && !isRed(currNode->right->left)) {
+            currNode = moveRedRight(currNode);
+        }
+
+        currNode->right = removeMax(currNode->right);
+    }
+
+    //Fix imbalances when traversing back up the tree
+    return fixImbalances(currNode);
+}
+
+/* Function: removeMin
+ * Description: Searches through a tree and unlinks the minimum node, handling imbalances along the way.
+ *              The unlinked node is handed back through minNode, for the caller to destroy or relink.
+ * 
+ * Param: Node<K,V> currNode, Node<K,V>*& minNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::removeMin(Node<K,V>* currNode, Node<K,V>*& minNode) {
+
+    //Unlink the minimum node, which has no children in a left-leaning tree
+    if (currNode->left == NULL) {
+        minNode = currNode;
+        return NULL;
+    }
+
+    else {
+
+        //Borrow from a sibling if necessary
+        if (!isRed(currNode->left) && !isRed(currNode->left->left)) {
+            currNode = moveRedLeft(currNode);
+        }
+
+        currNode->left = removeMin(currNode->left, minNode);
+    }
+
+    //Fix imbalances when traversing back up the tree
+    return fixImbalances(currNode);
+}
+
+/* Function: rotateLeft
+ * Description: Performs a left rotation on the current node to fix right-leaning links.
+ * 
+ * Param: Node<K,V> currNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::rotateLeft(Node<K,V>* currNode) {
+    TREE_STAT(stats.rotations++;)
+    Node<K,V>* tempNode = currNode->right;
+    currNode->right = tempNode->left;
+    tempNode->left = currNode;
+    tempNode->colour = currNode->colour;
+    currNode->colour = RED;
+    updateSize(currNode);
+    updateSize(tempNode);
+
+    return tempNode;
+}
+
+/* Function: rotateRight
+ * Description: Makes a left-leaning red node temporarily lean right.
+ * 
+ * Param: Node<K,V> currNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::rotateRight(Node<K,V>* currNode) {
+    TREE_STAT(stats.rotations++;)
+    Node<K,V>* tempNode = currNode->left;
+    currNode->left = tempNode->right;
+    tempNode->right = currNode;
+    tempNode->colour = currNode->colour;
+    currNode->colour = RED;
+    updateSize(currNode);
+    updateSize(tempNode);
+
+    return tempNode;
+}
+
+
+
+/* Function: rangeScan
+ * Description: Calls the callback on each node of the subtree with a key between lowKey and highKey, in order.
+ *              Subtrees that lie entirely outside of the range are skipped.
+ * 
+ * Param: Node<K,V>* currNode, K lowKey, K highKey, Callback& callback
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Callback>
+void RedBlack<K,V,Allocator>::rangeScan(Node<K,V>* currNode, K lowKey, K highKey, Callback& callback) {
+
+    if (currNode == NULL) {
+        return;
+    }
+
+    TREE_STAT(treeOpDepth++;)
+
+    if (lowKey < currNode->key) {
+        rangeScan(currNode->left, lowKey, highKey, callback);
+    }
+
+    if (!(currNode->key < lowKey) && !(currNode->key > highKey)) {
+        callback(currNode->key, currNode->value);
+    }
+
+    if (highKey > currNode->key) {
+        rangeScan(currNode->right, lowKey, highKey, callback);
+    }
+}
+
+/* Function: split
+ * Description: Splits the subtree into the trees of keys below and above the split key, rejoining the nodes
+ *              passed on the way down. Returns the node holding the split key, or NULL if there is none.
+ * 
+ * Param: Node<K,V>* currNode, const K& splitKey, Node<K,V>*& lowNode, Node<K,V>*& highNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::split(Node<K,V>* currNode, const K& splitKey, Node<K,V>*& lowNode, Node<K,V>*& highNode) {
+
+    if (currNode == NULL) {
+        lowNode = NULL;
+        highNode = NULL;
+        return NULL;
+    }
+
+    Node<K,V>* leftNode = currNode->left;
+    Node<K,V>* rightNode = currNode->right;
+
+    if (splitKey < currNode->key) {
+        Node<K,V>* foundNode = split(leftNode, splitKey, lowNode, highNode);
+        highNode = join(highNode, currNode, rightNode);
+        return foundNode;
+    }
+
+    if (splitKey > currNode->key) {
+        Node<K,V>* foundNode = split(rightNode, splitKey, lowNode, highNode);
+        lowNode = join(leftNode, currNode, lowNode);
+        return foundNode;
+    }
+
+    lowNode = leftNode;
+    highNode = rightNode;
+    return currNode;
+}
+
+/* Function: splitLast
+ * Description: Takes the largest node out of the subtree, returning the rest of the tree and the node through lastNode.
+ * 
+ * Param: Node<K,V>* currNode, Node<K,V>*& lastNode
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::splitLast(Node<K,V>* currNode, Node<K,V>*& lastNode) {
+
+    if (currNode->right == NULL) {
+        lastNode = currNode;
+        return currNode->left;
+    }
+
+    Node<K,V>* rightNode = splitLast(currNode->right, lastNode);
+    return join(currNode->left, currNode, rightNode);
+}
+
+//Returns the number of nodes in the subtree (NULL == 0)
+template <typename K, typename V, template <class> class Allocator>
+int RedBlack<K,V,Allocator>::subtreeSize(Node<K,V>* currNode) {
+
+    if (currNode == NULL) {
+        return 0;
+    }
+
+    return currNode->size;
+}
+
+//Records the operation on the key if a TraceRecorder is attached (see traceRecorder.h)
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key>
+void RedBlack<K,V,Allocator>::trace(TraceOp op, const Key& key) {
+
+    if (recorder != NULL) {
+        recorder->record(op, traceKey(key), 0, size());
+    }
+}
+
+/* Function: unionWith
+ * Description: Returns the tree of every node in either subtree, splitting this subtree at the other's root key and
+ *              recursing on both halves (in parallel above PARALLEL_CUTOFF). Where both hold a key the other's node
+ *              is kept and this subtree's is added to dropped, to be destroyed once the recursion has finished.
+ * 
+ * Param: Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+Node<K,V>* RedBlack<K,V,Allocator>::unionWith(Node<K,V>* thisNode, Node<K,V>* otherNode, std::vector<Node<K,V>*>& dropped) {
+
+    if (thisNode == NULL) {
+        return otherNode;
+    }
+
+    if (otherNode == NULL) {
+        return thisNode;
+    }
+
+    bool parallel = subtreeSize(thisNode) + subtreeSize(otherNode) >= PARALLEL_CUTOFF;
+    Node<K,V>* otherLeft = otherNode->left;
+    Node<K,V>* otherRight = otherNode->right;
+    Node<K,V>* lowNode;
+    Node<K,V>* highNode;
+    Node<K,V>* foundNode = split(thisNode, otherNode->key, lowNode, highNode);
+    std::vector<Node<K,V>*> highDropped;
+
+    forkJoin(parallel, [&]() { lowNode = unionWith(lowNode, otherLeft, dropped); },
+                       [&]() { highNode = unionWith(highNode, otherRight, parallel ? highDropped : dropped); });
+
+    dropped.insert(dropped.end(), highDropped.begin(), highDropped.end());
+
+    if (foundNode != NULL) {
+        dropped.push_back(foundNode);
+    }
+
+    return join(lowNode, otherNode, highNode);
+}
+
+//Recomputes the node's subtree size (and in interval mode its maxEnd) from its children
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::updateSize(Node<K,V>* currNode) {
+    currNode->size = 1 + subtreeSize(currNode->left) + subtreeSize(currNode->right);
+    updateMaxEnd(currNode);
+}
+
+/* Function: validate
+ * Description: Checks the subtree for keys out of order (lowKey and highKey, when not NULL, bound its keys), red
+ *              links leaning right, two red links in a row, uneven black heights and stale sizes or maxEnds.
+ *              Prints the first broken invariant found and returns -1, or returns the subtree's black height.
+ * 
+ * Param: Node<K,V>* currNode, const K* lowKey, const K* highKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+int RedBlack<K,V,Allocator>::validate(Node<K,V>* currNode, const K* lowKey, const K* highKey) {
+
+    if (currNode == NULL) {
+        return 0;
+    }
+
+    if ((lowKey != NULL && !(*lowKey < currNode->key)) || (highKey != NULL && !(currNode->key < *highKey))) {
+        cout << "Error: Keys are out of order." << endl;
+        return -1;
+    }
+
+    if (isRed(currNode->right)) {
+        cout << "Error: Red link leans right." << endl;
+        return -1;
+    }
+
+    if (isRed(currNode) && isRed(currNode->left)) {
+        cout << "Error: Two red links in a row." << endl;
+        return -1;
+    }
+
+    int leftHeight = validate(currNode->left, lowKey, &currNode->key);
+
+    if (leftHeight < 0) {
+        return -1;
+    }
+
+    int rightHeight = validate(currNode->right, &currNode->key, highKey);
+
+    if (rightHeight < 0) {
+        return -1;
+    }
+
+    if (leftHeight != rightHeight) {
+        cout << "Error: Black heights differ." << endl;
+        return -1;
+    }
+
+    if (currNode->size != 1 + subtreeSize(currNode->left) + subtreeSize(currNode->right)) {
+        cout << "Error: Subtree size is stale." << endl;
+        return -1;
+    }
+
+    if (!hasValidMaxEnd(currNode)) {
+        cout << "Error: Interval maxEnd is stale." << endl;
+        return -1;
+    }
+
+    return leftHeight + !isRed(currNode);
+}
+
+
+
+//PUBLIC FUNCTIONS
+
+
+
+/* Function: appendSorted
+ * Description: Inserts a key larger than every key in the tree by walking only the right spine, fixing
+ *              imbalances on the way back up as put would, without any key comparisons or recursion.
+ *              Keys that are not larger than the current maximum are inserted with put.
+ * 
+ * Param: K newKey, V newValue
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::appendSorted(K newKey, V newValue) {
+    spine.clear();
+
+    for (Node<K,V>* iterNode = root; iterNode != NULL; iterNode = iterNode->right) {
+        spine.push_back(iterNode);
+    }
+
+    if (spine.empty() || !(newKey > spine.back()->key)) {
+        put(newKey, newValue);
+        return;
+    }
+
+    Node<K,V>* childNode = nodes.create(newKey, newValue, RED);
+    TREE_STAT(stats.allocations++;)
+
+    for (int i = spine.size() - 1; i >= 0; i--) {
+        spine[i]->right = childNode;
+        childNode = fixImbalances(spine[i]);
+    }
+
+    root = childNode;
+    root->colour = BLACK;
+}
+
+//Returns an iterator to the smallest key in the tree
+template <typename K, typename V, template <class> class Allocator>
+RedBlackIterator<K,V> RedBlack<K,V,Allocator>::begin() {
+    std::vector<Node<K,V>*> path;
+
+    for (Node<K,V>* iterNode = root; iterNode != NULL; iterNode = iterNode->left) {
+        path.push_back(iterNode);
+    }
+
+    return iterator(root, path);
+}
+
+/* Function: buildFromSorted
+ * Description: Replaces the contents of the tree with the (key, value) pairs in the range, in O(n) with no rotations.
+ *              The keys must be strictly increasing. The black height is the smallest h with 3^h - 1 >= n.
+ * 
+ * Param: Iterator first, Iterator last
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Iterator>
+void RedBlack<K,V,Allocator>::buildFromSorted(Iterator first, Iterator last) {
+    int numKeys = std::distance(first, last);
+    long long maxKeys = 2;
+
+    clear();
+
+    while (maxKeys < numKeys) {
+        maxKeys = maxKeys * 3 + 2;
+    }
+
+    root = buildFromSorted(first, numKeys, (maxKeys + 1) / 3 - 1);
+}
+
+/* Function: ceiling
+ * Description: Returns an iterator to the smallest key greater than or equal to the search key, or end() if there is none.
+ * 
+ * Param: K searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+RedBlackIterator<K,V> RedBlack<K,V,Allocator>::ceiling(K searchKey) {
+    std::vector<Node<K,V>*> path;
+    int ceilingDepth = 0;
+
+    for (Node<K,V>* iterNode = root; iterNode != NULL;) {
+        path.push_back(iterNode);
+
+        if (searchKey > iterNode->key) {
+            iterNode = iterNode->right;
+        }
+
+        else {
+            ceilingDepth = path.size();
+
+            if (searchKey == iterNode->key) {
+                break;
+            }
+
+            iterNode = iterNode->left;
+        }
+    }
+
+    path.resize(ceilingDepth);
+    return iterator(root, path);
+}
+
+/* Function: clear
+ * Description: Removes every node from the tree. When the allocator can release all of its memory at once
+ *              and the nodes need no destructor, the nodes are never visited.
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::clear() {
+
+    if (!Allocator<Node<K,V> >::RELEASES_ALL || !std::is_trivially_destructible<Node<K,V> >::value) {
+        destroy(root);
+    }
+
+    nodes.releaseAll();
+    root = NULL;
+}
+
+/* Function: contains
+ * Description: Searches for a node with the given key and returns whether or not it appears in the tree.
+ *              The key may be of any type that compares with K.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key>
+bool RedBlack<K,V,Allocator>::contains(const Key& searchKey) {
+    bool found = findNode(searchKey) != NULL;
+    trace(TRACE_GET, searchKey);
+    return found;
+}
+
+/* Function: containsMany
+ * Description: Sets found[i] to whether searchKeys[i] appears in the tree, interleaving the lookups (see findMany).
+ * 
+ * Param: const std::vector<K>& searchKeys, std::vector<bool>& found
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::containsMany(const std::vector<K>& searchKeys, std::vector<bool>& found) {
+    found.assign(searchKeys.size(), false);
+
+    findMany(searchKeys, [&](int keyIndex, Node<K,V>* foundNode) {
+        found[keyIndex] = foundNode != NULL;
+    });
+}
+
+/* Function: difference
+ * Description: Removes every key that is in the other tree, using join-based splitting in O(m log(n/m + 1)) work
+ *              for trees of sizes m <= n, forked across the ForkJoinPool for large trees.
+ *              The other tree's nodes are taken over, leaving it empty.
+ * 
+ * Param: RedBlack& other
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::difference(RedBlack& other) {
+
+    if (&other == this) {
+        clear();
+        return;
+    }
+
+    std::vector<Node<K,V>*> dropped;
+
+    nodes.adopt(other.nodes);
+    root = difference(root, other.root, dropped);
+    other.root = NULL;
+
+    if (root != NULL) {
+        root->colour = BLACK;
+    }
+
+    for (Node<K,V>* droppedNode : dropped) {
+        nodes.destroy(droppedNode);
+        TREE_STAT(stats.frees++;)
+    }
+}
+
+/* Function: emplace
+ * Description: Inserts a node built from the forwarded key and value unless the key is already in the tree, and
+ *              returns whether it was inserted. Like std::map::emplace the node is built before the search, so it
+ *              is built and thrown away if the key is present; tryEmplace builds nothing in that case.
+ * 
+ * Param: Key&& newKey, Value&& newValue
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key, typename Value>
+bool RedBlack<K,V,Allocator>::emplace(Key&& newKey, Value&& newValue) {
+    TREE_STAT(OpTimer timer(stats, TREE_PUT);)
+    Node<K,V>* newNode = nodes.create(std::piecewise_construct, RED, std::forward<Key>(newKey), std::forward<Value>(newValue));
+    bool inserted = true;
+    TREE_STAT(stats.allocations++;)
+
+    auto create = [newNode]() {
+        return newNode;
+    };
+
+    auto skip = [&](Node<K,V>* foundNode) {
+        inserted = false;
+    };
+
+    root = put(root, newNode->key, create, skip);
+    root->colour = BLACK;
+    trace(TRACE_PUT, newNode->key);
+
+    if (!inserted) {
+        nodes.destroy(newNode);
+        TREE_STAT(stats.frees++;)
+    }
+
+    return inserted;
+}
+
+//Returns the iterator past the largest key in the tree
+template <typename K, typename V, template <class> class Allocator>
+RedBlackIterator<K,V> RedBlack<K,V,Allocator>::end() {
+    return iterator(root, std::vector<Node<K,V>*>());
+}
+
+/* Function: find
+ * Description: Returns a pointer to the value stored under the key, or NULL if it is missing, without copying the
+ *              value. The key may be of any type that compares with K. The pointer is valid until the key is removed.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key>
+V* RedBlack<K,V,Allocator>::find(const Key& searchKey) {
+    TREE_STAT(OpTimer timer(stats, TREE_GET);)
+    Node<K,V>* foundNode = findNode(searchKey);
+    trace(TRACE_GET, searchKey);
+
+    if (foundNode == NULL) {
+        return NULL;
+    }
+
+    return &foundNode->value;
+}
+
+/* Function: floor
+ * Description: Returns an iterator to the largest key less than or equal to the search key, or end() if there is none.
+ * 
+ * Param: K searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+RedBlackIterator<K,V> RedBlack<K,V,Allocator>::floor(K searchKey) {
+    std::vector<Node<K,V>*> path;
+    int floorDepth = 0;
+
+    for (Node<K,V>* iterNode = root; iterNode != NULL;) {
+        path.push_back(iterNode);
+
+        if (searchKey < iterNode->key) {
+            iterNode = iterNode->left;
+        }
+
+        else {
+            floorDepth = path.size();
+
+            if (searchKey == iterNode->key) {
+                break;
+            }
+
+            iterNode = iterNode->right;
+        }
+    }
+
+    path.resize(floorDepth);
+    return iterator(root, path);
+}
+
+/* Function: freeze
+ * Description: Exports the current keys and values into a read-only EytzingerIndex. Later changes to the tree
+ *              are not reflected in the index.
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+EytzingerIndex<K,V> RedBlack<K,V,Allocator>::freeze() {
+    return EytzingerIndex<K,V>(begin(), size());
+}
+
+/* Function: get
+ * Description: Searches for a node with the given key and returns a copy of its value, or V() if it is missing.
+ *              The key may be of any type that compares with K. Use find to read the value without a copy.
+ * 
+ * Param: const Key& searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key>
+V RedBlack<K,V,Allocator>::get(const Key& searchKey) {
+    TREE_STAT(OpTimer timer(stats, TREE_GET);)
+    Node<K,V>* foundNode = findNode(searchKey);
+    trace(TRACE_GET, searchKey);
+
+    if (foundNode == NULL) {
+        return V();
+    }
+
+    return foundNode->value;
+}
+
+/* Function: getMany
+ * Description: Sets values[i] to the value for searchKeys[i], or V() if it is missing, interleaving the lookups (see findMany).
+ * 
+ * Param: const std::vector<K>& searchKeys, std::vector<V>& values
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::getMany(const std::vector<K>& searchKeys, std::vector<V>& values) {
+    values.resize(searchKeys.size());
+
+    findMany(searchKeys, [&](int keyIndex, Node<K,V>* foundNode) {
+        values[keyIndex] = foundNode != NULL ? foundNode->value : V();
+    });
+}
+
+/* Function: intersectWith
+ * Description: Keeps only the keys that are also in the other tree, with this tree's values, using join-based
+ *              splitting in O(m log(n/m + 1)) work for trees of sizes m <= n, forked across the ForkJoinPool for
+ *              large trees. The other tree's nodes are taken over, leaving it empty.
+ * 
+ * Param: RedBlack& other
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::intersectWith(RedBlack& other) {
+
+    if (&other == this) {
+        return;
+    }
+
+    std::vector<Node<K,V>*> dropped;
+
+    nodes.adopt(other.nodes);
+    root = intersectWith(root, other.root, dropped);
+    other.root = NULL;
+
+    if (root != NULL) {
+        root->colour = BLACK;
+    }
+
+    for (Node<K,V>* droppedNode : dropped) {
+        nodes.destroy(droppedNode);
+        TREE_STAT(stats.frees++;)
+    }
+}
+
+/* Function: join
+ * Description: Appends every pair of the higher tree, whose keys must all be greater than this tree's, in O(log n).
+ *              The higher tree's nodes are taken over, leaving it empty.
+ * 
+ * Param: RedBlack& higher
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::join(RedBlack& higher) {
+
+    if (&higher == this) {
+        return;
+    }
+
+    nodes.adopt(higher.nodes);
+    root = join(root, higher.root);
+    higher.root = NULL;
+
+    if (root != NULL) {
+        root->colour = BLACK;
+    }
+}
+
+/* Function: load
+ * Description: Replaces the contents of the tree with a snapshot written by save (from a RedBlack or a BST),
+ *              mapping the file and rebuilding the tree in O(n) with buildFromSorted.
+ *              Returns false, leaving the tree unchanged, if the file is missing, corrupt or of another key/value type.
+ * 
+ * Param: const char* path
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+bool RedBlack<K,V,Allocator>::load(const char* path) {
+    MappedSnapshot<K,V> snapshot(path);
+
+    if (!snapshot.isValid()) {
+        return false;
+    }
+
+    buildFromSorted(snapshot.begin(), snapshot.end());
+    return true;
+}
+
+/* Function: max
+ * Description: Returns the value of the maximum key node in the tree.
+ * 
+ * Param: K newKey, V newValue
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+V RedBlack<K,V,Allocator>::max() {
+    Node<K,V>* iterNode = root;
+
+   while (iterNode->right != NULL) {
+       iterNode = iterNode->right;
+   }
+
+   return iterNode->value;
+}
+
+/* Function: min
+ * Description: Returns the value of the minimum key node in the tree.
+ * 
+ * Param: K newKey, V newValue
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+V RedBlack<K,V,Allocator>::min() {
+    Node<K,V>* iterNode = root;
+
+    while (iterNode->left != NULL) {
+       iterNode = iterNode->left;
+    }
+
+   return iterNode->value;
+}
+
+/* Function: overlapping
+ * Description: Interval mode only. Calls the callback with the start and Interval of every interval overlapping
+ *              [lowKey, highKey] (both ends inclusive), in order of start. Takes O(log n) when nothing overlaps
+ *              and O(k log n) at worst for k results, since the maxEnd field prunes every subtree with no overlap.
+ * 
+ * Param: K lowKey, K highKey, Callback callback
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Callback>
+void RedBlack<K,V,Allocator>::overlapping(K lowKey, K highKey, Callback callback) {
+    overlapping(root, lowKey, highKey, callback);
+}
+
+//Public in-order
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::printInorder() {
+    printInorder(root);
+}
+
+//Public post-order
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::printPostorder() {
+    printPostorder(root);
+}
+
+//Public pre-order
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::printPreorder() {
+    printPreorder(root);
+}
+
+/* Function: put
+ * Description: Inserts the key and value into the RedBlack, or replaces the value if the key is already present.
+ *              The key is copied into the tree only if a node is created; the value is copied or moved once.
+ * 
+ * Param: const K& newKey, Value&& newValue
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Value>
+void RedBlack<K,V,Allocator>::put(const K& newKey, Value&& newValue) {
+    assignOrInsert(newKey, std::forward<Value>(newValue));
+    trace(TRACE_PUT, newKey);
+}
+
+//Public put, moving the key into a new node
+template <typename K, typename V, template <class> class Allocator>
+template <typename Value>
+void RedBlack<K,V,Allocator>::put(K&& newKey, Value&& newValue) {
+    int64_t recordedKey = recorder != NULL ? traceKey(newKey) : 0;
+
+    assignOrInsert(std::move(newKey), std::forward<Value>(newValue));
+    trace(TRACE_PUT, recordedKey);
+}
+
+/* Function: rangeScan
+ * Description: Calls the callback with each key and value between lowKey and highKey (inclusive), in key order.
+ * 
+ * Param: K lowKey, K highKey, Callback callback
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Callback>
+void RedBlack<K,V,Allocator>::rangeScan(K lowKey, K highKey, Callback callback) {
+    TREE_STAT(OpTimer timer(stats, TREE_SCAN);)
+    rangeScan(root, lowKey, highKey, callback);
+}
+
+/* Function: rank
+ * Description: Returns the number of keys in the tree less than the search key.
+ * 
+ * Param: K searchKey
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+int RedBlack<K,V,Allocator>::rank(K searchKey) {
+    Node<K,V>* iter = root;
+    int numLess = 0;
+
+    while (iter != NULL) {
+        if (searchKey < iter->key) {
+            iter = iter->left;
+        }
+
+        else if (searchKey > iter->key) {
+            numLess += 1 + subtreeSize(iter->left);
+            iter = iter->right;
+        }
+
+        else {
+            return numLess + subtreeSize(iter->left);
+        }
+    }
+
+    return numLess;
+}
+
+//Public remove, the key may be of any type that compares with K
+template <typename K, typename V, template <class> class Allocator>
+template <typename Key>
+void RedBlack<K,V,Allocator>::remove(const Key& searchKey) {
+    TREE_STAT(OpTimer timer(stats, TREE_REMOVE);)
+
+    if (findNode(searchKey) != NULL) {
+        root = remove(root, searchKey);
+
+        if (root != NULL) {
+            root->colour = BLACK;
+        }
+    }
+
+    trace(TRACE_REMOVE, searchKey);
+}
+
+//Public removeMax function
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::removeMax() {
+    root = removeMax(root);
+
+    if (root != NULL) {
+        root->colour = BLACK;
+    }
+}
+
+//Public removeMin function
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::removeMin() {
+
+    if (!isRed(root->left) && !(isRed(root->right))) {
+        root->colour = RED;
+    }
+
+    Node<K,V>* minNode = NULL;
+    root = removeMin(root, minNode);
+    nodes.destroy(minNode);
+    TREE_STAT(stats.frees++;)
+
+    if (root != NULL) {
+        root->colour = BLACK;
+    }
+}
+
+/* Function: save
+ * Description: Writes the tree's pairs in key order to a compact, pointer-free snapshot file (see treeSnapshot.h).
+ *              Only available for trivially copyable keys and values. Returns false if the file could not be written.
+ * 
+ * Param: const char* path
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+bool RedBlack<K,V,Allocator>::save(const char* path) {
+    return writeSnapshot<K,V>(path, size(), [this](auto callback) {
+        iterator last = end();
+
+        for (iterator iter = begin(); iter != last; ++iter) {
+            callback(iter->key, iter->value);
+        }
+    });
+}
+
+/* Function: select
+ * Description: Returns an iterator to the key with the passed rank (the number of smaller keys),
+ *              or end() if the rank is out of range.
+ * 
+ * Param: int rank
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+RedBlackIterator<K,V> RedBlack<K,V,Allocator>::select(int rank) {
+    std::vector<Node<K,V>*> path;
+    Node<K,V>* iter = root;
+
+    while (iter != NULL) {
+        int leftSize = subtreeSize(iter->left);
+        path.push_back(iter);
+
+        if (rank < leftSize) {
+            iter = iter->left;
+        }
+
+        else if (rank > leftSize) {
+            rank -= leftSize + 1;
+            iter = iter->right;
+        }
+
+        else {
+            return iterator(root, path);
+        }
+    }
+
+    return end();
+}
+
+/* Function: setRecorder
+ * Description: Records every get, find, contains, put, emplace, tryEmplace and remove from now on to the recorder,
+ *              or stops recording if it is NULL. The recorder must outlive the tree or be detached first.
+ * 
+ * Param: TraceRecorder* newRecorder
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::setRecorder(TraceRecorder* newRecorder) {
+    recorder = newRecorder;
+}
+
+//Return number of nodes in the tree
+template <typename K, typename V, template <class> class Allocator>
+int RedBlack<K,V,Allocator>::size() {
+    return subtreeSize(root);
+}
+
+/* Function: split
+ * Description: Moves every key greater than or equal to the split key into the higher tree, replacing its contents.
+ *              The split itself takes O(log n). A NodeArena owns the nodes carved from it, so the smaller half is
+ *              then copied into a fresh arena (the arenas are swapped first if that half is the lower one). Trees
+ *              on different memory resources copy the higher half into the higher tree's resource.
+ * 
+ * Param: K splitKey, RedBlack& higher
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::split(K splitKey, RedBlack& higher) {
+
+    if (&higher == this) {
+        return;
+    }
+
+    Node<K,V>* lowNode;
+    Node<K,V>* highNode;
+    Node<K,V>* foundNode = split(root, splitKey, lowNode, highNode);
+
+    if (foundNode != NULL) {
+        highNode = join(NULL, foundNode, highNode);
+    }
+
+    if (lowNode != NULL) {
+        lowNode->colour = BLACK;
+    }
+
+    if (highNode != NULL) {
+        highNode->colour = BLACK;
+    }
+
+    higher.clear();
+
+    //Heap nodes, and nodes of a resource the higher tree shares, can simply change trees
+    if (higher.nodes.shares(nodes)) {
+        root = lowNode;
+        higher.root = highNode;
+    }
+
+    //Nodes on another resource are copied into it, so each tree keeps its own resource
+    else if (!Allocator<Node<K,V> >::RELEASES_ALL || subtreeSize(highNode) <= subtreeSize(lowNode)) {
+        higher.root = higher.copySubtree(highNode);
+        destroy(highNode);
+        root = lowNode;
+    }
+
+    else {
+        nodes.swap(higher.nodes);
+        root = copySubtree(lowNode);
+        higher.destroy(lowNode);
+        higher.root = highNode;
+    }
+}
+
+/* Function: stabbing
+ * Description: Interval mode only. Calls the callback with every interval containing the point, in order of start.
+ * 
+ * Param: K point, Callback callback
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename Callback>
+void RedBlack<K,V,Allocator>::stabbing(K point, Callback callback) {
+    overlapping(root, point, point, callback);
+}
+
+/* Function: tryEmplace
+ * Description: Inserts the key with a value built in place from the arguments, unless the key is already in the
+ *              tree, and returns whether it was inserted. Neither the key nor the value is built if it is present.
+ * 
+ * Param: const K& newKey, Args&&... args
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+template <typename... Args>
+bool RedBlack<K,V,Allocator>::tryEmplace(const K& newKey, Args&&... args) {
+    bool inserted = insertIfMissing(newKey, std::forward<Args>(args)...);
+    trace(TRACE_PUT, newKey);
+    return inserted;
+}
+
+//Public tryEmplace, moving the key into the new node
+template <typename K, typename V, template <class> class Allocator>
+template <typename... Args>
+bool RedBlack<K,V,Allocator>::tryEmplace(K&& newKey, Args&&... args) {
+    int64_t recordedKey = recorder != NULL ? traceKey(newKey) : 0;
+    bool inserted = insertIfMissing(std::move(newKey), std::forward<Args>(args)...);
+
+    trace(TRACE_PUT, recordedKey);
+    return inserted;
+}
+
+/* Function: unionWith
+ * Description: Adds every pair of the other tree, the other tree's value winning where both hold a key, using
+ *              join-based splitting in O(m log(n/m + 1)) work for trees of sizes m <= n, forked across the
+ *              ForkJoinPool for large trees. The other tree's nodes are taken over, leaving it empty.
+ * 
+ * Param: RedBlack& other
+*/ 
+template <typename K, typename V, template <class> class Allocator>
+void RedBlack<K,V,Allocator>::unionWith(RedBlack& other) {
+
+    if (&other == this) {
+        return;
+    }
+
+    std::vector<Node<K,V>*> dropped;
+
+    nodes.adopt(other.nodes);
+    root = unionWith(root, other.root, dropped);
+    other.root = NULL;
+
+    if (root != NULL) {
+        root->colour = BLACK;
+    }
+
+    for (Node<K,V>* droppedNode : dropped) {
+        nodes.destroy(droppedNode);
+        TREE_STAT(stats.frees++;)
+    }
+}
+
+/* Function: validate
+ * Description: Checks every red-black invariant (BST order, left-leaning red links, no two reds in a row, a black
+ *              root and equal black heights) along with the size and maxEnd augmentations, for canary builds and tests.
+ *              Prints the first broken invariant and returns false. Takes O(n) time.
+*/
+template <typename K, typename V, template <class> class Allocator>
+bool RedBlack<K,V,Allocator>::validate() {
+
+    if (isRed(root)) {
+        cout << "Error: Root is red." << endl;
+        return false;
+    }
+
+    return validate(root, NULL, NULL) >= 0;
+}
+
+//SHARDED REDBLACK
+
+//One key range of a ShardedRedBlack, holding the keys from lowKey up to the next shard's lowKey
+template <class K, class V>
+class Shard {
+
+    public:
+        K lowKey;
+        RedBlack<K,V> tree;
+        std::shared_mutex lock;
+        std::atomic<long long> load;
+
+        Shard(K lowKey) {
+            this->lowKey = lowKey;
+            load.store(0);
+        }
+};
+
+//Concurrent ordered map that partitions the key space into shards, each a RedBlack tree with its own
+//reader-writer lock. Point operations lock exactly one shard. When one shard takes a skewed share of the
+//operations, it is split at its median key and the coldest pair of neighbouring shards is merged, so the number
+//of shards stays the same. A map of one or two shards never rebalances, since no shard can take more than
+//SKEW_FACTOR times the average load.
+template <typename K, typename V>
+class ShardedRedBlack {
+    private:
+        //Operations on one shard between skew checks, and the share of the average load that counts as skewed
+        static const int CHECK_INTERVAL = 1 << 16;
+        static const int SKEW_FACTOR = 2;
+
+        //Shards in key order, the first shard also holds every key below its lowKey
+        std::vector<Shard<K,V>*> shards;
+        std::shared_mutex shardsLock;
+        std::atomic<bool> rebalancing;
+
+        bool countOperation(Shard<K,V>* shard);
+        Shard<K,V>* findShard(const K& searchKey);
+        void mergeShards(int shardIndex);
+        void rebalance();
+        void splitShard(int shardIndex);
+        void tryRebalance();
+
+    public:
+        bool contains(K searchKey);
+        V get(K searchKey);
+        V min();
+        V max();
+        int numShards();
+        void put(K newKey, V newValue);
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        void remove(K searchKey);
+        int size();
+        std::vector<K> splitKeys();
+
+        ShardedRedBlack(std::vector<K> splitKeys);
+        ShardedRedBlack(const ShardedRedBlack&) = delete;
+        ShardedRedBlack& operator=(const ShardedRedBlack&) = delete;
+
+        ~ShardedRedBlack() {
+            for (Shard<K,V>* shard : shards) {
+                delete shard;
+            }
+        }
+};
+
+/* Function: ShardedRedBlack
+ * Description: Creates one shard below the first split key and one starting at each split key.
+ *              The split keys must be strictly increasing.
+ *
+ * Param: std::vector<K> splitKeys
+*/
+template <typename K, typename V>
+ShardedRedBlack<K,V>::ShardedRedBlack(std::vector<K> splitKeys) {
+    rebalancing.store(false);
+    shards.push_back(new Shard<K,V>(splitKeys.empty() ? K() : splitKeys[0]));
+
+    for (K& splitKey : splitKeys) {
+        shards.push_back(new Shard<K,V>(splitKey));
+    }
+}
+
+//PRIVATE FUNCTIONS
+
+/* Function: countOperation
+ * Description: Counts an operation against the shard and returns whether it was the shard's CHECK_INTERVAL'th,
+ *              in which case the caller should call tryRebalance once it has released its locks. shardsLock must
+ *              be held, so that the shard cannot be merged away and deleted while it is counted.
+ *
+ * Param: Shard<K,V>* shard
+*/
+template <typename K, typename V>
+bool ShardedRedBlack<K,V>::countOperation(Shard<K,V>* shard) {
+    return (shard->load.fetch_add(1, std::memory_order_relaxed) + 1) % CHECK_INTERVAL == 0;
+}
+
+/* Function: findShard
+ * Description: Returns the last shard whose lowKey is not greater than the search key. shardsLock must be held.
+ *
+ * Param: K searchKey
+*/
+template <typename K, typename V>
+Shard<K,V>* ShardedRedBlack<K,V>::findShard(const K& searchKey) {
+    int low = 1;
+    int high = shards.size() - 1;
+    int shardIndex = 0;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+
+        if (searchKey < shards[mid]->lowKey) {
+            high = mid - 1;
+        }
+
+        else {
+            shardIndex = mid;
+            low = mid + 1;
+        }
+    }
+
+    return shards[shardIndex];
+}
+
+/* Function: mergeShards
+ * Description: Merges the shard at the passed index with the one after it, rebuilding the tree from both in O(n).
+ *              shardsLock must be held exclusively.
+ *
+ * Param: int shardIndex
+*/
+template <typename K, typename V>
+void ShardedRedBlack<K,V>::mergeShards(int shardIndex) {
+    Shard<K,V>* lowShard = shards[shardIndex];
+    Shard<K,V>* highShard = shards[shardIndex + 1];
+    std::vector<std::pair<K,V> > pairs;
+
+    for (RedBlackIterator<K,V> iter = lowShard->tree.begin(); iter != lowShard->tree.end(); ++iter) {
+        pairs.push_back(std::make_pair(iter->key, iter->value));
+    }
+
+    for (RedBlackIterator<K,V> iter = highShard->tree.begin(); iter != highShard->tree.end(); ++iter) {
+        pairs.push_back(std::make_pair(iter->key, iter->value));
+    }
+
+    lowShard->tree.buildFromSorted(pairs.begin(), pairs.end());
+    lowShard->load.fetch_add(highShard->load.load());
+
+    delete highShard;
+    shards.erase(shards.begin() + shardIndex + 1);
+}
+
+/* Function: rebalance
+ * Description: Splits the hottest shard if its load is more than SKEW_FACTOR times the average, then merges the
+ *              coldest pair of neighbouring shards other than the two halves, keeping the number of shards the same.
+ *              The merged pair may hold one of the halves, as it must when there were three shards, which moves the
+ *              boundary between that half and its neighbour. Loads are then reset. shardsLock must be held exclusively.
+*/
+template <typename K, typename V>
+void ShardedRedBlack<K,V>::rebalance() {
+    long long totalLoad = 0;
+    int hotIndex = 0;
+
+    for (int i = 0; i < (int) shards.size(); i++) {
+        totalLoad += shards[i]->load.load();
+
+        if (shards[i]->load.load() > shards[hotIndex]->load.load()) {
+            hotIndex = i;
+        }
+    }
+
+    if (shards[hotIndex]->load.load() * (long long) shards.size() <= SKEW_FACTOR * totalLoad ||
+        shards[hotIndex]->tree.size() < 2) {
+        return;
+    }
+
+    splitShard(hotIndex);
+
+    int coldIndex = -1;
+
+    for (int i = 0; i + 1 < (int) shards.size(); i++) {
+        long long pairLoad = shards[i]->load.load() + shards[i + 1]->load.load();
+
+        if (i == hotIndex) {
+            continue;
+        }
+
+        if (coldIndex < 0 || pairLoad < shards[coldIndex]->load.load() + shards[coldIndex + 1]->load.load()) {
+            coldIndex = i;
+        }
+    }
+
+    if (coldIndex >= 0) {
+        mergeShards(coldIndex);
+    }
+
+    for (Shard<K,V>* shard : shards) {
+        shard->load.store(0);
+    }
+}
+
+/* Function: splitShard
+ * Description: Splits the shard at the passed index at its median key, rebuilding both halves in O(n).
+ *              shardsLock must be held exclusively.
+ *
+ * Param: int shardIndex
+*/
+template <typename K, typename V>
+void ShardedRedBlack<K,V>::splitShard(int shardIndex) {
+    Shard<K,V>* lowShard = shards[shardIndex];
+    std::vector<std::pair<K,V> > pairs;
+
+    for (RedBlackIterator<K,V> iter = lowShard->tree.begin(); iter != lowShard->tree.end(); ++iter) {
+        pairs.push_back(std::make_pair(iter->key, iter->value));
+    }
+
+    int middle = pairs.size() / 2;
+    Shard<K,V>* highShard = new Shard<K,V>(pairs[middle].first);
+
+    lowShard->tree.buildFromSorted(pairs.begin(), pairs.begin() + middle);
+    highShard->tree.buildFromSorted(pairs.begin() + middle, pairs.end());
+    highShard->load.store(lowShard->load.load() / 2);
+    lowShard->load.store(lowShard->load.load() - highShard->load.load());
+
+    shards.insert(shards.begin() + shardIndex + 1, highShard);
+}
+
+/* Function: tryRebalance
+ * Description: Takes shardsLock exclusively and rebalances the shards. Only one thread waits for the lock at a
+ *              time; the others skip the check, as the waiting thread will make it. Must be called without holding
+ *              any lock.
+*/
+template <typename K, typename V>
+void ShardedRedBlack<K,V>::tryRebalance() {
+
+    if (rebalancing.exchange(true)) {
+        return;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> tableGuard(shardsLock);
+        rebalance();
+    }
+
+    rebalancing.store(false);
+}
+
+//PUBLIC FUNCTIONS
+
+//Returns whether or not the key appears in the map
+template <typename K, typename V>
+bool ShardedRedBlack<K,V>::contains(K searchKey) {
+    bool containsKey;
+    bool checkDue;
+
+    {
+        std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+        Shard<K,V>* shard = findShard(searchKey);
+        std::shared_lock<std::shared_mutex> shardGuard(shard->lock);
+        containsKey = shard->tree.contains(searchKey);
+        checkDue = countOperation(shard);
+    }
+
+    if (checkDue) {
+        tryRebalance();
+    }
+
+    return containsKey;
+}
+
+//Returns the value associated with the key
+template <typename K, typename V>
+V ShardedRedBlack<K,V>::get(K searchKey) {
+    V value;
+    bool checkDue;
+
+    {
+        std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+        Shard<K,V>* shard = findShard(searchKey);
+        std::shared_lock<std::shared_mutex> shardGuard(shard->lock);
+        value = shard->tree.get(searchKey);
+        checkDue = countOperation(shard);
+    }
+
+    if (checkDue) {
+        tryRebalance();
+    }
+
+    return value;
+}
+
+//Returns the value of the maximum key in the map, or V() if the map is empty
+template <typename K, typename V>
+V ShardedRedBlack<K,V>::max() {
+    std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+
+    for (int i = shards.size() - 1; i >= 0; i--) {
+        std::shared_lock<std::shared_mutex> shardGuard(shards[i]->lock);
+
+        if (shards[i]->tree.size() > 0) {
+            return shards[i]->tree.max();
+        }
+    }
+
+    return V();
+}
+
+//Returns the value of the minimum key in the map, or V() if the map is empty
+template <typename K, typename V>
+V ShardedRedBlack<K,V>::min() {
+    std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+
+    for (Shard<K,V>* shard : shards) {
+        std::shared_lock<std::shared_mutex> shardGuard(shard->lock);
+
+        if (shard->tree.size() > 0) {
+            return shard->tree.min();
+        }
+    }
+
+    return V();
+}
+
+//Returns the number of shards the key space is currently split into
+template <typename K, typename V>
+int ShardedRedBlack<K,V>::numShards() {
+    std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+    return shards.size();
+}
+
+//Inserts the key and value into the shard covering the key
+template <typename K, typename V>
+void ShardedRedBlack<K,V>::put(K newKey, V newValue) {
+    bool checkDue;
+
+    {
+        std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+        Shard<K,V>* shard = findShard(newKey);
+        std::unique_lock<std::shared_mutex> shardGuard(shard->lock);
+        shard->tree.put(newKey, newValue);
+        checkDue = countOperation(shard);
+    }
+
+    if (checkDue) {
+        tryRebalance();
+    }
+}
+
+/* Function: rangeScan
+ * Description: Calls the callback with each key and value between lowKey and highKey (inclusive), in key order,
+ *              visiting the overlapping shards one at a time. Each shard is read consistently, but keys in
+ *              shards not yet visited may change during the scan.
+ *
+ * Param: K lowKey, K highKey, Callback callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void ShardedRedBlack<K,V>::rangeScan(K lowKey, K highKey, Callback callback) {
+    std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+
+    for (int i = 0; i < (int) shards.size(); i++) {
+        if (i + 1 < (int) shards.size() && !(lowKey < shards[i + 1]->lowKey)) {
+            continue;
+        }
+
+        if (i > 0 && highKey < shards[i]->lowKey) {
+            break;
+        }
+
+        std::shared_lock<std::shared_mutex> shardGuard(shards[i]->lock);
+        shards[i]->tree.rangeScan(lowKey, highKey, callback);
+    }
+}
+
+//Removes the key from the shard covering it
+template <typename K, typename V>
+void ShardedRedBlack<K,V>::remove(K searchKey) {
+    bool checkDue;
+
+    {
+        std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+        Shard<K,V>* shard = findShard(searchKey);
+        std::unique_lock<std::shared_mutex> shardGuard(shard->lock);
+        shard->tree.remove(searchKey);
+        checkDue = countOperation(shard);
+    }
+
+    if (checkDue) {
+        tryRebalance();
+    }
+}
+
+//Return number of keys across all shards
+template <typename K, typename V>
+int ShardedRedBlack<K,V>::size() {
+    std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+    int numKeys = 0;
+
+    for (Shard<K,V>* shard : shards) {
+        std::shared_lock<std::shared_mutex> shardGuard(shard->lock);
+        numKeys += shard->tree.size();
+    }
+
+    return numKeys;
+}
+
+//Returns the lowKey of every shard after the first, in key order
+template <typename K, typename V>
+std::vector<K> ShardedRedBlack<K,V>::splitKeys() {
+    std::shared_lock<std::shared_mutex> tableGuard(shardsLock);
+    std::vector<K> keys;
+
+    for (int i = 1; i < (int) shards.size(); i++) {
+        keys.push_back(shards[i]->lowKey);
+    }
+
+    return keys;
+}
+
+//WRITE-BUFFERED REDBLACK
+
+//A put or remove waiting in a BufferedRedBlack's staging area
+template <class K, class V>
+class StagedWrite {
+
+    public:
+        K key;
+        V value;
+        bool removed;
+
+        StagedWrite(K key, V value, bool removed) {
+            this->key = key;
+            this->value = value;
+            this->removed = removed;
+        }
+};
+
+//Ordered map for ingest bursts: puts and removes are collected in a staging area instead of walking and
+//rebalancing the tree one at a time. The staging area is sorted and flushed into the tree in one batch once it
+//holds 1/BUFFER_SHARE of the tree (or minCapacity writes). get and contains check the staging area first,
+//through a hash index of the staged keys. Ordered and whole-tree operations flush before they run.
+template <typename K, typename V>
+class BufferedRedBlack {
+    private:
+        //The staging area may grow to 1/BUFFER_SHARE of the tree before it is flushed. A flush at least that
+        //large is merged with the tree's pairs and rebuilt in O(n), smaller flushes put each write in key order.
+        static const int BUFFER_SHARE = 4;
+
+        RedBlack<K,V> tree;
+        std::vector<StagedWrite<K,V> > staged;
+        std::vector<int> stagedIndex;
+        int minCapacity;
+
+        int findStaged(const K& searchKey);
+        size_t hashSlot(const K& searchKey);
+        void mergeRebuild();
+        void stage(K key, V value, bool removed);
+
+    public:
+        bool contains(K searchKey);
+        void flush();
+        V get(K searchKey);
+        V min();
+        V max();
+        int numBuffered();
+        void put(K newKey, V newValue);
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        void remove(K searchKey);
+        int size();
+
+        BufferedRedBlack(int minCapacity = 4096) : stagedIndex(16, -1) {
+            this->minCapacity = minCapacity;
+        }
+
+        BufferedRedBlack(const BufferedRedBlack&) = delete;
+        BufferedRedBlack& operator=(const BufferedRedBlack&) = delete;
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: findStaged
+ * Description: Returns the position of the key in the staging area, or -1 if it has no staged write.
+ *
+ * Param: const K& searchKey
+*/
+template <typename K, typename V>
+int BufferedRedBlack<K,V>::findStaged(const K& searchKey) {
+    size_t mask = stagedIndex.size() - 1;
+
+    for (size_t slot = hashSlot(searchKey); stagedIndex[slot] != -1; slot = (slot + 1) & mask) {
+        if (staged[stagedIndex[slot]].key == searchKey) {
+            return stagedIndex[slot];
+        }
+    }
+
+    return -1;
+}
+
+//Returns the key's home slot in the (power of two sized) staging index, mixing the hash so sequential keys spread out
+template <typename K, typename V>
+size_t BufferedRedBlack<K,V>::hashSlot(const K& searchKey) {
+    return (std::hash<K>()(searchKey) * 0x9E3779B97F4A7C15ULL >> 20) & (stagedIndex.size() - 1);
+}
+
+/* Function: mergeRebuild
+ * Description: Merges the sorted staging area with the tree's pairs in one in-order pass, letting staged writes
+ *              replace or remove the tree's pairs, and rebuilds the tree from the result in O(n).
+*/
+template <typename K, typename V>
+void BufferedRedBlack<K,V>::mergeRebuild() {
+    std::vector<std::pair<K,V> > pairs;
+    RedBlackIterator<K,V> iter = tree.begin();
+    RedBlackIterator<K,V> last = tree.end();
+    size_t stagedPos = 0;
+
+    pairs.reserve(tree.size() + staged.size());
+
+    while (iter != last || stagedPos < staged.size()) {
+        if (stagedPos == staged.size() || (iter != last && iter->key < staged[stagedPos].key)) {
+            pairs.push_back(std::make_pair(iter->key, iter->value));
+            ++iter;
+        }
+
+        else {
+
+            //The staged write replaces the tree's pair for the same key
+            if (iter != last && !(staged[stagedPos].key < iter->key)) {
+                ++iter;
+            }
+
+            if (!staged[stagedPos].removed) {
+                pairs.push_back(std::make_pair(staged[stagedPos].key, staged[stagedPos].value));
+            }
+
+            stagedPos++;
+        }
+    }
+
+    tree.buildFromSorted(pairs.begin(), pairs.end());
+}
+
+/* Function: stage
+ * Description: Records the write in the staging area, replacing any earlier staged write to the same key,
+ *              and flushes once the staging area is full.
+ *
+ * Param: K key, V value, bool removed
+*/
+template <typename K, typename V>
+void BufferedRedBlack<K,V>::stage(K key, V value, bool removed) {
+    int stagedPos = findStaged(key);
+
+    if (stagedPos != -1) {
+        staged[stagedPos].value = value;
+        staged[stagedPos].removed = removed;
+        return;
+    }
+
+    //Keep the index at most half full, rehashing the staged keys into a table twice the size
+    if (2 * (staged.size() + 1) > stagedIndex.size()) {
+        stagedIndex.assign(2 * stagedIndex.size(), -1);
+
+        for (int i = 0; i < (int) staged.size(); i++) {
+            size_t slot = hashSlot(staged[i].key);
+
+            while (stagedIndex[slot] != -1) {
+                slot = (slot + 1) & (stagedIndex.size() - 1);
+            }
+
+            stagedIndex[slot] = i;
+        }
+    }
+
+    size_t slot = hashSlot(key);
+
+    while (stagedIndex[slot] != -1) {
+        slot = (slot + 1) & (stagedIndex.size() - 1);
+    }
+
+    stagedIndex[slot] = staged.size();
+    staged.push_back(StagedWrite<K,V>(key, value, removed));
+
+    if ((int) staged.size() >= std::max(minCapacity, tree.size() / BUFFER_SHARE)) {
+        flush();
+    }
+}
+
+//PUBLIC FUNCTIONS
+
+//Returns whether or not the key appears in the map, checking the staging area first
+template <typename K, typename V>
+bool BufferedRedBlack<K,V>::contains(K searchKey) {
+    int stagedPos = findStaged(searchKey);
+
+    if (stagedPos != -1) {
+        return !staged[stagedPos].removed;
+    }
+
+    return tree.contains(searchKey);
+}
+
+/* Function: flush
+ * Description: Sorts the staging area and applies it to the tree, then empties it.
+ *              Large flushes are merged and rebuilt in O(n), small ones put or remove each key in order.
+*/
+template <typename K, typename V>
+void BufferedRedBlack<K,V>::flush() {
+    if (staged.empty()) {
+        return;
+    }
+
+    std::sort(staged.begin(), staged.end(), [](const StagedWrite<K,V>& first, const StagedWrite<K,V>& second) {
+        return first.key < second.key;
+    });
+
+    if ((int) staged.size() * BUFFER_SHARE >= tree.size()) {
+        mergeRebuild();
+    }
+
+    else {
+        for (StagedWrite<K,V>& write : staged) {
+            if (write.removed) {
+                tree.remove(write.key);
+            }
+
+            else {
+                tree.put(write.key, write.value);
+            }
+        }
+    }
+
+    staged.clear();
+    std::fill(stagedIndex.begin(), stagedIndex.end(), -1);
+}
+
+//Returns the value associated with the key, checking the staging area first
+template <typename K, typename V>
+V BufferedRedBlack<K,V>::get(K searchKey) {
+    int stagedPos = findStaged(searchKey);
+
+    if (stagedPos != -1) {
+        return staged[stagedPos].removed ? V() : staged[stagedPos].value;
+    }
+
+    return tree.get(searchKey);
+}
+
+//Flushes and returns the value of the maximum key in the map
+template <typename K, typename V>
+V BufferedRedBlack<K,V>::max() {
+    flush();
+    return tree.max();
+}
+
+//Flushes and returns the value of the minimum key in the map
+template <typename K, typename V>
+V BufferedRedBlack<K,V>::min() {
+    flush();
+    return tree.min();
+}
+
+//Returns the number of writes waiting in the staging area
+template <typename K, typename V>
+int BufferedRedBlack<K,V>::numBuffered() {
+    return staged.size();
+}
+
+//Stages an insert of the key and value
+template <typename K, typename V>
+void BufferedRedBlack<K,V>::put(K newKey, V newValue) {
+    stage(newKey, newValue, false);
+}
+
+/* Function: rangeScan
+ * Description: Flushes, then calls the callback with each key and value between lowKey and highKey (inclusive), in key order.
+ *
+ * Param: K lowKey, K highKey, Callback callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void BufferedRedBlack<K,V>::rangeScan(K lowKey, K highKey, Callback callback) {
+    flush();
+    tree.rangeScan(lowKey, highKey, callback);
+}
+
+//Stages a removal of the key
+template <typename K, typename V>
+void BufferedRedBlack<K,V>::remove(K searchKey) {
+    stage(searchKey, V(), true);
+}
+
+//Flushes and returns the number of keys in the map
+template <typename K, typename V>
+int BufferedRedBlack<K,V>::size() {
+    flush();
+    return tree.size();
+}
+
+//HASH-INDEXED REDBLACK
+
+//Slot of an IndexedRedBlack's hash index, an empty slot has no node
+template <class K, class V>
+struct IndexSlot {
+    uint64_t hash;
+    Node<K,V>* node;
+};
+
+//Ordered map for lookup-heavy traffic: a RedBlack keeps the keys in order for min, max and range scans, and an
+//open-addressing hash index (linear probing, at most half full) points straight at the tree's nodes, so get and
+//contains take O(1) expected time, usually a cache miss for the slot and one for the node. Each slot keeps the
+//key's full hash, so probes past other keys rarely touch their nodes. Updates of present keys also skip the tree.
+//put and remove keep both structures in step: the index makes room before the tree is changed, so a failed
+//allocation leaves the map as it was.
+template <typename K, typename V>
+class IndexedRedBlack {
+    private:
+        RedBlack<K,V> tree;
+        std::vector<IndexSlot<K,V> > slots;
+        int numIndexed = 0;
+        long long numMoved = 0;
+
+        size_t findSlot(const K& searchKey, uint64_t hash);
+        void growIndex();
+        uint64_t hashKey(const K& searchKey);
+        void unlinkSlot(size_t slot);
+
+    public:
+        void clear();
+        bool contains(const K& searchKey);
+        V* find(const K& searchKey);
+        V get(const K& searchKey);
+        size_t indexBytes();
+        V min();
+        V max();
+        long long numSlotMoves();
+        void put(const K& newKey, const V& newValue);
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        void remove(const K& searchKey);
+        int size();
+
+        IndexedRedBlack() : slots(16, IndexSlot<K,V>{0, NULL}) {}
+        IndexedRedBlack(const IndexedRedBlack&) = delete;
+        IndexedRedBlack& operator=(const IndexedRedBlack&) = delete;
+};
+
+//PRIVATE FUNCTIONS
+
+/* Function: findSlot
+ * Description: Returns the slot holding the key, or the empty slot where probing for it stopped (where it belongs).
+ *
+ * Param: const K& searchKey, uint64_t hash
+*/
+template <typename K, typename V>
+size_t IndexedRedBlack<K,V>::findSlot(const K& searchKey, uint64_t hash) {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+
+    while (slots[slot].node != NULL && (slots[slot].hash != hash || !(slots[slot].node->key == searchKey))) {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+//Doubles the index and reinserts every slot by its stored hash, without touching the nodes
+template <typename K, typename V>
+void IndexedRedBlack<K,V>::growIndex() {
+    std::vector<IndexSlot<K,V> > oldSlots(slots.size() * 2, IndexSlot<K,V>{0, NULL});
+    size_t mask = oldSlots.size() - 1;
+
+    oldSlots.swap(slots);
+
+    for (IndexSlot<K,V>& oldSlot : oldSlots) {
+        if (oldSlot.node != NULL) {
+            size_t slot = oldSlot.hash & mask;
+
+            while (slots[slot].node != NULL) {
+                slot = (slot + 1) & mask;
+            }
+
+            slots[slot] = oldSlot;
+            numMoved++;
+        }
+    }
+}
+
+//Returns the key's hash, mixed so that sequential keys (whose std::hash is often the key itself) spread out
+template <typename K, typename V>
+uint64_t IndexedRedBlack<K,V>::hashKey(const K& searchKey) {
+    uint64_t hash = std::hash<K>()(searchKey);
+    hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDULL;
+    return hash ^ (hash >> 33);
+}
+
+/* Function: unlinkSlot
+ * Description: Empties the slot and shifts later keys of the same probe run back into the gap, so that
+ *              linear probing needs no tombstones.
+ *
+ * Param: size_t slot
+*/
+template <typename K, typename V>
+void IndexedRedBlack<K,V>::unlinkSlot(size_t slot) {
+    size_t mask = slots.size() - 1;
+    size_t nextSlot = (slot + 1) & mask;
+
+    for (; slots[nextSlot].node != NULL; nextSlot = (nextSlot + 1) & mask) {
+        size_t homeSlot = slots[nextSlot].hash & mask;
+
+        //The key may fill the gap if the gap lies between its home slot and its slot (cyclically)
+        if (((nextSlot - homeSlot) & mask) >= ((nextSlot - slot) & mask)) {
+            slots[slot] = slots[nextSlot];
+            slot = nextSlot;
+            numMoved++;
+        }
+    }
+
+    slots[slot].node = NULL;
+}
+
+//PUBLIC FUNCTIONS
+
+//Removes every key from the map
+template <typename K, typename V>
+void IndexedRedBlack<K,V>::clear() {
+    tree.clear();
+    slots.assign(16, IndexSlot<K,V>{0, NULL});
+    numIndexed = 0;
+}
+
+//Returns whether or not the key appears in the map, through the hash index
+template <typename K, typename V>
+bool IndexedRedBlack<K,V>::contains(const K& searchKey) {
+    return slots[findSlot(searchKey, hashKey(searchKey))].node != NULL;
+}
+
+//Returns a pointer to the value stored under the key, or NULL if it is missing, through the hash index
+template <typename K, typename V>
+V* IndexedRedBlack<K,V>::find(const K& searchKey) {
+    Node<K,V>* foundNode = slots[findSlot(searchKey, hashKey(searchKey))].node;
+    return foundNode != NULL ? &foundNode->value : NULL;
+}
+
+//Returns the value associated with the key, or V() if it is missing, through the hash index
+template <typename K, typename V>
+V IndexedRedBlack<K,V>::get(const K& searchKey) {
+    Node<K,V>* foundNode = slots[findSlot(searchKey, hashKey(searchKey))].node;
+    return foundNode != NULL ? foundNode->value : V();
+}
+
+//Returns the memory held by the hash index, on top of the tree's nodes
+template <typename K, typename V>
+size_t IndexedRedBlack<K,V>::indexBytes() {
+    return slots.capacity() * sizeof(IndexSlot<K,V>);
+}
+
+//Returns the value of the maximum key in the map
+template <typename K, typename V>
+V IndexedRedBlack<K,V>::max() {
+    return tree.max();
+}
+
+//Returns the value of the minimum key in the map
+template <typename K, typename V>
+V IndexedRedBlack<K,V>::min() {
+    return tree.min();
+}
+
+//Returns how many slots have been rewritten by growing the index or closing gaps after removes
+template <typename K, typename V>
+long long IndexedRedBlack<K,V>::numSlotMoves() {
+    return numMoved;
+}
+
+/* Function: put
+ * Description: Inserts the key and value, or replaces the value if the key is present. A present key is updated
+ *              through the index alone. Otherwise the index grows first if it would pass half full, so that once the
+ *              node has been put in the tree, recording it in the index cannot fail.
+ *
+ * Param: const K& newKey, const V& newValue
+*/
+template <typename K, typename V>
+void IndexedRedBlack<K,V>::put(const K& newKey, const V& newValue) {
+    uint64_t hash = hashKey(newKey);
+    size_t slot = findSlot(newKey, hash);
+
+    if (slots[slot].node != NULL) {
+        slots[slot].node->value = newValue;
+        return;
+    }
+
+    if (2 * (numIndexed + 1) > (int) slots.size()) {
+        growIndex();
+        slot = findSlot(newKey, hash);
+    }
+
+    slots[slot].node = tree.assignOrInsert(newKey, newValue);
+    slots[slot].hash = hash;
+    numIndexed++;
+}
+
+/* Function: rangeScan
+ * Description: Calls the callback with each key and value between lowKey and highKey (inclusive), in key order.
+ *
+ * Param: K lowKey, K highKey, Callback callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void IndexedRedBlack<K,V>::rangeScan(K lowKey, K highKey, Callback callback) {
+    tree.rangeScan(lowKey, highKey, callback);
+}
+
+//Removes the key from the index and then from the tree, which frees only that key's node
+template <typename K, typename V>
+void IndexedRedBlack<K,V>::remove(const K& searchKey) {
+    size_t slot = findSlot(searchKey, hashKey(searchKey));
+
+    if (slots[slot].node == NULL) {
+        return;
+    }
+
+    unlinkSlot(slot);
+    numIndexed--;
+    tree.remove(searchKey);
+}
+
+//Returns the number of keys in the map
+template <typename K, typename V>
+int IndexedRedBlack<K,V>::size() {
+    return numIndexed;
+}
+
+//COMPACT REDBLACK
+
+//Node of a CompactRedBlack. Children are 32-bit indices into the tree's node array, and the node's colour is kept in
+//the top bit of its left index, so a RedBlack<uint32_t,uint32_t> node of 32 bytes shrinks to 16.
+//Key and value come first, so small keys and values are packed with the indices rather than padded to a pointer.
+template <class K, class V>
+class CompactNode {
+
+    public:
+        K key;
+        V value;
+        uint32_t leftAndColour;
+        uint32_t right;
+};
+
+//RedBlack for small keys and values, storing its nodes in one array and linking them by 32-bit index instead of
+//by pointer. The tree holds at most 2^31 - 1 keys, and removed nodes are kept on a free list for reuse, linked
+//through their right index. Neighbouring nodes are put next to each other in the array, so more of the tree fits
+//in each cache line and page. Balancing is the same left-leaning scheme as RedBlack, without the size augmentation.
+template <typename K, typename V>
+class CompactRedBlack {
+    private:
+        static const uint32_t NIL = 0x7FFFFFFF;
+        static const uint32_t COLOUR_BIT = 0x80000000;
+
+        std::vector<CompactNode<K,V> > nodes;
+        uint32_t root = NIL;
+        uint32_t freeList = NIL;
+        int numKeys = 0;
+
+        uint32_t createNode(const K& newKey, const V& newValue);
+        uint32_t findNode(const K& searchKey);
+        uint32_t fixImbalances(uint32_t currNode);
+        uint32_t flipColours(uint32_t currNode);
+        void freeNode(uint32_t currNode);
+        uint32_t moveRedLeft(uint32_t currNode);
+        uint32_t moveRedRight(uint32_t currNode);
+        uint32_t put(uint32_t currNode, const K& newKey, const V& newValue);
+        template <typename Callback>
+        void rangeScan(uint32_t currNode, const K& lowKey, const K& highKey, Callback& callback);
+        uint32_t remove(uint32_t currNode, const K& searchKey);
+        uint32_t removeMin(uint32_t currNode, uint32_t& minNode);
+        uint32_t rotateLeft(uint32_t currNode);
+        uint32_t rotateRight(uint32_t currNode);
+        int validate(uint32_t currNode, const K* lowKey, const K* highKey);
+
+        bool isRed(uint32_t currNode) {
+            return currNode != NIL && (nodes[currNode].leftAndColour & COLOUR_BIT) != 0;
+        }
+
+        uint32_t leftOf(uint32_t currNode) {
+            return nodes[currNode].leftAndColour & ~COLOUR_BIT;
+        }
+
+        void setColour(uint32_t currNode, bool nodeColour) {
+            nodes[currNode].leftAndColour = leftOf(currNode) | (nodeColour == RED ? COLOUR_BIT : 0);
+        }
+
+        void setLeft(uint32_t currNode, uint32_t leftNode) {
+            nodes[currNode].leftAndColour = (nodes[currNode].leftAndColour & COLOUR_BIT) | leftNode;
+        }
+
+    public:
+        void clear();
+        bool contains(const K& searchKey);
+        V get(const K& searchKey);
+        V min();
+        V max();
+        size_t nodeBytes();
+        void put(const K& newKey, const V& newValue);
+        template <typename Callback>
+        void rangeScan(K lowKey, K highKey, Callback callback);
+        void remove(const K& searchKey);
+        void reserve(int numNodes);
+        int size();
+        bool validate();
+
+        CompactRedBlack() {}
+        CompactRedBlack(const CompactRedBlack&) = delete;
+        CompactRedBlack& operator=(const CompactRedBlack&) = delete;
+};
+
+//PRIVATE FUNCTIONS
+
+//Returns the index of a new red node, reusing a freed node if there is one
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::createNode(const K& newKey, const V& newValue) {
+    uint32_t newNode = freeList;
+
+    if (newNode != NIL) {
+        freeList = nodes[newNode].right;
+    }
+
+    else {
+        if (nodes.size() >= NIL) {
+            cout << "Err: CompactRedBlack is full.\n";
+            exit(1);
+        }
+
+        newNode = nodes.size();
+        nodes.emplace_back();
+    }
+
+    nodes[newNode].key = newKey;
+    nodes[newNode].value = newValue;
+    nodes[newNode].leftAndColour = NIL | COLOUR_BIT;
+    nodes[newNode].right = NIL;
+    return newNode;
+}
+
+//Returns the index of the node holding the key, or NIL
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::findNode(const K& searchKey) {
+    uint32_t iter = root;
+
+    while (iter != NIL) {
+        const CompactNode<K,V>& iterNode = nodes[iter];
+
+        if (searchKey < iterNode.key) {
+            iter = iterNode.leftAndColour & ~COLOUR_BIT;
+        }
+
+        else if (iterNode.key < searchKey) {
+            iter = iterNode.right;
+        }
+
+        else {
+            return iter;
+        }
+    }
+
+    return NIL;
+}
+
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::fixImbalances(uint32_t currNode) {
+
+    if (isRed(nodes[currNode].right)) {
+        currNode = rotateLeft(currNode);
+    }
+
+    if (isRed(leftOf(currNode)) && isRed(leftOf(leftOf(currNode)))) {
+        currNode = rotateRight(currNode);
+    }
+
+    if (isRed(leftOf(currNode)) && isRed(nodes[currNode].right)) {
+        currNode = flipColours(currNode);
+    }
+
+    return currNode;
+}
+
+//Flips the colour of the node and its two children
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::flipColours(uint32_t currNode) {
+    nodes[currNode].leftAndColour ^= COLOUR_BIT;
+    nodes[leftOf(currNode)].leftAndColour ^= COLOUR_BIT;
+    nodes[nodes[currNode].right].leftAndColour ^= COLOUR_BIT;
+    return currNode;
+}
+
+//Puts a removed node on the free list, resetting its key and value so they hold nothing
+template <typename K, typename V>
+void CompactRedBlack<K,V>::freeNode(uint32_t currNode) {
+    nodes[currNode].key = K();
+    nodes[currNode].value = V();
+    nodes[currNode].right = freeList;
+    freeList = currNode;
+}
+
+//Borrows a red link from the right sibling so the left child or grandchild is red
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::moveRedLeft(uint32_t currNode) {
+    currNode = flipColours(currNode);
+
+    if (isRed(leftOf(nodes[currNode].right))) {
+        uint32_t rightNode = rotateRight(nodes[currNode].right);
+        nodes[currNode].right = rightNode;
+        currNode = rotateLeft(currNode);
+        currNode = flipColours(currNode);
+    }
+
+    return currNode;
+}
+
+//Borrows a red link from the left sibling so the right child or grandchild is red
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::moveRedRight(uint32_t currNode) {
+    currNode = flipColours(currNode);
+
+    if (isRed(leftOf(leftOf(currNode)))) {
+        currNode = rotateRight(currNode);
+        currNode = flipColours(currNode);
+    }
+
+    return currNode;
+}
+
+/* Function: put
+ * Description: Inserts the key or replaces its value, fixing imbalances on the way back up. The node array may grow
+ *              while a new node is created, so nodes are only ever reached through their index across the recursion.
+ *
+ * Param: uint32_t currNode, const K& newKey, const V& newValue
+*/
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::put(uint32_t currNode, const K& newKey, const V& newValue) {
+
+    if (currNode == NIL) {
+        numKeys++;
+        return createNode(newKey, newValue);
+    }
+
+    if (newKey < nodes[currNode].key) {
+        uint32_t leftNode = put(leftOf(currNode), newKey, newValue);
+        setLeft(currNode, leftNode);
+    }
+
+    else if (nodes[currNode].key < newKey) {
+        uint32_t rightNode = put(nodes[currNode].right, newKey, newValue);
+        nodes[currNode].right = rightNode;
+    }
+
+    else {
+        nodes[currNode].value = newValue;
+    }
+
+    return fixImbalances(currNode);
+}
+
+/* Function: rangeScan
+ * Description: Calls the callback on each node of the subtree with a key between lowKey and highKey, in order.
+ *
+ * Param: uint32_t currNode, const K& lowKey, const K& highKey, Callback& callback
+*/
+template <typename K, typename V>
+template <typename Callback>
+void CompactRedBlack<K,V>::rangeScan(uint32_t currNode, const K& lowKey, const K& highKey, Callback& callback) {
+
+    if (currNode == NIL) {
+        return;
+    }
+
+    if (lowKey < nodes[currNode].key) {
+        rangeScan(leftOf(currNode), lowKey, highKey, callback);
+    }
+
+    if (!(nodes[currNode].key < lowKey) && !(highKey < nodes[currNode].key)) {
+        callback(nodes[currNode].key, nodes[currNode].value);
+    }
+
+    if (nodes[currNode].key < highKey) {
+        rangeScan(nodes[currNode].right, lowKey, highKey, callback);
+    }
+}
+
+/* Function: remove
+ * Description: Removes the key, which must be in the subtree, in the same way as RedBlack's remove: the in-order
+ *              successor of a node with a right subtree is unlinked and relinked into its place.
+ *
+ * Param: uint32_t currNode, const K& searchKey
+*/
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::remove(uint32_t currNode, const K& searchKey) {
+
+    if (searchKey < nodes[currNode].key) {
+        if (!isRed(leftOf(currNode)) && !isRed(leftOf(leftOf(currNode)))) {
+            currNode = moveRedLeft(currNode);
+        }
+
+        uint32_t leftNode = remove(leftOf(currNode), searchKey);
+        setLeft(currNode, leftNode);
+    }
+
+    else {
+
+        //Temporarily make left-leaning red links lean right
+        if (isRed(leftOf(currNode))) {
+            currNode = rotateRight(currNode);
+        }
+
+        //Node was found at the bottom of the tree, delete it
+        if (!(nodes[currNode].key < searchKey) && nodes[currNode].right == NIL) {
+            freeNode(currNode);
+            return NIL;
+        }
+
+        if (!isRed(nodes[currNode].right) && !isRed(leftOf(nodes[currNode].right))) {
+            currNode = moveRedRight(currNode);
+        }
+
+        if (!(nodes[currNode].key < searchKey)) {
+            uint32_t successorNode = NIL;
+
+            //Unlink the successor and move it into the removed node's place
+            uint32_t rightNode = removeMin(nodes[currNode].right, successorNode);
+            nodes[successorNode].leftAndColour = nodes[currNode].leftAndColour;
+            nodes[successorNode].right = rightNode;
+
+            freeNode(currNode);
+            currNode = successorNode;
+        }
+
+        else {
+            uint32_t rightNode = remove(nodes[currNode].right, searchKey);
+            nodes[currNode].right = rightNode;
+        }
+    }
+
+    return fixImbalances(currNode);
+}
+
+//Unlinks the minimum node of the subtree and hands it back through minNode
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::removeMin(uint32_t currNode, uint32_t& minNode) {
+
+    if (leftOf(currNode) == NIL) {
+        minNode = currNode;
+        return NIL;
+    }
+
+    if (!isRed(leftOf(currNode)) && !isRed(leftOf(leftOf(currNode)))) {
+        currNode = moveRedLeft(currNode);
+    }
+
+    uint32_t leftNode = removeMin(leftOf(currNode), minNode);
+    setLeft(currNode, leftNode);
+
+    return fixImbalances(currNode);
+}
+
+//Performs a left rotation on the node to fix a right-leaning red link
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::rotateLeft(uint32_t currNode) {
+    uint32_t tempNode = nodes[currNode].right;
+    bool nodeColour = isRed(currNode);
+
+    nodes[currNode].right = leftOf(tempNode);
+    nodes[tempNode].leftAndColour = currNode | (nodeColour ? COLOUR_BIT : 0);
+    setColour(currNode, RED);
+
+    return tempNode;
+}
+
+//Makes a left-leaning red link temporarily lean right
+template <typename K, typename V>
+uint32_t CompactRedBlack<K,V>::rotateRight(uint32_t currNode) {
+    uint32_t tempNode = leftOf(currNode);
+
+    setLeft(currNode, nodes[tempNode].right);
+    nodes[tempNode].right = currNode;
+    setColour(tempNode, isRed(currNode));
+    setColour(currNode, RED);
+
+    return tempNode;
+}
+
+/* Function: validate
+ * Description: Checks the subtree for keys out of order, red links leaning right, two red links in a row and uneven
+ *              black heights. Prints the first broken invariant found and returns -1, or returns the black height.
+ *
+ * Param: uint32_t currNode, const K* lowKey, const K* highKey
+*/
+template <typename K, typename V>
+int CompactRedBlack<K,V>::validate(uint32_t currNode, const K* lowKey, const K* highKey) {
+
+    if (currNode == NIL) {
+        return 0;
+    }
+
+    const K& nodeKey = nodes[currNode].key;
+
+    if ((lowKey != NULL && !(*lowKey < nodeKey)) || (highKey != NULL && !(nodeKey < *highKey))) {
+        cout << "Error: Keys are out of order." << endl;
+        return -1;
+    }
+
+    if (isRed(nodes[currNode].right)) {
+        cout << "Error: Red link leans right." << endl;
+        return -1;
+    }
+
+    if (isRed(currNode) && isRed(leftOf(currNode))) {
+        cout << "Error: Two red links in a row." << endl;
+        return -1;
+    }
+
+    int leftHeight = validate(leftOf(currNode), lowKey, &nodeKey);
+    int rightHeight = leftHeight < 0 ? -1 : validate(nodes[currNode].right, &nodeKey, highKey);
+
+    if (rightHeight < 0) {
+        return -1;
+    }
+
+    if (leftHeight != rightHeight) {
+        cout << "Error: Black heights differ." << endl;
+        return -1;
+    }
+
+    return leftHeight + (isRed(currNode) ? 0 : 1);
+}
+
+//PUBLIC FUNCTIONS
+
+//Removes every key, releasing the node array
+template <typename K, typename V>
+void CompactRedBlack<K,V>::clear() {
+    std::vector<CompactNode<K,V> >().swap(nodes);
+    root = NIL;
+    freeList = NIL;
+    numKeys = 0;
+}
+
+//Returns whether or not the key appears in the tree
+template <typename K, typename V>
+bool CompactRedBlack<K,V>::contains(const K& searchKey) {
+    return findNode(searchKey) != NIL;
+}
+
+//Returns the value associated with the key, or V() if it is not in the tree
+template <typename K, typename V>
+V CompactRedBlack<K,V>::get(const K& searchKey) {
+    uint32_t foundNode = findNode(searchKey);
+
+    return foundNode != NIL ? nodes[foundNode].value : V();
+}
+
+//Returns the value of the maximum key in the tree
+template <typename K, typename V>
+V CompactRedBlack<K,V>::max() {
+    uint32_t iter = root;
+
+    if (iter == NIL) {
+        return V();
+    }
+
+    while (nodes[iter].right != NIL) {
+        iter = nodes[iter].right;
+    }
+
+    return nodes[iter].value;
+}
+
+//Returns the value of the minimum key in the tree
+template <typename K, typename V>
+V CompactRedBlack<K,V>::min() {
+    uint32_t iter = root;
+
+    if (iter == NIL) {
+        return V();
+    }
+
+    while (leftOf(iter) != NIL) {
+        iter = leftOf(iter);
+    }
+
+    return nodes[iter].value;
+}
+
+//Returns the bytes held by the node array, including free and reserved nodes
+template <typename K, typename V>
+size_t CompactRedBlack<K,V>::nodeBytes() {
+    return nodes.capacity() * sizeof(CompactNode<K,V>);
+}
+
+//Public put function
+template <typename K, typename V>
+void CompactRedBlack<K,V>::put(const K& newKey, const V& newValue) {
+    root = put(root, newKey, newValue);
+    setColour(root, BLACK);
+}
+
+//Public rangeScan, calls callback(key, value) on every key from lowKey to highKey (inclusive)
+template <typename K, typename V>
+template <typename Callback>
+void CompactRedBlack<K,V>::rangeScan(K lowKey, K highKey, Callback callback) {
+    rangeScan(root, lowKey, highKey, callback);
+}
+
+//Removes the key from the tree if it is present
+template <typename K, typename V>
+void CompactRedBlack<K,V>::remove(const K& searchKey) {
+
+    if (findNode(searchKey) == NIL) {
+        return;
+    }
+
+    root = remove(root, searchKey);
+    numKeys--;
+
+    if (root != NIL) {
+        setColour(root, BLACK);
+    }
+}
+
+//Reserves room for the passed number of nodes, so that building a tree of known size never copies the array
+template <typename K, typename V>
+void CompactRedBlack<K,V>::reserve(int numNodes) {
+    nodes.reserve(numNodes);
+}
+
+//Return number of keys in the tree
+template <typename K, typename V>
+int CompactRedBlack<K,V>::size() {
+    return numKeys;
+}
+
+//Checks every red-black invariant, printing the first broken one and returning false. Takes O(n) time.
+template <typename K, typename V>
+bool CompactRedBlack<K,V>::validate() {
+
+    if (isRed(root)) {
+        cout << "Error: Root is red." << endl;
+        return false;
+    }
+
+    return validate(root, NULL, NULL) >= 0;
+}
+
+#endif
@@ -0,0 +1,434 @@
+/* DESCRIPTION OF FILE
+
+    Compact binary snapshot format shared by the RedBlack and BST trees, for trivially copyable keys and values.
+
+    A snapshot is a 64-byte header followed by every key in sorted order, zero padding up to a multiple of 64 bytes,
+    then every value in the same order, so both arrays are aligned when mapped. There are no pointers, so a snapshot can be mapped straight back into memory. MappedSnapshot maps a file,
+    checks its header and checksum, and either serves lookups straight from the mapped keys (binary search)
+    or hands the sorted pairs to a tree's O(n) bulk build.
+*/
+
+#ifndef TREE_SNAPSHOT_H
+#define TREE_SNAPSHOT_H
+
+#include <algorithm>
+#include <fcntl.h>
+#include <iostream>
+#include <iterator>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+const char SNAPSHOT_MAGIC[8] = {'T', 'R', 'E', 'E', 'S', 'N', 'A', 'P'};
+const uint32_t SNAPSHOT_FORMAT_VERSION = 2;
+
+//Snapshot file header, padded to a cache line so the key array that follows is aligned
+struct alignas(64) SnapshotHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t keySize;
+    uint32_t valueSize;
+    uint32_t reserved;
+    uint64_t numEntries;
+    uint64_t checksum;
+};
+
+//Returns the bytes taken by the keys of a snapshot, padded so that the values that follow are 64-byte aligned
+inline uint64_t snapshotKeyBytes(uint64_t numEntries, size_t keySize) {
+    return (numEntries * keySize + 63) / 64 * 64;
+}
+
+//Running 64-bit FNV-1a style checksum over the snapshot payload. Bytes are folded in eight at a time so that
+//checking a multi-gigabyte snapshot is not limited by a byte-at-a-time loop; the result does not depend on how
+//the payload is split between calls to update.
+class SnapshotChecksum {
+
+    private:
+        static const uint64_t PRIME = 1099511628211ULL;
+
+        uint64_t hash;
+        unsigned char tail[8];
+        size_t tailBytes;
+
+    public:
+        /* Function: update
+         * Description: Folds the bytes into the checksum, holding back any partial eight-byte word for the next call.
+         *
+         * Param: const void* data, size_t numBytes
+        */
+        void update(const void* data, size_t numBytes) {
+            const unsigned char* bytes = (const unsigned char*) data;
+            size_t index = 0;
+
+            while (tailBytes > 0 && tailBytes < 8 && index < numBytes) {
+                tail[tailBytes++] = bytes[index++];
+
+                if (tailBytes == 8) {
+                    uint64_t word;
+                    memcpy(&word, tail, 8);
+                    hash = (hash ^ word) * PRIME;
+                    tailBytes = 0;
+                }
+            }
+
+            for (; index + 8 <= numBytes; index += 8) {
+                uint64_t word;
+                memcpy(&word, bytes + index, 8);
+                hash = (hash ^ word) * PRIME;
+            }
+
+            for (; index < numBytes; index++) {
+                tail[tailBytes++] = bytes[index];
+            }
+        }
+
+        //Returns the checksum of every byte passed so far, folding in the last partial word one byte at a time
+        uint64_t value() {
+            uint64_t result = hash;
+
+            for (size_t index = 0; index < tailBytes; index++) {
+                result = (result ^ tail[index]) * PRIME;
+            }
+
+            return result;
+        }
+
+        SnapshotChecksum() {
+            hash = 14695981039346656037ULL;
+            tailBytes = 0;
+        }
+};
+
+//Buffered snapshot writer, every byte written is also folded into the checksum
+class SnapshotWriter {
+
+    private:
+        static const size_t BUFFER_SIZE = 1 << 16;
+
+        FILE* snapshotFile;
+        std::vector<char> buffer;
+        size_t bufferUsed;
+        bool failed;
+
+    public:
+        SnapshotChecksum checksum;
+
+        //Writes out and checksums the buffered bytes
+        void flush() {
+            checksum.update(buffer.data(), bufferUsed);
+            failed = failed || fwrite(buffer.data(), 1, bufferUsed, snapshotFile) != bufferUsed;
+            bufferUsed = 0;
+        }
+
+        void write(const void* data, size_t numBytes) {
+            if (bufferUsed + numBytes > BUFFER_SIZE) {
+                flush();
+            }
+
+            if (numBytes > BUFFER_SIZE) {
+                checksum.update(data, numBytes);
+                failed = failed || fwrite(data, 1, numBytes, snapshotFile) != numBytes;
+                return;
+            }
+
+            memcpy(buffer.data() + bufferUsed, data, numBytes);
+            bufferUsed += numBytes;
+        }
+
+        bool hasFailed() {
+            return failed;
+        }
+
+        SnapshotWriter(FILE* snapshotFile) : buffer(BUFFER_SIZE) {
+            this->snapshotFile = snapshotFile;
+            bufferUsed = 0;
+            failed = false;
+        }
+};
+
+/* Function: writeSnapshot
+ * Description: Writes a snapshot of numEntries pairs to the path. forEachPair(callback) must call the callback
+ *              with every key and value in increasing key order; it is called twice, once for the keys and
+ *              once for the values. Returns false if the file could not be written.
+ *
+ * Param: const char* path, uint64_t numEntries, ForEachPair forEachPair
+*/
+template <class K, class V, typename ForEachPair>
+bool writeSnapshot(const char* path, uint64_t numEntries, ForEachPair forEachPair) {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "Snapshots need trivially copyable keys and values");
+    static_assert(alignof(K) <= 64 && alignof(V) <= 64, "Snapshot arrays are only aligned to 64 bytes");
+
+    const char padding = 0;
+    FILE* snapshotFile = fopen(path, "wb");
+
+    if (snapshotFile == NULL) {
+        std::cout << "Error: Could not open snapshot file " << path << " for writing.\n";
+        return false;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.formatVersion = SNAPSHOT_FORMAT_VERSION;
+    header.keySize = sizeof(K);
+    header.valueSize = sizeof(V);
+    header.numEntries = numEntries;
+
+    bool written = fwrite(&header, sizeof(header), 1, snapshotFile) == 1;
+    SnapshotWriter writer(snapshotFile);
+
+    forEachPair([&](const K& key, const V& value) {
+        writer.write(&key, sizeof(K));
+    });
+
+    for (uint64_t offset = numEntries * sizeof(K); offset < snapshotKeyBytes(numEntries, sizeof(K)); offset++) {
+        writer.write(&padding, 1);
+    }
+
+    forEachPair([&](const K& key, const V& value) {
+        writer.write(&value, sizeof(V));
+    });
+
+    writer.flush();
+    header.checksum = writer.checksum.value();
+
+    //Rewrite the header now that the checksum is known
+    written = written && !writer.hasFailed() && fseek(snapshotFile, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, snapshotFile) == 1;
+    written = fclose(snapshotFile) == 0 && written;
+
+    if (!written) {
+        std::cout << "Error: Could not write snapshot file " << path << ".\n";
+    }
+
+    return written;
+}
+
+//Forward iterator over the (key, value) pairs of a mapped snapshot, in key order
+template <class K, class V>
+class MappedPairIterator {
+
+    private:
+        const K* keys;
+        const V* values;
+        std::pair<K,V> currPair;
+        int64_t index;
+        int64_t numEntries;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<K,V> value_type;
+        typedef int64_t difference_type;
+        typedef const std::pair<K,V>* pointer;
+        typedef const std::pair<K,V>& reference;
+
+        reference operator*() {
+            return currPair;
+        }
+
+        pointer operator->() {
+            return &currPair;
+        }
+
+        MappedPairIterator& operator++() {
+            index++;
+
+            if (index < numEntries) {
+                currPair = std::make_pair(keys[index], values[index]);
+            }
+
+            return *this;
+        }
+
+        bool operator==(const MappedPairIterator& other) const {
+            return index == other.index;
+        }
+
+        bool operator!=(const MappedPairIterator& other) const {
+            return index != other.index;
+        }
+
+        MappedPairIterator(const K* keys, const V* values, int64_t index, int64_t numEntries) {
+            this->keys = keys;
+            this->values = values;
+            this->index = index;
+            this->numEntries = numEntries;
+
+            if (index < numEntries) {
+                currPair = std::make_pair(keys[index], values[index]);
+            }
+        }
+};
+
+//Read-only memory-mapped snapshot. Lookups binary search the mapped keys without building a tree.
+template <class K, class V>
+class MappedSnapshot {
+
+    private:
+        void* mapping;
+        size_t mappingSize;
+        const K* keys;
+        const V* values;
+        int64_t numEntries;
+
+        bool open(const char* path);
+
+    public:
+        typedef MappedPairIterator<K,V> iterator;
+
+        iterator begin();
+        bool contains(K searchKey);
+        iterator end();
+        V get(K searchKey);
+        bool isValid();
+        V min();
+        V max();
+        int64_t size();
+
+        MappedSnapshot(const char* path) {
+            static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                          "Snapshots need trivially copyable keys and values");
+
+            mapping = MAP_FAILED;
+            mappingSize = 0;
+            keys = NULL;
+            values = NULL;
+            numEntries = 0;
+
+            if (!open(path) && mapping != MAP_FAILED) {
+                munmap(mapping, mappingSize);
+                mapping = MAP_FAILED;
+            }
+        }
+
+        MappedSnapshot(const MappedSnapshot&) = delete;
+        MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+        ~MappedSnapshot() {
+            if (mapping != MAP_FAILED) {
+                munmap(mapping, mappingSize);
+            }
+        }
+};
+
+/* Function: open
+ * Description: Maps the file read-only and checks the header, the key and value sizes, the file length and the checksum.
+ *              Returns false (after printing the reason) if any of them do not match.
+ *
+ * Param: const char* path
+*/
+template <class K, class V>
+bool MappedSnapshot<K,V>::open(const char* path) {
+    int fileDescriptor = ::open(path, O_RDONLY);
+    struct stat fileStats;
+
+    if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStats) != 0 || fileStats.st_size < (off_t) sizeof(SnapshotHeader)) {
+        std::cout << "Error: Could not open snapshot file " << path << ".\n";
+
+        if (fileDescriptor >= 0) {
+            close(fileDescriptor);
+        }
+        return false;
+    }
+
+    mappingSize = fileStats.st_size;
+    mapping = mmap(NULL, mappingSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+
+    if (mapping == MAP_FAILED) {
+        std::cout << "Error: Could not map snapshot file " << path << ".\n";
+        return false;
+    }
+
+    madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+
+    const SnapshotHeader* header = (const SnapshotHeader*) mapping;
+
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header->formatVersion != SNAPSHOT_FORMAT_VERSION ||
+        header->keySize != sizeof(K) || header->valueSize != sizeof(V) || header->numEntries > mappingSize ||
+        mappingSize != sizeof(SnapshotHeader) + snapshotKeyBytes(header->numEntries, sizeof(K)) + header->numEntries * sizeof(V)) {
+        std::cout << "Error: " << path << " is not a snapshot of this key and value type.\n";
+        return false;
+    }
+
+    const char* payload = (const char*) mapping + sizeof(SnapshotHeader);
+
+    SnapshotChecksum checksum;
+    checksum.update(payload, mappingSize - sizeof(SnapshotHeader));
+
+    if (checksum.value() != header->checksum) {
+        std::cout << "Error: Snapshot file " << path << " is corrupt (checksum mismatch).\n";
+        return false;
+    }
+
+    numEntries = header->numEntries;
+    keys = (const K*) payload;
+    values = (const V*) (payload + snapshotKeyBytes(numEntries, sizeof(K)));
+
+    //Lookups are random from here on
+    madvise(mapping, mappingSize, MADV_RANDOM);
+    return true;
+}
+
+//Returns an iterator to the first (smallest) pair
+template <class K, class V>
+MappedPairIterator<K,V> MappedSnapshot<K,V>::begin() {
+    return iterator(keys, values, 0, numEntries);
+}
+
+//Returns whether or not the key appears in the snapshot
+template <class K, class V>
+bool MappedSnapshot<K,V>::contains(K searchKey) {
+    const K* found = std::lower_bound(keys, keys + numEntries, searchKey);
+    return found != keys + numEntries && *found == searchKey;
+}
+
+//Returns the iterator past the last pair
+template <class K, class V>
+MappedPairIterator<K,V> MappedSnapshot<K,V>::end() {
+    return iterator(keys, values, numEntries, numEntries);
+}
+
+//Returns the value associated with the key, or V() if it is not in the snapshot
+template <class K, class V>
+V MappedSnapshot<K,V>::get(K searchKey) {
+    const K* found = std::lower_bound(keys, keys + numEntries, searchKey);
+
+    if (found != keys + numEntries && *found == searchKey) {
+        return values[found - keys];
+    }
+
+    return V();
+}
+
+//Returns whether the file was mapped and passed every check
+template <class K, class V>
+bool MappedSnapshot<K,V>::isValid() {
+    return mapping != MAP_FAILED;
+}
+
+//Returns the value of the maximum key, or V() if the snapshot is empty
+template <class K, class V>
+V MappedSnapshot<K,V>::max() {
+    return numEntries > 0 ? values[numEntries - 1] : V();
+}
+
+//Returns the value of the minimum key, or V() if the snapshot is empty
+template <class K, class V>
+V MappedSnapshot<K,V>::min() {
+    return numEntries > 0 ? values[0] : V();
+}
+
+//Return number of pairs in the snapshot
+template <class K, class V>
+int64_t MappedSnapshot<K,V>::size() {
+    return numEntries;
+}
+
+#endif
@@ -0,0 +1,222 @@
+/* DESCRIPTION OF FILE
+
+    Optional instrumentation shared by the RedBlack and BST trees, to see where a slow workload spends its time.
+
+    Compile with -DTREE_STATS to have each tree count its key comparisons, rotations, colour flips, node allocations
+    and frees, and to record the depth reached and the latency of every get, put, remove and range scan in a
+    per-operation power-of-two histogram. Without TREE_STATS every TREE_STAT(...) statement is removed by the
+    preprocessor, so the trees carry no stats member and do no extra work.
+*/
+
+#ifndef TREE_STATS_H
+#define TREE_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#if defined(TREE_STATS)
+#define TREE_STAT(...) __VA_ARGS__
+#else
+#define TREE_STAT(...)
+#endif
+
+//Operations given their own depth and latency figures
+enum TreeOp { TREE_GET, TREE_PUT, TREE_REMOVE, TREE_SCAN, NUM_TREE_OPS };
+
+const char* const TREE_OP_NAMES[NUM_TREE_OPS] = {"get", "put", "remove", "scan"};
+
+//Counter that may be bumped by several threads at once (shared-lock readers, set operations on the ForkJoinPool).
+//Relaxed increments are enough, since the counts are only read once the work being measured has finished.
+class StatCounter {
+
+    private:
+        std::atomic<uint64_t> count{0};
+
+    public:
+        void operator++(int) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void operator+=(uint64_t amount) {
+            count.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        //Raises the count to the passed value if it is larger, for tracking maximums
+        void raiseTo(uint64_t amount) {
+            uint64_t current = count.load(std::memory_order_relaxed);
+
+            while (current < amount && !count.compare_exchange_weak(current, amount, std::memory_order_relaxed)) {}
+        }
+
+        void reset() {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        uint64_t value() const {
+            return count.load(std::memory_order_relaxed);
+        }
+};
+
+//Latency histogram with power-of-two nanosecond buckets, bucket i holding latencies in [2^(i-1), 2^i)
+class LatencyHistogram {
+
+    private:
+        static const int NUM_BUCKETS = 40;
+
+        StatCounter buckets[NUM_BUCKETS];
+
+    public:
+        //Returns the number of recorded latencies
+        uint64_t count() const {
+            uint64_t numRecorded = 0;
+
+            for (int i = 0; i < NUM_BUCKETS; i++) {
+                numRecorded += buckets[i].value();
+            }
+
+            return numRecorded;
+        }
+
+        /* Function: percentile
+         * Description: Returns the upper bound in nanoseconds of the bucket holding the given percentile (0 - 100),
+         *              so the true latency is at most this and more than half of it. Returns 0 if nothing was recorded.
+         *
+         * Param: double percent
+        */
+        uint64_t percentile(double percent) const {
+            uint64_t numRecorded = count();
+            uint64_t numSeen = 0;
+
+            if (numRecorded == 0) {
+                return 0;
+            }
+
+            for (int i = 0; i < NUM_BUCKETS; i++) {
+                numSeen += buckets[i].value();
+
+                if (numSeen * 100.0 >= percent * numRecorded) {
+                    return (uint64_t) 1 << i;
+                }
+            }
+
+            return (uint64_t) 1 << (NUM_BUCKETS - 1);
+        }
+
+        //Records a latency in its bucket, latencies past the last bucket are counted in it
+        void record(uint64_t nanos) {
+            int bucket = 0;
+
+            while (nanos > 0 && bucket < NUM_BUCKETS - 1) {
+                nanos >>= 1;
+                bucket++;
+            }
+
+            buckets[bucket]++;
+        }
+
+        void reset() {
+            for (int i = 0; i < NUM_BUCKETS; i++) {
+                buckets[i].reset();
+            }
+        }
+};
+
+//Depth and latency figures for one type of operation
+struct OpStats {
+    StatCounter calls;
+    StatCounter totalDepth;
+    StatCounter maxDepth;
+    LatencyHistogram latency;
+};
+
+//Counters for one tree. Comparisons are the key comparisons (<, > or ==) made by get, contains, put and remove,
+//and an operation's depth is the number of nodes it visits (every node in range, for a scan).
+struct TreeStats {
+    StatCounter comparisons;
+    StatCounter rotations;
+    StatCounter colourFlips;
+    StatCounter allocations;
+    StatCounter frees;
+    OpStats ops[NUM_TREE_OPS];
+
+    void reset() {
+        comparisons.reset();
+        rotations.reset();
+        colourFlips.reset();
+        allocations.reset();
+        frees.reset();
+
+        for (int i = 0; i < NUM_TREE_OPS; i++) {
+            ops[i].calls.reset();
+            ops[i].totalDepth.reset();
+            ops[i].maxDepth.reset();
+            ops[i].latency.reset();
+        }
+    }
+
+    void print() const {
+        std::cout << "Comparisons: " << comparisons.value() << " Rotations: " << rotations.value()
+            << " Colour flips: " << colourFlips.value() << " Allocations: " << allocations.value()
+            << " Frees: " << frees.value() << std::endl;
+
+        for (int i = 0; i < NUM_TREE_OPS; i++) {
+            uint64_t numCalls = ops[i].calls.value();
+
+            if (numCalls == 0) {
+                continue;
+            }
+
+            std::cout << TREE_OP_NAMES[i] << ": " << numCalls << " calls, mean depth "
+                << (double) ops[i].totalDepth.value() / numCalls << ", max depth " << ops[i].maxDepth.value()
+                << ", p50 <= " << ops[i].latency.percentile(50) << "ns, p99 <= " << ops[i].latency.percentile(99)
+                << "ns, p99.9 <= " << ops[i].latency.percentile(99.9) << "ns" << std::endl;
+        }
+    }
+};
+
+//Depth of the operation running on this thread, kept per thread so concurrent readers of one tree do not mix
+inline thread_local int treeOpDepth = 0;
+
+//Stats of the tree whose operation is running on this thread, for work done outside the tree's own members
+//(the BST's free rotation functions)
+inline thread_local TreeStats* activeTreeStats = NULL;
+
+//Times one operation from construction to destruction and records its latency and depth.
+//Only ever declared inside TREE_STAT, so nothing is timed when stats are compiled out.
+class OpTimer {
+
+    private:
+        TreeStats& stats;
+        TreeOp op;
+        TreeStats* outerStats;
+        int outerDepth;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        OpTimer(TreeStats& stats, TreeOp op) : stats(stats), op(op) {
+            outerStats = activeTreeStats;
+            outerDepth = treeOpDepth;
+            activeTreeStats = &stats;
+            treeOpDepth = 0;
+            start = std::chrono::steady_clock::now();
+        }
+
+        OpTimer(const OpTimer&) = delete;
+        OpTimer& operator=(const OpTimer&) = delete;
+
+        ~OpTimer() {
+            std::chrono::nanoseconds elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            stats.ops[op].calls++;
+            stats.ops[op].totalDepth += treeOpDepth;
+            stats.ops[op].maxDepth.raiseTo(treeOpDepth);
+            stats.ops[op].latency.record(elapsed.count());
+
+            activeTreeStats = outerStats;
+            treeOpDepth = outerDepth;
+        }
+};
+
+#endif
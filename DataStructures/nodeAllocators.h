@@ -0,0 +1,318 @@
+/* DESCRIPTION OF FILE
+
+    Node allocators shared by the RedBlack and BST trees, the PriorityQ heap and the linked-list Stack and Queue,
+    passed to each as its Allocator parameter. HeapAllocator news and deletes every node, NodeArena carves nodes out
+    of large chunks and frees them all at once, and PmrAllocator takes every node from a std::pmr::memory_resource.
+
+    A container given PmrAllocator is built with the resource to use, e.g. RedBlack<int,int,PmrAllocator>
+    tree(&resource). Passing a TrackingResource reports that container's live bytes, peak bytes and allocation
+    count, and passing a std::pmr::monotonic_buffer_resource lets a group of short-lived containers be released in
+    one shot (destroy the containers, then release the buffer).
+*/
+
+#ifndef NODE_ALLOCATORS_H
+#define NODE_ALLOCATORS_H
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+//Heap allocator, every node is allocated and freed individually with new and delete
+template <class T>
+class HeapAllocator {
+
+    public:
+        static const bool RELEASES_ALL = false;
+
+        //Nodes are not tied to an allocator, so there is nothing to take over
+        void adopt(HeapAllocator& other) {}
+
+        template <class... Args>
+        T* create(Args&&... args) {
+            return new T(std::forward<Args>(args)...);
+        }
+
+        void destroy(T* node) {
+            delete node;
+        }
+
+        void releaseAll() {}
+
+        //Resource for the arrays a container keeps beside its nodes, the same heap the nodes come from
+        std::pmr::memory_resource* resource() {
+            return std::pmr::new_delete_resource();
+        }
+
+        //Every node can be deleted by any HeapAllocator, so nodes may move freely between containers
+        bool shares(HeapAllocator& other) {
+            return true;
+        }
+
+        void swap(HeapAllocator& other) {}
+};
+
+//Node arena, nodes are carved out of large chunks in allocation order and freed nodes are recycled
+//through a free list. releaseAll frees every chunk at once, without visiting the nodes.
+template <class T>
+class NodeArena {
+
+    private:
+        //A free slot holds the link to the next free slot in place of the node
+        union Slot {
+            Slot* nextFree;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        static const int FIRST_CHUNK_SIZE = 64;
+        static const int MAX_CHUNK_SIZE = 65536;
+
+        std::vector<Slot*> chunks;
+        Slot* freeList;
+        int chunkUsed;
+        int chunkSize;
+
+    public:
+        static const bool RELEASES_ALL = true;
+
+        /* Function: adopt
+         * Description: Takes ownership of every chunk of the other arena, leaving it empty, so nodes created there
+         *              can be linked into this arena's tree. The other arena's free slots are spliced onto this free list.
+        */ 
+        void adopt(NodeArena& other) {
+            if (chunks.empty()) {
+                swap(other);
+                return;
+            }
+
+            //The adopted chunks go in front so that chunks.back() stays the chunk being carved
+            chunks.insert(chunks.begin(), other.chunks.begin(), other.chunks.end());
+
+            while (other.freeList != NULL) {
+                Slot* slot = other.freeList;
+                other.freeList = slot->nextFree;
+                slot->nextFree = freeList;
+                freeList = slot;
+            }
+
+            other.chunks.clear();
+            other.chunkUsed = 0;
+            other.chunkSize = 0;
+        }
+
+        /* Function: create
+         * Description: Constructs a node in a recycled slot if one is free, otherwise in the next slot of the
+         *              current chunk. Chunks double in size up to MAX_CHUNK_SIZE nodes.
+        */ 
+        template <class... Args>
+        T* create(Args&&... args) {
+            Slot* slot = freeList;
+
+            if (slot != NULL) {
+                freeList = slot->nextFree;
+            }
+
+            else {
+                if (chunks.empty() || chunkUsed == chunkSize) {
+                    chunkSize = chunks.empty() ? FIRST_CHUNK_SIZE : chunkSize * 2;
+
+                    if (chunkSize > MAX_CHUNK_SIZE) {
+                        chunkSize = MAX_CHUNK_SIZE;
+                    }
+                    chunks.push_back(new Slot[chunkSize]);
+                    chunkUsed = 0;
+                }
+
+                slot = &chunks.back()[chunkUsed++];
+            }
+
+            return new (slot->storage) T(std::forward<Args>(args)...);
+        }
+
+        /* Function: destroy
+         * Description: Destroys the node and pushes its slot onto the free list.
+        */ 
+        void destroy(T* node) {
+            node->~T();
+            Slot* slot = reinterpret_cast<Slot*>(node);
+            slot->nextFree = freeList;
+            freeList = slot;
+        }
+
+        /* Function: releaseAll
+         * Description: Frees every chunk. Any nodes still in the arena must already be destroyed,
+         *              or have trivial destructors.
+        */ 
+        void releaseAll() {
+            for (Slot* chunk : chunks) {
+                delete[] chunk;
+            }
+
+            chunks.clear();
+            freeList = NULL;
+            chunkUsed = 0;
+            chunkSize = 0;
+        }
+
+        //Resource for the arrays a container keeps beside its nodes, the heap the chunks come from
+        std::pmr::memory_resource* resource() {
+            return std::pmr::new_delete_resource();
+        }
+
+        //Nodes belong to the arena they were carved from, so they cannot move to another container without adopt
+        bool shares(NodeArena& other) {
+            return false;
+        }
+
+        //Exchanges every chunk and free slot with the other arena
+        void swap(NodeArena& other) {
+            chunks.swap(other.chunks);
+            std::swap(freeList, other.freeList);
+            std::swap(chunkUsed, other.chunkUsed);
+            std::swap(chunkSize, other.chunkSize);
+        }
+
+        NodeArena() {
+            freeList = NULL;
+            chunkUsed = 0;
+            chunkSize = 0;
+        }
+
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator=(const NodeArena&) = delete;
+
+        ~NodeArena() {
+            releaseAll();
+        }
+};
+
+//Polymorphic allocator, every node is allocated and freed individually by a std::pmr::memory_resource
+//(the default resource unless the container is given one)
+template <class T>
+class PmrAllocator {
+
+    private:
+        std::pmr::memory_resource* nodeResource;
+
+    public:
+        static const bool RELEASES_ALL = false;
+
+        /* Function: adopt
+         * Description: Checks that the other allocator's nodes can be freed by this one. Containers on different
+         *              resources cannot merge their nodes, so this is an error.
+        */ 
+        void adopt(PmrAllocator& other) {
+            if (!shares(other)) {
+                std::cout << "Err: Containers on different memory resources cannot take over each other's nodes.\n";
+                exit(1);
+            }
+        }
+
+        template <class... Args>
+        T* create(Args&&... args) {
+            void* memory = nodeResource->allocate(sizeof(T), alignof(T));
+            return new (memory) T(std::forward<Args>(args)...);
+        }
+
+        void destroy(T* node) {
+            node->~T();
+            nodeResource->deallocate(node, sizeof(T), alignof(T));
+        }
+
+        //Nodes are returned to the resource one at a time by destroy, a monotonic resource frees them all on release
+        void releaseAll() {}
+
+        std::pmr::memory_resource* resource() {
+            return nodeResource;
+        }
+
+        //Nodes may move between containers whose resources can free each other's memory
+        bool shares(PmrAllocator& other) {
+            return nodeResource->is_equal(*other.nodeResource);
+        }
+
+        //Nodes stay with the resource they came from, so the resources are exchanged along with the containers' nodes
+        void swap(PmrAllocator& other) {
+            std::swap(nodeResource, other.nodeResource);
+        }
+
+        PmrAllocator(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+            nodeResource = resource;
+        }
+};
+
+//Memory resource that passes every request on to another resource (the heap by default), counting the
+//allocations and frees and the bytes live and at their peak. Give each container its own to see its memory use.
+class TrackingResource : public std::pmr::memory_resource {
+
+    private:
+        std::pmr::memory_resource* upstream;
+        std::atomic<long long> numAllocations{0};
+        std::atomic<long long> numFrees{0};
+        std::atomic<long long> numLiveBytes{0};
+        std::atomic<long long> numPeakBytes{0};
+
+        void* do_allocate(size_t numBytes, size_t alignment) override {
+            void* memory = upstream->allocate(numBytes, alignment);
+            long long liveBytes = numLiveBytes.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+            long long peakBytes = numPeakBytes.load(std::memory_order_relaxed);
+
+            numAllocations.fetch_add(1, std::memory_order_relaxed);
+
+            while (peakBytes < liveBytes && !numPeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {}
+
+            return memory;
+        }
+
+        void do_deallocate(void* memory, size_t numBytes, size_t alignment) override {
+            upstream->deallocate(memory, numBytes, alignment);
+            numLiveBytes.fetch_sub(numBytes, std::memory_order_relaxed);
+            numFrees.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        long long allocations() const {
+            return numAllocations.load(std::memory_order_relaxed);
+        }
+
+        long long frees() const {
+            return numFrees.load(std::memory_order_relaxed);
+        }
+
+        long long liveBytes() const {
+            return numLiveBytes.load(std::memory_order_relaxed);
+        }
+
+        long long peakBytes() const {
+            return numPeakBytes.load(std::memory_order_relaxed);
+        }
+
+        void print() const {
+            std::cout << "Allocations: " << allocations() << " Frees: " << frees() << " Live bytes: " << liveBytes()
+                << " Peak bytes: " << peakBytes() << std::endl;
+        }
+
+        //Starts the counts again, with the peak at the bytes live now
+        void reset() {
+            numAllocations.store(0, std::memory_order_relaxed);
+            numFrees.store(0, std::memory_order_relaxed);
+            numPeakBytes.store(liveBytes(), std::memory_order_relaxed);
+        }
+
+        TrackingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) {
+            this->upstream = upstream;
+        }
+
+        TrackingResource(const TrackingResource&) = delete;
+        TrackingResource& operator=(const TrackingResource&) = delete;
+};
+
+#endif
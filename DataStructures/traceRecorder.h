@@ -0,0 +1,310 @@
+/* DESCRIPTION OF FILE
+
+    Operation trace recording shared by the RedBlack tree, the PriorityQ and MinMaxPriorityQ heaps and the Queue,
+    so that a workload seen in a real program can be replayed against other containers (see
+    Benchmarks/traceReplay.cpp).
+
+    A container records nothing until it is given a TraceRecorder with setRecorder, and then appends one record per
+    operation: its type, the key (maps) or priority (priority queues), and the container's size after it. Keys that
+    are not numbers are recorded as their std::hash, so a replay keeps the access pattern but not the key order.
+    Bulk operations (clear, set operations, scans and the batched lookups) are not recorded, and the recorder must
+    outlive every container it is attached to, or be detached by passing NULL.
+
+    Traces are compact: each record is one byte holding the operation and whether the size grew, shrank or stayed
+    the same, followed by the key or priority as a variable-length difference from the previous one. Sizes that
+    change by more than one are written out in full.
+*/
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+//Operations that can be recorded, stored in the low 4 bits of each record's first byte
+enum TraceOp { TRACE_GET, TRACE_PUT, TRACE_REMOVE, TRACE_INSERT, TRACE_DELETE_MAX, TRACE_DELETE_MIN, TRACE_ENQUEUE, TRACE_DEQUEUE, NUM_TRACE_OPS };
+
+const char* const TRACE_OP_NAMES[NUM_TRACE_OPS] = {"get", "put", "remove", "insert", "deleteMax", "deleteMin", "enqueue", "dequeue"};
+
+//Whether each operation's record carries a key or a priority
+const bool TRACE_OP_HAS_KEY[NUM_TRACE_OPS] = {true, true, true, false, false, false, false, false};
+const bool TRACE_OP_HAS_PRIORITY[NUM_TRACE_OPS] = {false, false, false, true, false, false, false, false};
+
+//Size change codes, stored in bits 4 and 5 of each record's first byte
+const uint8_t TRACE_SIZE_SAME = 0;
+const uint8_t TRACE_SIZE_GREW = 1;
+const uint8_t TRACE_SIZE_SHRANK = 2;
+const uint8_t TRACE_SIZE_WRITTEN = 3;
+
+const char TRACE_MAGIC[4] = {'C', 'T', 'R', 'C'};
+const uint8_t TRACE_VERSION = 1;
+
+//One decoded operation
+struct TraceRecord {
+    TraceOp op;
+    int64_t key;
+    int64_t priority;
+    uint64_t size;
+};
+
+//Returns a number or its std::hash as a trace key, and 0 for keys with neither
+template <typename Key>
+int64_t traceKey(const Key& key) {
+
+    if constexpr (std::is_arithmetic<Key>::value) {
+        return (int64_t) key;
+    }
+
+    else if constexpr (std::is_default_constructible<std::hash<Key> >::value) {
+        return (int64_t) std::hash<Key>()(key);
+    }
+
+    else {
+        return 0;
+    }
+}
+
+//Appends the value as a little-endian base-128 varint
+inline void writeVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back((uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+
+    bytes.push_back((uint8_t) value);
+}
+
+//Reads a varint written by writeVarint, returning false if the bytes run out first
+inline bool readVarint(const std::vector<uint8_t>& bytes, size_t& position, uint64_t& value) {
+    value = 0;
+
+    for (int shift = 0; shift < 64 && position < bytes.size(); shift += 7) {
+        uint8_t byte = bytes[position++];
+        value |= (uint64_t) (byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//Maps signed differences onto small unsigned values (0, -1, 1, -2, ... to 0, 1, 2, 3, ...)
+inline uint64_t zigzag(int64_t value) {
+    return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+//Difference and sum that wrap around instead of overflowing, since hashed keys span the whole int64_t range
+inline int64_t wrappingDifference(int64_t value, int64_t previous) {
+    return (int64_t) ((uint64_t) value - (uint64_t) previous);
+}
+
+inline int64_t wrappingSum(int64_t previous, int64_t difference) {
+    return (int64_t) ((uint64_t) previous + (uint64_t) difference);
+}
+
+//Writes the operations of the containers attached to it to one trace file. Safe to share between threads, but the
+//records of every attached container form a single stream, so attach one container to replay it faithfully.
+class TraceRecorder {
+
+    private:
+        //Buffered bytes written to the file once they pass this size
+        static const size_t FLUSH_BYTES = 1 << 16;
+
+        std::ofstream out;
+        std::vector<uint8_t> buffer;
+        std::mutex lock;
+        int64_t lastKey = 0;
+        int64_t lastPriority = 0;
+        uint64_t lastSize = 0;
+        uint64_t numRecords = 0;
+
+        void writeBuffer() {
+            out.write((const char*) buffer.data(), buffer.size());
+            buffer.clear();
+        }
+
+    public:
+        /* Function: open
+         * Description: Starts a new trace at the path, replacing any file there, and returns whether it could be
+         *              opened. A trace already being written is finished first.
+         *
+         * Param: const char* path
+        */
+        bool open(const char* path) {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (out.is_open()) {
+                writeBuffer();
+                out.close();
+            }
+
+            out.open(path, std::ios::binary | std::ios::trunc);
+            lastKey = 0;
+            lastPriority = 0;
+            lastSize = 0;
+            numRecords = 0;
+            buffer.assign(TRACE_MAGIC, TRACE_MAGIC + 4);
+            buffer.push_back(TRACE_VERSION);
+
+            return out.is_open();
+        }
+
+        /* Function: record
+         * Description: Appends one operation, given the container's size after it. Does nothing if no trace is open.
+         *
+         * Param: TraceOp op, int64_t key, int64_t priority, uint64_t size
+        */
+        void record(TraceOp op, int64_t key, int64_t priority, uint64_t size) {
+            std::lock_guard<std::mutex> guard(lock);
+            uint8_t sizeCode = TRACE_SIZE_WRITTEN;
+
+            if (!out.is_open()) {
+                return;
+            }
+
+            if (size == lastSize) {
+                sizeCode = TRACE_SIZE_SAME;
+            }
+
+            else if (size == lastSize + 1) {
+                sizeCode = TRACE_SIZE_GREW;
+            }
+
+            else if (size + 1 == lastSize) {
+                sizeCode = TRACE_SIZE_SHRANK;
+            }
+
+            buffer.push_back((uint8_t) (op | (sizeCode << 4)));
+
+            if (TRACE_OP_HAS_KEY[op]) {
+                writeVarint(buffer, zigzag(wrappingDifference(key, lastKey)));
+                lastKey = key;
+            }
+
+            if (TRACE_OP_HAS_PRIORITY[op]) {
+                writeVarint(buffer, zigzag(wrappingDifference(priority, lastPriority)));
+                lastPriority = priority;
+            }
+
+            if (sizeCode == TRACE_SIZE_WRITTEN) {
+                writeVarint(buffer, size);
+            }
+
+            lastSize = size;
+            numRecords++;
+
+            if (buffer.size() >= FLUSH_BYTES) {
+                writeBuffer();
+            }
+        }
+
+        //Writes out the buffered records, so the trace on disk is complete up to this point
+        void flush() {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (out.is_open()) {
+                writeBuffer();
+                out.flush();
+            }
+        }
+
+        //Finishes the trace, after which records are ignored until the next open
+        void close() {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (out.is_open()) {
+                writeBuffer();
+                out.close();
+            }
+        }
+
+        uint64_t size() {
+            std::lock_guard<std::mutex> guard(lock);
+            return numRecords;
+        }
+
+        TraceRecorder() {}
+        TraceRecorder(const TraceRecorder&) = delete;
+        TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+        ~TraceRecorder() {
+            close();
+        }
+};
+
+/* Function: loadTrace
+ * Description: Reads every record of the trace at the path into records, returning false if the file cannot be
+ *              read, is not a trace, or ends partway through a record.
+ *
+ * Param: const char* path, std::vector<TraceRecord>& records
+*/
+inline bool loadTrace(const char* path, std::vector<TraceRecord>& records) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t position = 5;
+    TraceRecord record = {TRACE_GET, 0, 0, 0};
+
+    records.clear();
+
+    if (!in || bytes.size() < 5 || !std::equal(TRACE_MAGIC, TRACE_MAGIC + 4, bytes.begin()) || bytes[4] != TRACE_VERSION) {
+        return false;
+    }
+
+    while (position < bytes.size()) {
+        uint8_t header = bytes[position++];
+        uint8_t sizeCode = (header >> 4) & 3;
+        uint64_t value = 0;
+
+        if ((header & 0x0F) >= NUM_TRACE_OPS) {
+            return false;
+        }
+
+        record.op = (TraceOp) (header & 0x0F);
+
+        if (TRACE_OP_HAS_KEY[record.op]) {
+            if (!readVarint(bytes, position, value)) {
+                return false;
+            }
+
+            record.key = wrappingSum(record.key, unzigzag(value));
+        }
+
+        if (TRACE_OP_HAS_PRIORITY[record.op]) {
+            if (!readVarint(bytes, position, value)) {
+                return false;
+            }
+
+            record.priority = wrappingSum(record.priority, unzigzag(value));
+        }
+
+        if (sizeCode == TRACE_SIZE_GREW) {
+            record.size++;
+        }
+
+        else if (sizeCode == TRACE_SIZE_SHRANK) {
+            record.size--;
+        }
+
+        else if (sizeCode == TRACE_SIZE_WRITTEN && !readVarint(bytes, position, record.size)) {
+            return false;
+        }
+
+        records.push_back(record);
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,792 @@
+/* DESCRIPTION OF PROGRAM
+
+    Checks for every container in the repository, run by ctest. Each group drives its containers through a seeded
+    random mix of operations alongside the standard library equivalent (std::stack, std::queue, std::priority_queue,
+    std::multiset or std::map) and checks every result against it, calling validate() on the trees that have one.
+    A failed check prints the container and line and exits with 1.
+
+    Usage: containerTests group
+    Groups: stacks, queues, priorityQueues, maps, redBlack, persistent, concurrent
+*/
+
+#include <map>
+#include <memory_resource>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "adaptiveRadixTree.h"
+#include "arrayStack.h"
+#include "bPlusTree.h"
+#include "bst.h"
+#include "listQueue.h"
+#include "listStack.h"
+#include "persistentRedBlackTree.h"
+#include "priorityQueue.h"
+#include "redBlackTree.h"
+#include "skipList.h"
+
+using namespace std;
+
+//Operations each container is put through, and the range its keys are drawn from
+const int NUM_OPS = 20000;
+const int KEY_RANGE = 2000;
+
+//Name of the container being checked, printed when a check fails
+string checkedContainer;
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+inline void check(bool passed, const char* condition, int line) {
+
+    if (!passed) {
+        cout << "Err: " << checkedContainer << ": check failed on line " << line << ": " << condition << endl;
+        exit(1);
+    }
+}
+
+//Returns the pairs of the map with keys between lowKey and highKey (inclusive), in key order
+std::vector<std::pair<int,int> > expectedRange(const std::map<int,int>& expected, int lowKey, int highKey) {
+    return std::vector<std::pair<int,int> >(expected.lower_bound(lowKey), expected.upper_bound(highKey));
+}
+
+//STACKS AND QUEUES
+
+//Pushes and pops a random mix on the stack alongside std::stack
+template <typename Stack>
+void checkStack(const string& name, Stack& stack) {
+    std::stack<int> expected;
+    std::mt19937 random(1);
+
+    checkedContainer = name;
+
+    for (int i = 0; i < NUM_OPS; i++) {
+        if (expected.empty() || random() % 3 != 0) {
+            stack.push(i);
+            expected.push(i);
+        }
+
+        else {
+            CHECK(stack.pop() == expected.top());
+            expected.pop();
+        }
+
+        CHECK(stack.size() == (int) expected.size());
+    }
+
+    while (!expected.empty()) {
+        CHECK(stack.pop() == expected.top());
+        expected.pop();
+    }
+
+    CHECK(stack.size() == 0);
+}
+
+//Enqueues and dequeues a random mix on the queue alongside std::queue
+template <typename Queue>
+void checkQueue(const string& name, Queue& queue) {
+    std::queue<int> expected;
+    std::mt19937 random(2);
+
+    checkedContainer = name;
+
+    for (int i = 0; i < NUM_OPS; i++) {
+        if (expected.empty() || random() % 3 != 0) {
+            queue.enqueue(i);
+            expected.push(i);
+        }
+
+        else {
+            CHECK(queue.dequeue() == expected.front());
+            expected.pop();
+        }
+
+        CHECK(queue.size() == (int) expected.size());
+    }
+
+    queue.clear();
+    CHECK(queue.size() == 0);
+}
+
+void testStacks() {
+    std::pmr::unsynchronized_pool_resource pool;
+    ArrayStack<int> arrayStack;
+    Stack<int> heapStack;
+    Stack<int,NodeArena> arenaStack;
+    Stack<int,PmrAllocator> pmrStack(&pool);
+
+    checkStack("ArrayStack", arrayStack);
+    checkStack("Stack<HeapAllocator>", heapStack);
+    checkStack("Stack<NodeArena>", arenaStack);
+    checkStack("Stack<PmrAllocator>", pmrStack);
+}
+
+void testQueues() {
+    std::pmr::unsynchronized_pool_resource pool;
+    Queue<int> heapQueue;
+    Queue<int,NodeArena> arenaQueue;
+    Queue<int,PmrAllocator> pmrQueue(&pool);
+
+    checkQueue("Queue<HeapAllocator>", heapQueue);
+    checkQueue("Queue<NodeArena>", arenaQueue);
+    checkQueue("Queue<PmrAllocator>", pmrQueue);
+}
+
+//PRIORITY QUEUES
+
+//Inserts and removes a random mix on the queue alongside std::priority_queue, with each value equal to its priority
+//so that ties cannot change the expected results
+template <typename PriorityQueue>
+void checkPriorityQueue(const string& name, PriorityQueue& queue) {
+    std::priority_queue<int> expected;
+    std::mt19937 random(3);
+
+    checkedContainer = name;
+
+    for (int i = 0; i < NUM_OPS; i++) {
+        if (expected.empty() || random() % 3 != 0) {
+            int priority = random() % KEY_RANGE;
+            queue.insert(priority, priority);
+            expected.push(priority);
+        }
+
+        else {
+            CHECK(queue.deleteMax() == expected.top());
+            expected.pop();
+        }
+
+        CHECK(queue.size() == (int) expected.size());
+    }
+
+    queue.clear();
+    CHECK(queue.size() == 0);
+
+    queue.insert(5, 5);
+    CHECK(queue.deleteMax() == 5);
+}
+
+//Inserts and removes from both ends of a MinMaxPriorityQ alongside std::multiset
+void checkMinMaxPriorityQueue() {
+    MinMaxPriorityQ<int> queue;
+    std::multiset<int> expected;
+    std::mt19937 random(4);
+
+    checkedContainer = "MinMaxPriorityQ";
+
+    for (int i = 0; i < NUM_OPS; i++) {
+        int choice = random() % 4;
+
+        if (expected.empty() || choice < 2) {
+            int priority = random() % KEY_RANGE;
+            queue.insert(priority, priority);
+            expected.insert(priority);
+        }
+
+        else if (choice == 2) {
+            CHECK(queue.peekMin() == *expected.begin());
+            CHECK(queue.deleteMin() == *expected.begin());
+            expected.erase(expected.begin());
+        }
+
+        else {
+            CHECK(queue.peekMax() == *expected.rbegin());
+            CHECK(queue.deleteMax() == *expected.rbegin());
+            expected.erase(std::prev(expected.end()));
+        }
+
+        CHECK(queue.size() == (int) expected.size());
+    }
+}
+
+void testPriorityQueues() {
+    std::pmr::unsynchronized_pool_resource pool;
+    PriorityQ<int> heapQueue;
+    PriorityQ<int,NodeArena> arenaQueue;
+    PriorityQ<int,PmrAllocator> pmrQueue(&pool);
+
+    checkPriorityQueue("PriorityQ<HeapAllocator>", heapQueue);
+    checkPriorityQueue("PriorityQ<NodeArena>", arenaQueue);
+    checkPriorityQueue("PriorityQ<PmrAllocator>", pmrQueue);
+    checkMinMaxPriorityQueue();
+}
+
+//ORDERED MAPS
+
+/* Function: checkMap
+ * Description: Runs a random mix of puts, removes and lookups on the map alongside std::map, checking every lookup
+ *              and the size as it goes, and every key of the range and validate every 1000 operations. Missing keys
+ *              are only checked with contains, since get returns V() for them. Returns the pairs the map ends with.
+ *
+ * Param: const string& name, Map& map, Validate validate
+*/
+template <typename Map, typename Validate>
+std::map<int,int> checkMap(const string& name, Map& map, Validate validate) {
+    std::map<int,int> expected;
+    std::mt19937 random(5);
+
+    checkedContainer = name;
+
+    for (int i = 0; i < NUM_OPS; i++) {
+        int key = random() % KEY_RANGE;
+        int choice = random() % 4;
+
+        if (choice < 2) {
+            map.put(key, i);
+            expected[key] = i;
+        }
+
+        else if (choice == 2) {
+            map.remove(key);
+            expected.erase(key);
+        }
+
+        else if (expected.count(key) > 0) {
+            CHECK(map.contains(key));
+            CHECK(map.get(key) == expected[key]);
+        }
+
+        else {
+            CHECK(!map.contains(key));
+        }
+
+        CHECK(map.size() == (int) expected.size());
+
+        if (i % 1000 == 999) {
+            for (int checkedKey = 0; checkedKey < KEY_RANGE; checkedKey++) {
+                CHECK(map.contains(checkedKey) == (expected.count(checkedKey) > 0));
+                CHECK(!map.contains(checkedKey) || map.get(checkedKey) == expected[checkedKey]);
+            }
+
+            CHECK(validate());
+        }
+    }
+
+    return expected;
+}
+
+//Checks random range scans of the map, and its min and max, against the pairs it holds
+template <typename Map>
+void checkOrdered(Map& map, const std::map<int,int>& expected) {
+    std::mt19937 random(8);
+
+    for (int i = 0; i < 100; i++) {
+        std::vector<std::pair<int,int> > scanned;
+        int lowKey = random() % KEY_RANGE;
+        int highKey = lowKey + random() % (KEY_RANGE / 4);
+
+        map.rangeScan(lowKey, highKey, [&](int scannedKey, int scannedValue) {
+            scanned.push_back(std::make_pair(scannedKey, scannedValue));
+        });
+
+        CHECK(scanned == expectedRange(expected, lowKey, highKey));
+    }
+
+    CHECK(map.min() == expected.begin()->second);
+    CHECK(map.max() == expected.rbegin()->second);
+}
+
+//Runs checkMap on a BST with the balance policy, then checks min and max
+template <typename Balance>
+void checkBalance(const string& name) {
+    BST<int,int,Balance> tree;
+    std::map<int,int> expected = checkMap(name, tree, [&]() { return tree.validate(); });
+
+    CHECK(tree.min() == expected.begin()->second);
+    CHECK(tree.max() == expected.rbegin()->second);
+}
+
+void testMaps() {
+    std::pmr::unsynchronized_pool_resource pool;
+    auto noValidate = []() { return true; };
+
+    {
+        RedBlack<int,int> tree;
+        checkOrdered(tree, checkMap("RedBlack<NodeArena>", tree, [&]() { return tree.validate(); }));
+    }
+
+    {
+        RedBlack<int,int,HeapAllocator> tree;
+        checkOrdered(tree, checkMap("RedBlack<HeapAllocator>", tree, [&]() { return tree.validate(); }));
+    }
+
+    {
+        RedBlack<int,int,PmrAllocator> tree(&pool);
+        checkOrdered(tree, checkMap("RedBlack<PmrAllocator>", tree, [&]() { return tree.validate(); }));
+    }
+
+    {
+        CompactRedBlack<int,int> tree;
+        checkOrdered(tree, checkMap("CompactRedBlack", tree, [&]() { return tree.validate(); }));
+    }
+
+    checkBalance<Unbalanced>("BST<Unbalanced>");
+    checkBalance<Treap>("BST<Treap>");
+    checkBalance<Scapegoat>("BST<Scapegoat>");
+    checkBalance<Splay>("BST<Splay>");
+    checkBalance<SemiSplay>("BST<SemiSplay>");
+
+    {
+        BPlusTree<int,int> tree;
+        checkOrdered(tree, checkMap("BPlusTree", tree, noValidate));
+    }
+
+    //64-bit keys take the SSE4.2 search where the build enables it
+    {
+        BPlusTree<int64_t,int64_t> tree;
+        checkOrdered(tree, checkMap("BPlusTree<int64_t>", tree, noValidate));
+    }
+
+    {
+        AdaptiveRadixTree<int,int> tree;
+        checkOrdered(tree, checkMap("AdaptiveRadixTree", tree, noValidate));
+    }
+
+    {
+        SkipList<int,int> list;
+        checkMap("SkipList", list, noValidate);
+    }
+
+    {
+        ShardedRedBlack<int,int> tree({KEY_RANGE / 4, KEY_RANGE / 2, KEY_RANGE * 3 / 4});
+        checkOrdered(tree, checkMap("ShardedRedBlack", tree, noValidate));
+    }
+
+    {
+        BufferedRedBlack<int,int> tree(64);
+        checkOrdered(tree, checkMap("BufferedRedBlack", tree, noValidate));
+    }
+
+    {
+        IndexedRedBlack<int,int> tree;
+        checkOrdered(tree, checkMap("IndexedRedBlack", tree, noValidate));
+    }
+}
+
+//REDBLACK ORDERED OPERATIONS
+
+//Fills the tree and the map with numKeys random keys from the range
+void fillRandom(RedBlack<int,int>& tree, std::map<int,int>& expected, int numKeys, int keyRange, std::mt19937& random) {
+    for (int i = 0; i < numKeys; i++) {
+        int key = random() % keyRange;
+        tree.put(key, key * 3 + 1);
+        expected[key] = key * 3 + 1;
+    }
+}
+
+//Returns whether the tree holds exactly the pairs of the map
+bool sameContents(RedBlack<int,int>& tree, const std::map<int,int>& expected) {
+    std::vector<std::pair<int,int> > contents;
+
+    for (RedBlack<int,int>::iterator iter = tree.begin(); iter != tree.end(); ++iter) {
+        contents.push_back(std::make_pair(iter->key, iter->value));
+    }
+
+    return tree.size() == (int) expected.size() && contents == std::vector<std::pair<int,int> >(expected.begin(), expected.end());
+}
+
+/* Function: testRedBlack
+ * Description: Checks the RedBlack operations beyond the map interface against std::map: iteration, floor and
+ *              ceiling, rank and select, bulk loading, batched lookups, the frozen index, and the set operations.
+*/
+//Saves RedBlack<int,double> trees with odd and even numbers of keys, so the values do not always start on a multiple
+//of alignof(double) after the keys, and checks the mapped snapshot and a tree loaded from it hold the same pairs
+void checkSnapshot() {
+    const char* path = "containerTests.snapshot";
+
+    checkedContainer = "RedBlack snapshot";
+
+    for (int numKeys = 0; numKeys < 20; numKeys += 3) {
+        RedBlack<int,double> tree;
+        RedBlack<int,double> loaded;
+
+        for (int key = 0; key < numKeys; key++) {
+            tree.put(key * 7, key * 0.5);
+        }
+
+        CHECK(tree.save(path));
+
+        {
+            MappedSnapshot<int,double> snapshot(path);
+            int index = 0;
+
+            CHECK(snapshot.isValid());
+            CHECK(snapshot.size() == numKeys);
+
+            for (MappedSnapshot<int,double>::iterator iter = snapshot.begin(); iter != snapshot.end(); ++iter, index++) {
+                CHECK(iter->first == index * 7 && iter->second == index * 0.5);
+                CHECK(snapshot.get(index * 7) == index * 0.5);
+            }
+
+            CHECK(numKeys == 0 || snapshot.max() == (numKeys - 1) * 0.5);
+        }
+
+        CHECK(loaded.load(path));
+        CHECK(loaded.validate());
+        CHECK(loaded.size() == numKeys);
+        CHECK(numKeys == 0 || loaded.get((numKeys - 1) * 7) == (numKeys - 1) * 0.5);
+    }
+
+    remove(path);
+}
+
+void testRedBlack() {
+    checkSnapshot();
+    RedBlack<int,int> tree;
+    std::map<int,int> expected;
+    std::mt19937 random(6);
+
+    checkedContainer = "RedBlack";
+    fillRandom(tree, expected, KEY_RANGE, KEY_RANGE * 2, random);
+    CHECK(sameContents(tree, expected));
+    CHECK(tree.min() == expected.begin()->second);
+    CHECK(tree.max() == expected.rbegin()->second);
+
+    for (int i = 0; i < 1000; i++) {
+        int key = random() % (KEY_RANGE * 2 + 2) - 1;
+        std::map<int,int>::iterator above = expected.lower_bound(key);
+        std::map<int,int>::iterator below = expected.upper_bound(key);
+
+        CHECK(tree.ceiling(key) == tree.end() ? above == expected.end() : above != expected.end() && tree.ceiling(key)->key == above->first);
+        CHECK(tree.floor(key) == tree.end() ? below == expected.begin() : below != expected.begin() && tree.floor(key)->key == std::prev(below)->first);
+        CHECK(tree.rank(key) == (int) std::distance(expected.begin(), above));
+    }
+
+    int rank = 0;
+
+    for (std::pair<const int,int>& entry : expected) {
+        CHECK(tree.select(rank++)->key == entry.first);
+    }
+
+    CHECK(tree.select(rank) == tree.end());
+
+    std::vector<int> searchKeys;
+    std::vector<int> values;
+    std::vector<bool> found;
+
+    for (int i = 0; i < 500; i++) {
+        searchKeys.push_back(random() % (KEY_RANGE * 2));
+    }
+
+    tree.getMany(searchKeys, values);
+    tree.containsMany(searchKeys, found);
+    EytzingerIndex<int,int> index = tree.freeze();
+    CHECK(index.size() == (int) expected.size());
+
+    for (int i = 0; i < (int) searchKeys.size(); i++) {
+        bool present = expected.count(searchKeys[i]) > 0;
+        int value = present ? expected[searchKeys[i]] : 0;
+
+        CHECK(found[i] == present);
+        CHECK(values[i] == value);
+        CHECK(index.contains(searchKeys[i]) == present);
+        CHECK(index.get(searchKeys[i]) == value);
+    }
+
+    //Bulk loading
+
+    std::vector<std::pair<int,int> > sortedPairs(expected.begin(), expected.end());
+    RedBlack<int,int> builtTree;
+    builtTree.buildFromSorted(sortedPairs.begin(), sortedPairs.end());
+    builtTree.appendSorted(KEY_RANGE * 3, 7);
+    expected[KEY_RANGE * 3] = 7;
+    CHECK(builtTree.validate());
+    CHECK(sameContents(builtTree, expected));
+
+    //Split and join
+
+    RedBlack<int,int> higher;
+    std::map<int,int> expectedHigher(expected.lower_bound(KEY_RANGE), expected.end());
+    builtTree.split(KEY_RANGE, higher);
+    expected.erase(expected.lower_bound(KEY_RANGE), expected.end());
+    CHECK(builtTree.validate() && higher.validate());
+    CHECK(sameContents(builtTree, expected));
+    CHECK(sameContents(higher, expectedHigher));
+
+    builtTree.join(higher);
+    expected.insert(expectedHigher.begin(), expectedHigher.end());
+    CHECK(builtTree.validate());
+    CHECK(sameContents(builtTree, expected));
+    CHECK(higher.size() == 0);
+
+    //Set operations, each against a fresh tree of overlapping keys
+
+    const char* operations[3] = {"unionWith", "intersectWith", "difference"};
+
+    for (int operation = 0; operation < 3; operation++) {
+        RedBlack<int,int> left;
+        RedBlack<int,int> right;
+        std::map<int,int> expectedLeft;
+        std::map<int,int> expectedRight;
+
+        checkedContainer = string("RedBlack::") + operations[operation];
+        fillRandom(left, expectedLeft, KEY_RANGE * 4, KEY_RANGE * 8, random);
+
+        for (int i = 0; i < KEY_RANGE * 2; i++) {
+            int key = random() % (KEY_RANGE * 8);
+            right.put(key, -key);
+            expectedRight[key] = -key;
+        }
+
+        if (operation == 0) {
+            left.unionWith(right);
+
+            for (std::pair<const int,int>& entry : expectedRight) {
+                expectedLeft[entry.first] = entry.second;
+            }
+        }
+
+        else if (operation == 1) {
+            left.intersectWith(right);
+
+            for (std::map<int,int>::iterator iter = expectedLeft.begin(); iter != expectedLeft.end();) {
+                iter = expectedRight.count(iter->first) > 0 ? std::next(iter) : expectedLeft.erase(iter);
+            }
+        }
+
+        else {
+            left.difference(right);
+
+            for (std::pair<const int,int>& entry : expectedRight) {
+                expectedLeft.erase(entry.first);
+            }
+        }
+
+        CHECK(left.validate());
+        CHECK(sameContents(left, expectedLeft));
+        CHECK(right.size() == 0);
+    }
+}
+
+//PERSISTENT AND CONCURRENT MAPS
+
+//Checks that snapshots of a PersistentRedBlack keep the contents they were taken with while the tree changes
+void testPersistent() {
+    PersistentRedBlack<int,int> tree;
+    std::map<int,int> expected;
+    std::mt19937 random(7);
+
+    checkedContainer = "PersistentRedBlack";
+
+    for (int round = 0; round < 10; round++) {
+        Snapshot<int,int> before = tree.snapshot();
+        std::map<int,int> expectedBefore = expected;
+
+        for (int i = 0; i < NUM_OPS / 10; i++) {
+            int key = random() % KEY_RANGE;
+
+            if (random() % 3 != 0) {
+                tree.put(key, i);
+                expected[key] = i;
+            }
+
+            else {
+                tree.remove(key);
+                expected.erase(key);
+            }
+        }
+
+        std::vector<std::pair<int,int> > scanned;
+        before.rangeScan(0, KEY_RANGE, [&](int key, int value) { scanned.push_back(std::make_pair(key, value)); });
+        CHECK(before.size() == (int) expectedBefore.size());
+        CHECK(scanned == expectedRange(expectedBefore, 0, KEY_RANGE));
+
+        for (int key = 0; key < KEY_RANGE; key++) {
+            CHECK(tree.contains(key) == (expected.count(key) > 0));
+            CHECK(!tree.contains(key) || tree.get(key) == expected[key]);
+        }
+    }
+}
+
+/* Function: checkConcurrentMap
+ * Description: Has numThreads threads each put and remove their own share of the keys on the map at once, then
+ *              checks the map holds exactly the keys each thread left behind.
+ *
+ * Param: const string& name, Map& map, int numThreads
+*/
+template <typename Map>
+void checkConcurrentMap(const string& name, Map& map, int numThreads) {
+    std::vector<std::thread> threads;
+
+    checkedContainer = name;
+
+    for (int i = 0; i < numThreads; i++) {
+        threads.push_back(std::thread([&map, i, numThreads]() {
+            for (int key = i; key < KEY_RANGE * 4; key += numThreads) {
+                map.put(key, key * 2);
+            }
+
+            for (int key = i; key < KEY_RANGE * 4; key += numThreads * 3) {
+                map.remove(key);
+            }
+        }));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    int numKept = 0;
+
+    for (int key = 0; key < KEY_RANGE * 4; key++) {
+        bool kept = (key / numThreads) % 3 != 0;
+        numKept += kept;
+
+        CHECK(map.contains(key) == kept);
+        CHECK(!kept || map.get(key) == key * 2);
+    }
+
+    CHECK(map.size() == numKept);
+}
+
+/* Function: checkThreadTurnover
+ * Description: Runs more threads than a SkipList has thread records, one after another, each putting and removing
+ *              keys on one long-lived list and on a list of its own that it destroys. Checks the records of exited
+ *              threads are claimed again and the long-lived list holds the keys left behind.
+ *
+ * Param: int numThreads
+*/
+void checkThreadTurnover(int numThreads) {
+    SkipList<int,int> list;
+
+    checkedContainer = "SkipList (thread turnover)";
+
+    for (int i = 0; i < numThreads; i++) {
+        std::thread thread([&list, i]() {
+            SkipList<int,int> ownList;
+
+            for (int key = i * 10; key < i * 10 + 10; key++) {
+                list.put(key, key * 2);
+                ownList.put(key, key);
+                ownList.remove(key);
+            }
+
+            list.remove(i * 10);
+        });
+
+        thread.join();
+    }
+
+    CHECK(list.size() == numThreads * 9);
+
+    for (int key = 0; key < numThreads * 10; key++) {
+        CHECK(list.contains(key) == (key % 10 != 0));
+        CHECK(key % 10 == 0 || list.get(key) == key * 2);
+    }
+}
+
+/* Function: checkShardRebalance
+ * Description: Has numThreads threads each run a mix of puts, removes and lookups on their own keys of a
+ *              ShardedRedBlack, nine in ten of them between hotLow and hotHigh, enough for the hot shard to be split
+ *              several times. Checks the number of shards stayed the same, that a shard now starts inside the hot
+ *              range, and that the map holds exactly the keys each thread left behind, in order.
+ *
+ * Param: const string& name, std::vector<int> splitKeys, int hotLow, int hotHigh, int numThreads
+*/
+void checkShardRebalance(const string& name, std::vector<int> splitKeys, int hotLow, int hotHigh, int numThreads) {
+    const int keyRange = KEY_RANGE * 4;
+    const int opsPerThread = 100000;
+    ShardedRedBlack<int,int> tree(splitKeys);
+    std::vector<std::map<int,int> > threadExpected(numThreads);
+    std::vector<std::thread> threads;
+
+    checkedContainer = name;
+
+    for (int i = 0; i < numThreads; i++) {
+        threads.push_back(std::thread([&, i]() {
+            std::map<int,int>& expected = threadExpected[i];
+            std::mt19937 random(10 + i);
+            int checkFailures = 0;
+
+            for (int j = 0; j < opsPerThread; j++) {
+                int low = random() % 10 != 0 ? hotLow : 0;
+                int high = low == hotLow ? hotHigh : keyRange;
+                int key = low + (random() % ((high - low) / numThreads)) * numThreads + i;
+                int choice = random() % 4;
+
+                if (choice < 2) {
+                    tree.put(key, j);
+                    expected[key] = j;
+                }
+
+                else if (choice == 2) {
+                    tree.remove(key);
+                    expected.erase(key);
+                }
+
+                else if (tree.contains(key) != (expected.count(key) > 0) || (expected.count(key) > 0 && tree.get(key) != expected[key])) {
+                    checkFailures++;
+                }
+            }
+
+            CHECK(checkFailures == 0);
+        }));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::map<int,int> expected;
+
+    for (std::map<int,int>& keys : threadExpected) {
+        expected.insert(keys.begin(), keys.end());
+    }
+
+    std::vector<int> newSplitKeys = tree.splitKeys();
+    bool splitHotRange = false;
+
+    for (int splitKey : newSplitKeys) {
+        splitHotRange = splitHotRange || (splitKey > hotLow && splitKey < hotHigh);
+    }
+
+    CHECK(tree.numShards() == (int) splitKeys.size() + 1);
+    CHECK(splitHotRange);
+
+    std::vector<std::pair<int,int> > scanned;
+    tree.rangeScan(0, keyRange, [&](int key, int value) { scanned.push_back(std::make_pair(key, value)); });
+    CHECK(tree.size() == (int) expected.size());
+    CHECK(scanned == expectedRange(expected, 0, keyRange));
+
+    for (int key = 0; key < keyRange; key++) {
+        CHECK(tree.contains(key) == (expected.count(key) > 0));
+        CHECK(!tree.contains(key) || tree.get(key) == expected[key]);
+    }
+}
+
+void testConcurrent() {
+    int numThreads = 4;
+    SkipList<int,int> list;
+    ShardedRedBlack<int,int> tree({KEY_RANGE, KEY_RANGE * 2, KEY_RANGE * 3});
+
+    checkConcurrentMap("SkipList", list, numThreads);
+    checkConcurrentMap("ShardedRedBlack", tree, numThreads);
+    checkThreadTurnover(SKIP_MAX_THREADS + 72);
+
+    //Skewed loads on the first of eight shards, and on the middle of three
+    checkShardRebalance("ShardedRedBlack (skewed, 8 shards)", {1000, 2000, 3000, 4000, 5000, 6000, 7000}, 0, 1000, numThreads);
+    checkShardRebalance("ShardedRedBlack (skewed, 3 shards)", {3000, 5000}, 3000, 5000, numThreads);
+}
+
+//Driver for running one group of checks
+int main(int argc, char** argv) {
+    const char* groups[7] = {"stacks", "queues", "priorityQueues", "maps", "redBlack", "persistent", "concurrent"};
+    void (*tests[7])() = {testStacks, testQueues, testPriorityQueues, testMaps, testRedBlack, testPersistent, testConcurrent};
+
+    for (int i = 0; i < 7 && argc == 2; i++) {
+        if (strcmp(argv[1], groups[i]) == 0) {
+            tests[i]();
+            cout << groups[i] << ": all checks passed" << endl;
+            return 0;
+        }
+    }
+
+    cout << "Usage: " << argv[0] << " group" << endl;
+    cout << "Groups: stacks, queues, priorityQueues, maps, redBlack, persistent, concurrent" << endl;
+    return 1;
+}
@@ -0,0 +1,239 @@
+/* DESCRIPTION OF PROGRAM
+
+    Checks for GridPathfinder and PathfinderPool (see Algorithms/gridPathfinder.h), run by ctest. Random queries on
+    seeded random maps are answered with Dijkstra's algorithm, A* and JPS and checked against a plain Dijkstra on
+    double costs with std::priority_queue. Each returned path is walked to check its moves are legal and add up
+    to the returned cost. A failed check prints the map, query and line and exits with 1.
+
+    Paths may be longer than the shortest by the rounding of PriorityQ priorities, 1/1024 of a cell per step, so
+    costs are compared to within PATH_TOLERANCE.
+*/
+
+#include <math.h>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Algorithms/gridPathfinder.h"
+
+using namespace std;
+
+const double PATH_TOLERANCE = 0.01;
+
+//Map and query being checked, printed when a check fails
+string checkedQuery;
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+inline void check(bool passed, const char* condition, int line) {
+
+    if (!passed) {
+        cout << "Err: " << checkedQuery << ": check failed on line " << line << ": " << condition << endl;
+        exit(1);
+    }
+}
+
+//Returns whether a single move between the cells is legal: to an open neighbour, diagonally only between open cells
+bool isLegalMove(const GridMap& map, int fromX, int fromY, int toX, int toY) {
+    int dx = toX - fromX;
+    int dy = toY - fromY;
+
+    if (abs(dx) > 1 || abs(dy) > 1 || !map.isOpen(toX, toY)) {
+        return false;
+    }
+
+    return dx == 0 || dy == 0 || (map.isOpen(fromX + dx, fromY) && map.isOpen(fromX, fromY + dy));
+}
+
+/* Function: exactCost
+ * Description: Returns the cost of the shortest path between the cells, or -1 if there is none, with a textbook
+ *              Dijkstra on double costs that shares no code with GridPathfinder.
+ *
+ * Param: const GridMap& map, int startX, int startY, int goalX, int goalY
+*/
+double exactCost(const GridMap& map, int startX, int startY, int goalX, int goalY) {
+    int width = map.getWidth();
+    std::vector<double> costs(width * map.getHeight(), -1);
+    std::priority_queue<std::pair<double,int>, std::vector<std::pair<double,int> >, std::greater<std::pair<double,int> > > open;
+
+    if (!map.isOpen(startX, startY) || !map.isOpen(goalX, goalY)) {
+        return -1;
+    }
+
+    costs[startY * width + startX] = 0;
+    open.push(std::make_pair(0.0, startY * width + startX));
+
+    while (!open.empty()) {
+        std::pair<double,int> next = open.top();
+        int x = next.second % width;
+        int y = next.second / width;
+
+        open.pop();
+
+        if (next.first > costs[next.second]) {
+            continue;
+        }
+
+        if (x == goalX && y == goalY) {
+            return next.first;
+        }
+
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if ((dx != 0 || dy != 0) && isLegalMove(map, x, y, x + dx, y + dy)) {
+                    int neighbour = (y + dy) * width + x + dx;
+                    double cost = next.first + (dx != 0 && dy != 0 ? sqrt(2.0) : 1.0);
+
+                    if (costs[neighbour] < 0 || cost < costs[neighbour]) {
+                        costs[neighbour] = cost;
+                        open.push(std::make_pair(cost, neighbour));
+                    }
+                }
+            }
+        }
+    }
+
+    return -1;
+}
+
+/* Function: walkPath
+ * Description: Walks the path one cell at a time, checking it starts and ends at the query's cells and that every
+ *              move is legal, and returns its cost. Consecutive points of a JPS path lie on one straight or
+ *              diagonal line, which is walked cell by cell.
+ *
+ * Param: const GridMap& map, const std::vector<Vector2>& path, const PathQuery& query
+*/
+double walkPath(const GridMap& map, const std::vector<Vector2>& path, const PathQuery& query) {
+    double cost = 0;
+
+    CHECK(!path.empty());
+    CHECK(path.front().xCoord == query.startX && path.front().yCoord == query.startY);
+    CHECK(path.back().xCoord == query.goalX && path.back().yCoord == query.goalY);
+
+    for (size_t i = 1; i < path.size(); i++) {
+        int x = path[i - 1].xCoord;
+        int y = path[i - 1].yCoord;
+        int toX = path[i].xCoord;
+        int toY = path[i].yCoord;
+
+        while (x != toX || y != toY) {
+            int dx = (toX > x) - (toX < x);
+            int dy = (toY > y) - (toY < y);
+
+            CHECK(isLegalMove(map, x, y, x + dx, y + dy));
+            cost += dx != 0 && dy != 0 ? sqrt(2.0) : 1.0;
+            x += dx;
+            y += dy;
+        }
+    }
+
+    return cost;
+}
+
+/* Function: checkMap
+ * Description: Answers numQueries random queries on the map with every algorithm, one query at a time and as a
+ *              batch, and checks each against exactCost and its own path.
+ *
+ * Param: const string& name, const GridMap& map, int numQueries, std::mt19937& random
+*/
+void checkMap(const string& name, const GridMap& map, int numQueries, std::mt19937& random) {
+    GridPathfinder pathfinder(map);
+    PathfinderPool pool(map, 3);
+    std::vector<PathQuery> queries;
+    std::vector<double> exactCosts;
+    std::vector<Vector2> path;
+
+    for (int i = 0; i < numQueries; i++) {
+        PathQuery query = {(int) (random() % map.getWidth()), (int) (random() % map.getHeight()), (int) (random() % map.getWidth()), (int) (random() % map.getHeight())};
+        queries.push_back(query);
+        exactCosts.push_back(exactCost(map, query.startX, query.startY, query.goalX, query.goalY));
+    }
+
+    for (int algorithm = 0; algorithm < NUM_PATH_ALGORITHMS; algorithm++) {
+        std::vector<float> batchCosts;
+        pool.findPaths((PathAlgorithm) algorithm, queries, batchCosts);
+
+        for (int i = 0; i < numQueries; i++) {
+            const PathQuery& query = queries[i];
+            std::ostringstream description;
+            description << name << ", " << PATH_ALGORITHM_NAMES[algorithm] << " from (" << query.startX << ", "
+                        << query.startY << ") to (" << query.goalX << ", " << query.goalY << ")";
+            checkedQuery = description.str();
+
+            float cost = pathfinder.findPath((PathAlgorithm) algorithm, query.startX, query.startY, query.goalX, query.goalY, &path);
+
+            CHECK(batchCosts[i] == cost);
+
+            if (exactCosts[i] < 0) {
+                CHECK(cost == -1);
+                CHECK(path.empty());
+                continue;
+            }
+
+            CHECK(cost >= exactCosts[i] - PATH_TOLERANCE && cost <= exactCosts[i] + PATH_TOLERANCE);
+            CHECK(fabs(walkPath(map, path, query) - cost) <= PATH_TOLERANCE);
+        }
+    }
+}
+
+//Builds a map of the given size with about the given fraction of its cells blocked at random
+GridMap makeRandomMap(int width, int height, double blockedFraction, std::mt19937& random) {
+    GridMap map(width, height);
+    std::uniform_real_distribution<double> chance(0, 1);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            map.setOpen(x, y, chance(random) >= blockedFraction);
+        }
+    }
+
+    return map;
+}
+
+//Checks that a map written in the Moving AI format loads with the same cells
+void checkLoad() {
+    const char* path = "pathfinderTests.map";
+    FILE* file = fopen(path, "w");
+
+    checkedQuery = "GridMap::load";
+    CHECK(file != NULL);
+    fputs("type octile\nheight 3\nwidth 4\nmap\n.@G.\nT..S\n...@\n", file);
+    fclose(file);
+
+    GridMap map;
+    CHECK(map.load(path));
+    remove(path);
+
+    CHECK(map.getWidth() == 4 && map.getHeight() == 3);
+    CHECK(map.isOpen(0, 0) && !map.isOpen(1, 0) && map.isOpen(2, 0) && map.isOpen(3, 0));
+    CHECK(!map.isOpen(0, 1) && map.isOpen(3, 1) && !map.isOpen(3, 2));
+    CHECK(!map.isOpen(-1, 0) && !map.isOpen(4, 0) && !map.isOpen(0, 3));
+    CHECK(!map.load("missing.map"));
+}
+
+//Driver for running the checks
+int main() {
+    std::mt19937 random(1);
+
+    checkLoad();
+
+    for (int round = 0; round < 30; round++) {
+        int width = 10 + random() % 50;
+        int height = 10 + random() % 50;
+        double blockedFraction = 0.05 + 0.02 * (round % 15);
+        std::ostringstream name;
+
+        name << "map " << round << " (" << width << "x" << height << ", " << blockedFraction << " blocked)";
+        checkMap(name.str(), makeRandomMap(width, height, blockedFraction, random), 200, random);
+    }
+
+    //Open maps, where JPS jumps furthest
+    checkMap("open map", GridMap(64, 64), 100, random);
+
+    cout << "pathfinder: all checks passed" << endl;
+    return 0;
+}